@@ -0,0 +1,30 @@
+import { bench, consume } from "./harness";
+import { createPadBuffers, downsamplePeak } from "@/lib/pad-buffer";
+import { createStreamIngestState, ingestStreamLine } from "@/lib/stream-ingest";
+import { createSignalGenerator } from "@/lib/signal-generator";
+
+// One operation is one rendered frame of one PadGraph
+
+const BUFFER_SIZES = [1000, 5000, 10000];
+const DISPLAY_POINTS = [500, 2000];   // PadGraph default, LiveMonitorTab
+const ZOOM_LEVELS = [1, 10];
+
+for (const size of BUFFER_SIZES) {
+  const state = createStreamIngestState(createPadBuffers(size));
+  const generator = createSignalGenerator({ seed: size, sampleRate: 1000, hitRate: 8 });
+  // Wrap the ring once so head sits mid-buffer like in a live session
+  for (let n = 0; n < size * 1.5; n++) ingestStreamLine(state, generator.nextLine());
+  const { delta, head, count, capacity } = state.buffers.donLeft;
+
+  for (const points of DISPLAY_POINTS) {
+    const out = new Float32Array(points);
+    for (const zoom of ZOOM_LEVELS) {
+      const end = count;
+      const start = Math.max(0, Math.floor(end - count / zoom));
+      bench(`downsamplePeak buffer=${size} points=${points} zoom=${zoom}`, () => {
+        downsamplePeak(delta, head, count, capacity, start, end, out);
+        consume(out[0]);
+      }, { unit: "frame", params: { bufferSize: size, displayPoints: points, zoom } });
+    }
+  }
+}
@@ -0,0 +1,123 @@
+// Minimal benchmark harness
+// Bench files register cases with bench(); scripts/bench.mjs loads them and
+// calls runBenchmarks(). Each case runs in calibrated batches so timer
+// resolution doesn't dominate short operations.
+
+export interface BenchOptions {
+  params?: Record<string, number | string>;  // Recorded with the result (buffer size, rate, ...)
+  unit?: string;                             // What one operation is, e.g. "line" or "frame"
+  setup?: () => void;                        // Runs before warmup, outside the timing
+}
+
+export interface BenchResult {
+  name: string;
+  params: Record<string, number | string>;
+  unit: string;
+  batches: number;
+  opsPerBatch: number;
+  opsPerSec: number;
+  meanNs: number;
+  p50Ns: number;
+  p99Ns: number;
+  rme: number;  // Relative margin of error of the mean (%, 95% confidence)
+}
+
+interface BenchCase {
+  name: string;
+  fn: () => void;
+  options: BenchOptions;
+}
+
+export interface RunOptions {
+  filter?: string;
+  timeMs?: number;    // Measurement budget per case
+  warmupMs?: number;
+  onResult?: (result: BenchResult) => void;
+}
+
+const BATCH_TARGET_MS = 2;
+const MIN_BATCHES = 20;
+
+const cases: BenchCase[] = [];
+
+// Results are consumed by the host; keeps the JIT from dropping the work
+let sink: unknown;
+export function consume(value: unknown): void {
+  sink = value;
+}
+
+export function bench(name: string, fn: () => void, options: BenchOptions = {}): void {
+  cases.push({ name, fn, options });
+}
+
+function runBatch(fn: () => void, ops: number): number {
+  const start = performance.now();
+  for (let i = 0; i < ops; i++) fn();
+  return performance.now() - start;
+}
+
+// Grow the batch until it takes long enough to time reliably
+function calibrate(fn: () => void): number {
+  let ops = 1;
+  for (;;) {
+    const elapsed = runBatch(fn, ops);
+    if (elapsed >= BATCH_TARGET_MS || ops >= 1 << 24) {
+      return Math.max(1, Math.ceil((ops * BATCH_TARGET_MS) / Math.max(elapsed, 1e-3)));
+    }
+    ops *= elapsed < BATCH_TARGET_MS / 10 ? 10 : 2;
+  }
+}
+
+function percentile(sorted: number[], p: number): number {
+  const idx = Math.min(sorted.length - 1, Math.max(0, Math.ceil(p * sorted.length) - 1));
+  return sorted[idx];
+}
+
+function measure(c: BenchCase, timeMs: number, warmupMs: number): BenchResult {
+  c.options.setup?.();
+
+  const warmupEnd = performance.now() + warmupMs;
+  while (performance.now() < warmupEnd) runBatch(c.fn, 16);
+
+  const ops = calibrate(c.fn);
+  const samples: number[] = [];
+  const deadline = performance.now() + timeMs;
+  while (samples.length < MIN_BATCHES || performance.now() < deadline) {
+    samples.push((runBatch(c.fn, ops) * 1e6) / ops);
+    if (samples.length >= 10_000) break;
+  }
+
+  const mean = samples.reduce((a, b) => a + b, 0) / samples.length;
+  const variance = samples.reduce((a, b) => a + (b - mean) ** 2, 0) / (samples.length - 1);
+  const sem = Math.sqrt(variance / samples.length);
+  const sorted = samples.slice().sort((a, b) => a - b);
+  const round = (v: number, digits: number) => Number(v.toFixed(digits));
+
+  return {
+    name: c.name,
+    params: c.options.params ?? {},
+    unit: c.options.unit ?? "op",
+    batches: samples.length,
+    opsPerBatch: ops,
+    opsPerSec: Math.round(1e9 / mean),
+    meanNs: round(mean, 2),
+    p50Ns: round(percentile(sorted, 0.5), 2),
+    p99Ns: round(percentile(sorted, 0.99), 2),
+    rme: round(((1.96 * sem) / mean) * 100, 2),
+  };
+}
+
+export function runBenchmarks(options: RunOptions = {}): BenchResult[] {
+  const { filter, timeMs = 500, warmupMs = 100, onResult } = options;
+  const results: BenchResult[] = [];
+
+  for (const c of cases) {
+    if (filter && !c.name.includes(filter)) continue;
+    const result = measure(c, timeMs, warmupMs);
+    results.push(result);
+    onResult?.(result);
+  }
+
+  if (sink === Symbol.for("never")) console.log(sink);
+  return results;
+}
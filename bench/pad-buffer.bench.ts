@@ -0,0 +1,23 @@
+import { bench, consume } from "./harness";
+import { createPadBuffer, resizePadBuffer } from "@/lib/pad-buffer";
+import { HISTORY_BUFFER_MIN, HISTORY_BUFFER_MAX } from "@/lib/default-config";
+
+// Resizes happen on the history slider, once per pad
+
+const SIZES = [HISTORY_BUFFER_MIN, 1000, 5000, HISTORY_BUFFER_MAX];
+
+for (const from of SIZES) {
+  for (const to of SIZES) {
+    if (from === to) continue;
+    const source = createPadBuffer(from);
+    for (let n = 0; n < from; n++) {
+      source.raw[n] = n & 4095;
+      source.delta[n] = n & 255;
+    }
+    source.head = Math.floor(from / 3);
+
+    bench(`resizePadBuffer ${from}->${to}`, () => {
+      consume(resizePadBuffer(source, to));
+    }, { unit: "resize", params: { from, to } });
+  }
+}
@@ -0,0 +1,41 @@
+import { bench, consume } from "./harness";
+import {
+  parseRawStreamLine,
+  parseInputStreamLine,
+  encodeRawStreamLine,
+  parseSettingsResponse,
+} from "@/lib/serial-protocol";
+import { createSignalGenerator } from "@/lib/signal-generator";
+
+const POOL_SIZE = 4096;
+
+const generator = createSignalGenerator({ seed: 1, sampleRate: 1000, hitRate: 20 });
+const rawLines = Array.from({ length: POOL_SIZE }, () => generator.nextLine());
+const frames = rawLines.map((line) => parseRawStreamLine(line)!);
+const inputLines = Array.from({ length: 16 }, (_, mask) => mask.toString(16).toUpperCase());
+
+// What command 1000 returns on a current firmware
+const settingsResponse =
+  "Version:1.7.0\n" + Array.from({ length: 46 }, (_, key) => `${key}:${800 + key}`).join("\n") + "\n";
+
+let i = 0;
+
+bench("parseRawStreamLine", () => {
+  consume(parseRawStreamLine(rawLines[i++ & (POOL_SIZE - 1)]));
+}, { unit: "line" });
+
+bench("parseRawStreamLine invalid", () => {
+  consume(parseRawStreamLine("Settings saved"));
+}, { unit: "line" });
+
+bench("parseInputStreamLine", () => {
+  consume(parseInputStreamLine(inputLines[i++ & 15]));
+}, { unit: "line" });
+
+bench("encodeRawStreamLine", () => {
+  consume(encodeRawStreamLine(frames[i++ & (POOL_SIZE - 1)]));
+}, { unit: "line" });
+
+bench("parseSettingsResponse", () => {
+  consume(parseSettingsResponse(settingsResponse));
+}, { unit: "response", params: { settings: 46 } });
@@ -0,0 +1,34 @@
+import { bench, consume } from "./harness";
+import { createPadBuffers } from "@/lib/pad-buffer";
+import { createStreamIngestState, ingestStreamLine } from "@/lib/stream-ingest";
+import { createSignalGenerator } from "@/lib/signal-generator";
+
+// One operation is one second of stream at the given rate, so meanNs / 1e9 is
+// the share of a core the ingest path needs to keep up.
+
+const STREAM_RATES = [100, 1000, 10000];
+const BUFFER_SIZES = [1000, 5000, 10000];
+
+function streamSecond(rate: number, withInputs: boolean): string[] {
+  const generator = createSignalGenerator({ seed: rate, sampleRate: rate, hitRate: 8 });
+  const lines: string[] = [];
+  for (let n = 0; n < rate; n++) {
+    lines.push(generator.nextLine());
+    // 'both' mode: the input mask arrives interleaved with the raw stream
+    if (withInputs && n % 10 === 0) lines.push((n & 15).toString(16).toUpperCase());
+  }
+  return lines;
+}
+
+for (const rate of STREAM_RATES) {
+  for (const mode of ["raw", "both"] as const) {
+    const lines = streamSecond(rate, mode === "both");
+    for (const size of BUFFER_SIZES) {
+      const state = createStreamIngestState(createPadBuffers(size));
+      bench(`ingestStreamLine ${mode} rate=${rate} buffer=${size}`, () => {
+        for (let n = 0; n < lines.length; n++) ingestStreamLine(state, lines[n]);
+        consume(state.buffers.kaLeft.head);
+      }, { unit: "stream-second", params: { rate, bufferSize: size, mode, lines: lines.length } });
+    }
+  }
+}
@@ -0,0 +1,55 @@
+// Firmware precache, imported into the generated service worker
+// (vite.config.ts, workbox.importScripts). Stores the requested releases in
+// the Origin Private File System as firmware/<sha256>.uf2, the layout read
+// by src/lib/firmware-store.ts, and removes the others. Images are verified
+// against their SHA-256 before they are kept.
+
+const FIRMWARE_PRECACHE_MESSAGE = 'ITAIKO_FIRMWARE_PRECACHE';
+
+async function toHex(buffer) {
+  const digest = await crypto.subtle.digest('SHA-256', buffer);
+  return Array.from(new Uint8Array(digest), (b) => b.toString(16).padStart(2, '0')).join('');
+}
+
+async function precacheFirmware(releases) {
+  const root = await navigator.storage.getDirectory();
+  const directory = await root.getDirectoryHandle('firmware', { create: true });
+  const result = { stored: [], failed: [] };
+
+  for (const release of releases) {
+    const name = `${release.sha256}.uf2`;
+    try {
+      const existing = await directory.getFileHandle(name).then((h) => h.getFile(), () => null);
+      if (!existing || existing.size !== release.size) {
+        const response = await fetch(release.url, { cache: 'no-cache' });
+        if (!response.ok) throw new Error(`Download failed: ${response.status}`);
+        const data = await response.arrayBuffer();
+        if (data.byteLength !== release.size) throw new Error(`Expected ${release.size} bytes, got ${data.byteLength}`);
+        if ((await toHex(data)) !== release.sha256) throw new Error('Checksum mismatch');
+
+        const writable = await (await directory.getFileHandle(name, { create: true })).createWritable();
+        await writable.write(data);
+        await writable.close();
+      }
+      result.stored.push(release.sha256);
+    } catch (err) {
+      result.failed.push({ sha256: release.sha256, error: String(err && err.message ? err.message : err) });
+    }
+  }
+
+  const keep = new Set(releases.map((r) => `${r.sha256}.uf2`));
+  for await (const name of directory.keys()) {
+    if (!keep.has(name)) await directory.removeEntry(name).catch(() => {});
+  }
+  return result;
+}
+
+self.addEventListener('message', (event) => {
+  if (event.data?.type !== FIRMWARE_PRECACHE_MESSAGE) return;
+  const port = event.ports[0];
+  event.waitUntil(
+    precacheFirmware(event.data.releases)
+      .catch((err) => ({ stored: [], failed: [{ sha256: '*', error: String(err) }] }))
+      .then((result) => port.postMessage(result))
+  );
+});
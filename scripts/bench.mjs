@@ -0,0 +1,110 @@
+// Run the microbenchmarks in bench/*.bench.ts
+//
+//   pnpm bench                          run everything
+//   pnpm bench ingest                   only cases whose name contains "ingest"
+//   pnpm bench --compare <file.json>    print the change against an earlier run
+//   pnpm bench --time 1000              measurement budget per case (ms)
+//   pnpm bench --out <file.json>        result file (default bench/results/<commit>.json)
+//
+// Bench files are loaded through Vite so they share the app's TypeScript and
+// "@/" imports without a separate build step.
+
+import { createServer } from "vite";
+import { execSync } from "node:child_process";
+import { mkdirSync, readFileSync, readdirSync, writeFileSync } from "node:fs";
+import os from "node:os";
+import path from "node:path";
+import { fileURLToPath } from "node:url";
+
+const root = path.resolve(path.dirname(fileURLToPath(import.meta.url)), "..");
+
+function parseArgs(argv) {
+  const args = { filter: undefined, out: undefined, compare: undefined, timeMs: 500 };
+  for (let i = 0; i < argv.length; i++) {
+    const arg = argv[i];
+    if (arg === "--out") args.out = argv[++i];
+    else if (arg === "--compare") args.compare = argv[++i];
+    else if (arg === "--time") args.timeMs = Number(argv[++i]);
+    else if (!arg.startsWith("--")) args.filter = arg;
+  }
+  return args;
+}
+
+function gitRevision() {
+  try {
+    const sha = execSync("git rev-parse --short HEAD", { cwd: root }).toString().trim();
+    const dirty = execSync("git status --porcelain -- src bench", { cwd: root }).toString().trim() !== "";
+    return dirty ? `${sha}-dirty` : sha;
+  } catch {
+    return "unknown";
+  }
+}
+
+function formatNs(ns) {
+  if (ns >= 1e6) return `${(ns / 1e6).toFixed(2)} ms`;
+  if (ns >= 1e3) return `${(ns / 1e3).toFixed(2)} µs`;
+  return `${ns.toFixed(1)} ns`;
+}
+
+function printResult(result, baseline) {
+  let line = `${result.name.padEnd(56)} ${formatNs(result.meanNs).padStart(10)}/${result.unit}  ±${result.rme.toFixed(1)}%`;
+  const previous = baseline?.get(result.name);
+  if (previous) {
+    const change = ((result.meanNs - previous.meanNs) / previous.meanNs) * 100;
+    line += `  ${change >= 0 ? "+" : ""}${change.toFixed(1)}%`;
+  }
+  console.log(line);
+}
+
+const args = parseArgs(process.argv.slice(2));
+
+let baseline;
+if (args.compare) {
+  const previous = JSON.parse(readFileSync(args.compare, "utf8"));
+  baseline = new Map(previous.results.map((r) => [r.name, r]));
+}
+
+const server = await createServer({
+  root,
+  configFile: false,
+  logLevel: "error",
+  appType: "custom",
+  server: { middlewareMode: true, hmr: false },
+  optimizeDeps: { noDiscovery: true, include: [] },
+  resolve: { alias: { "@": path.resolve(root, "src") } },
+});
+
+try {
+  const benchDir = path.join(root, "bench");
+  const files = readdirSync(benchDir).filter((f) => f.endsWith(".bench.ts")).sort();
+  for (const file of files) {
+    await server.ssrLoadModule(`/bench/${file}`);
+  }
+
+  const { runBenchmarks } = await server.ssrLoadModule("/bench/harness.ts");
+  const revision = gitRevision();
+  console.log(`Benchmarking ${revision} on node ${process.version}\n`);
+
+  const results = runBenchmarks({
+    filter: args.filter,
+    timeMs: args.timeMs,
+    onResult: (result) => printResult(result, baseline),
+  });
+
+  const report = {
+    revision,
+    date: new Date().toISOString(),
+    node: process.version,
+    platform: `${os.platform()} ${os.arch()}`,
+    cpu: os.cpus()[0]?.model ?? "unknown",
+    filter: args.filter ?? null,
+    results,
+  };
+
+  const out = args.out ?? path.join(benchDir, "results", `${revision}.json`);
+  mkdirSync(path.dirname(out), { recursive: true });
+  writeFileSync(out, JSON.stringify(report, null, 2) + "\n");
+  console.log(`\nWrote ${results.length} results to ${path.relative(root, out)}`);
+} finally {
+  await server.close();
+}
@@ -0,0 +1,154 @@
+// Bundle size report, printed after every `vite build`
+//
+//   pnpm build                                     print the report
+//   BUILD_REPORT_COMPARE=<file.json> pnpm build    print the change against an earlier build
+//
+// The report is written to bench/results/build-<commit>.json next to the
+// microbenchmark results. "Initial JS" is what the browser must fetch before
+// the first render: the entry chunk and everything it imports statically.
+// Lazy chunks are listed with the module that starts them.
+//
+// Time to interactive can't be measured by the bundler, so the report gives a
+// model of it for a mid-range phone on a slow connection (TTI_PROFILE). It is
+// only meant for comparing builds; measure real pages with the browser's
+// performance panel.
+
+import type { Plugin, Rollup } from "vite";
+import { execSync } from "node:child_process";
+import { existsSync, mkdirSync, readFileSync, writeFileSync } from "node:fs";
+import path from "node:path";
+import { gzipSync } from "node:zlib";
+
+interface ChunkSize {
+  file: string;
+  source?: string;   // Module the chunk was split at, relative to the root
+  bytes: number;
+  gzipBytes: number;
+}
+
+interface BuildReport {
+  revision: string;
+  date: string;
+  initial: { bytes: number; gzipBytes: number; chunks: ChunkSize[] };
+  lazy: ChunkSize[];
+  estimatedTtiMs: number;
+}
+
+const TTI_PROFILE = {
+  rttMs: 150,               // HTML, then the entry with its modulepreloads
+  downlinkBytesPerMs: 200,  // 1.6 Mbit/s
+  jsMsPerKB: 1,             // Parse, compile and run on a mid-range phone
+};
+
+function estimateTti(bytes: number, gzipBytes: number): number {
+  const { rttMs, downlinkBytesPerMs, jsMsPerKB } = TTI_PROFILE;
+  return Math.round(2 * rttMs + gzipBytes / downlinkBytesPerMs + (bytes / 1024) * jsMsPerKB);
+}
+
+function gitRevision(root: string): string {
+  try {
+    const sha = execSync("git rev-parse --short HEAD", { cwd: root }).toString().trim();
+    const dirty = execSync("git status --porcelain -- src", { cwd: root }).toString().trim() !== "";
+    return dirty ? `${sha}-dirty` : sha;
+  } catch {
+    return "unknown";
+  }
+}
+
+function formatKB(bytes: number): string {
+  return `${(bytes / 1024).toFixed(1)} kB`;
+}
+
+function formatChange(current: number, previous: number | undefined): string {
+  if (previous === undefined || previous === 0) return "";
+  const change = ((current - previous) / previous) * 100;
+  return `  ${change >= 0 ? "+" : ""}${change.toFixed(1)}%`;
+}
+
+function sizeOf(chunk: Rollup.OutputChunk, root: string): ChunkSize {
+  return {
+    file: chunk.fileName,
+    source: chunk.facadeModuleId ? path.relative(root, chunk.facadeModuleId) : undefined,
+    bytes: Buffer.byteLength(chunk.code),
+    gzipBytes: gzipSync(chunk.code).length,
+  };
+}
+
+function collectReport(bundle: Rollup.OutputBundle, root: string): BuildReport {
+  const chunks = Object.values(bundle).filter((output): output is Rollup.OutputChunk => output.type === "chunk");
+  const byFile = new Map(chunks.map((chunk) => [chunk.fileName, chunk]));
+
+  const initial = new Set<string>();
+  const visit = (file: string) => {
+    if (initial.has(file)) return;
+    initial.add(file);
+    for (const imported of byFile.get(file)?.imports ?? []) visit(imported);
+  };
+  for (const chunk of chunks) if (chunk.isEntry) visit(chunk.fileName);
+
+  const initialChunks = chunks.filter((chunk) => initial.has(chunk.fileName)).map((chunk) => sizeOf(chunk, root));
+  const lazy = chunks.filter((chunk) => !initial.has(chunk.fileName)).map((chunk) => sizeOf(chunk, root));
+  const bytes = initialChunks.reduce((sum, chunk) => sum + chunk.bytes, 0);
+  const gzipBytes = initialChunks.reduce((sum, chunk) => sum + chunk.gzipBytes, 0);
+
+  return {
+    revision: gitRevision(root),
+    date: new Date().toISOString(),
+    initial: { bytes, gzipBytes, chunks: initialChunks },
+    lazy: lazy.sort((a, b) => b.bytes - a.bytes),
+    estimatedTtiMs: estimateTti(bytes, gzipBytes),
+  };
+}
+
+function printReport(report: BuildReport, baseline?: BuildReport) {
+  const previousLazy = new Map(baseline?.lazy.map((chunk) => [chunk.source ?? chunk.file, chunk]));
+
+  console.log(`\nBuild report (${report.revision}${baseline ? ` vs ${baseline.revision}` : ""})`);
+  console.log(
+    `  Initial JS      ${formatKB(report.initial.bytes).padStart(10)}` +
+      formatChange(report.initial.bytes, baseline?.initial.bytes)
+  );
+  console.log(
+    `  Initial JS gzip ${formatKB(report.initial.gzipBytes).padStart(10)}` +
+      formatChange(report.initial.gzipBytes, baseline?.initial.gzipBytes)
+  );
+  console.log(
+    `  Est. TTI        ${`${report.estimatedTtiMs} ms`.padStart(10)}` +
+      formatChange(report.estimatedTtiMs, baseline?.estimatedTtiMs)
+  );
+  if (report.lazy.length === 0) return;
+  console.log("  Lazy chunks");
+  for (const chunk of report.lazy) {
+    const name = chunk.source ?? chunk.file;
+    console.log(
+      `    ${name.padEnd(60)} ${formatKB(chunk.bytes).padStart(10)}` +
+        formatChange(chunk.bytes, previousLazy.get(name)?.bytes)
+    );
+  }
+}
+
+export function buildReport(): Plugin {
+  let root = process.cwd();
+
+  return {
+    name: "itaiko-build-report",
+    apply: "build",
+    configResolved(config) {
+      root = config.root;
+    },
+    generateBundle(_options, bundle) {
+      const report = collectReport(bundle, root);
+
+      const compare = process.env.BUILD_REPORT_COMPARE;
+      const baseline = compare && existsSync(compare)
+        ? (JSON.parse(readFileSync(compare, "utf8")) as BuildReport)
+        : undefined;
+      printReport(report, baseline);
+
+      const out = path.join(root, "bench", "results", `build-${report.revision}.json`);
+      mkdirSync(path.dirname(out), { recursive: true });
+      writeFileSync(out, JSON.stringify(report, null, 2));
+      console.log(`\nWrote ${path.relative(root, out)}`);
+    },
+  };
+}
@@ -1,9 +1,14 @@
+import { Suspense } from "react";
 import { ThemeProvider } from "@/components/theme-provider";
 // import { ModeToggle } from "@/components/mode-toggle";
-import { ConfigurePage } from "@/pages/ConfigurePage";
-import { LandingPage } from "@/pages/LandingPage";
 import { Routes, Route } from "react-router-dom";
 import { Toaster } from "@/components/ui/sonner";
+import { lazyNamed } from "@/lib/lazy-chunks";
+
+// Each page is its own chunk: the landing page doesn't pull in the configurator
+const LandingPage = lazyNamed(() => import("@/pages/LandingPage"), "LandingPage");
+const ConfigurePage = lazyNamed(() => import("@/pages/ConfigurePage"), "ConfigurePage");
+const MonitorWindowPage = lazyNamed(() => import("@/pages/MonitorWindowPage"), "MonitorWindowPage");
 
 function App() {
   return (
@@ -11,10 +16,13 @@ function App() {
       {/* <div className="absolute top-4 right-4 z-50">
         <ModeToggle />
       </div> */}
-      <Routes>
-        <Route path="/" element={<LandingPage />} />
-        <Route path="/configure" element={<ConfigurePage />} />
-      </Routes>
+      <Suspense fallback={null}>
+        <Routes>
+          <Route path="/" element={<LandingPage />} />
+          <Route path="/configure" element={<ConfigurePage />} />
+          <Route path="/monitor" element={<MonitorWindowPage />} />
+        </Routes>
+      </Suspense>
       <Toaster position="top-center" />
     </ThemeProvider>
   );
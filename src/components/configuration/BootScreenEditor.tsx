@@ -1,161 +1,117 @@
-import { useState, useRef, useEffect } from "react";
+import { useState, useRef, useEffect, useCallback } from "react";
 import { useDevice } from "@/context/DeviceContext";
 import { Card, CardContent, CardDescription, CardHeader, CardTitle } from "@/components/ui/card";
 import { Button } from "@/components/ui/button";
 import { Input } from "@/components/ui/input";
 import { Label } from "@/components/ui/label";
 import { HelpButton } from "@/components/ui/help-modal";
-import { AlertCircle, Check, Trash2, Upload } from "lucide-react";
+import { Slider } from "@/components/ui/slider";
+import { Switch } from "@/components/ui/switch";
+import {
+  Select,
+  SelectContent,
+  SelectItem,
+  SelectTrigger,
+  SelectValue,
+} from "@/components/ui/select";
+import { AlertCircle, Check, Info, Trash2, Upload, X } from "lucide-react";
+import { useBootScreenConverter } from "@/hooks/useBootScreenConverter";
+import {
+  BOOT_SCREEN_WIDTH,
+  BOOT_SCREEN_HEIGHT,
+  DEFAULT_DITHER_OPTIONS,
+  DITHER_METHODS,
+  type DitherMethod,
+  type DitherOptions,
+  decodeMonochromeBmp,
+  renderBits,
+} from "@/lib/dither";
+import {
+  listGallery,
+  saveToGallery,
+  deleteFromGallery,
+  type GalleryBootScreen,
+} from "@/lib/boot-screen-gallery";
+
+function GalleryThumbnail({ item }: { item: GalleryBootScreen }) {
+  const canvasRef = useRef<HTMLCanvasElement>(null);
+
+  useEffect(() => {
+    const ctx = canvasRef.current?.getContext("2d");
+    const decoded = decodeMonochromeBmp(item.bmp);
+    if (!ctx || !decoded) return;
+    ctx.putImageData(new ImageData(renderBits(decoded.bits), decoded.width, decoded.height), 0, 0);
+  }, [item]);
+
+  return (
+    <canvas
+      ref={canvasRef}
+      width={BOOT_SCREEN_WIDTH}
+      height={BOOT_SCREEN_HEIGHT}
+      className="block w-full bg-black"
+      style={{ imageRendering: "pixelated" }}
+    />
+  );
+}
 
 export function BootScreenEditor() {
   const { isConnected, uploadBootScreen, clearBootScreen } = useDevice();
   const [selectedFile, setSelectedFile] = useState<File | null>(null);
-  const [previewUrl, setPreviewUrl] = useState<string | null>(null);
+  const [ditherOptions, setDitherOptions] = useState<DitherOptions>(DEFAULT_DITHER_OPTIONS);
   const [isProcessing, setIsProcessing] = useState(false);
-  const [status, setStatus] = useState<"idle" | "success" | "error">("idle");
+  const [status, setStatus] = useState<"idle" | "success" | "skipped" | "error">("idle");
   const [statusMessage, setStatusMessage] = useState("");
+  const [gallery, setGallery] = useState<GalleryBootScreen[]>([]);
+  const [lastUpload, setLastUpload] = useState<{ bmp: Uint8Array; name: string } | null>(null);
   
   const canvasRef = useRef<HTMLCanvasElement>(null);
 
-  // Constants for BMP format
-  const WIDTH = 128;
-  const HEIGHT = 64;
+  const { preview, bmp, error: conversionError, isConverting } = useBootScreenConverter(selectedFile, ditherOptions);
+
+  const updateOption = <K extends keyof DitherOptions>(key: K, value: DitherOptions[K]) => {
+    setDitherOptions((prev) => ({ ...prev, [key]: value }));
+  };
 
   const handleFileChange = (e: React.ChangeEvent<HTMLInputElement>) => {
     if (e.target.files && e.target.files[0]) {
-      const file = e.target.files[0];
-      setSelectedFile(file);
-      setPreviewUrl(URL.createObjectURL(file));
+      setSelectedFile(e.target.files[0]);
       setStatus("idle");
       setStatusMessage("");
     }
   };
 
-  const processImage = async (): Promise<Uint8Array | null> => {
-    if (!selectedFile || !canvasRef.current) return null;
-
-    return new Promise((resolve) => {
-      const img = new Image();
-      img.onload = () => {
-        const canvas = canvasRef.current!;
-        const ctx = canvas.getContext("2d")!;
-        
-        // 1. Draw resized image to canvas
-        // We use white background for transparency
-        ctx.fillStyle = "white";
-        ctx.fillRect(0, 0, WIDTH, HEIGHT);
-        
-        // Calculate scaling to fit
-        const scale = Math.min(WIDTH / img.width, HEIGHT / img.height);
-        const w = img.width * scale;
-        const h = img.height * scale;
-        const x = (WIDTH - w) / 2;
-        const y = (HEIGHT - h) / 2;
-        
-        ctx.drawImage(img, x, y, w, h);
-
-        // 2. Get pixel data and convert to 1-bit monochrome
-        const imageData = ctx.getImageData(0, 0, WIDTH, HEIGHT);
-        const data = imageData.data;
-        
-        // Buffer for BMP data (header + pixel array)
-        // Row size must be multiple of 4 bytes. 128 pixels / 8 bits = 16 bytes. 16 is multiple of 4.
-        const rowSize = 16; 
-        const pixelArraySize = rowSize * HEIGHT;
-        const fileHeaderSize = 14;
-        const infoHeaderSize = 40;
-        const colorTableSize = 8; // 2 colors * 4 bytes
-        const fileSize = fileHeaderSize + infoHeaderSize + colorTableSize + pixelArraySize;
-        
-        const buffer = new ArrayBuffer(fileSize);
-        const view = new DataView(buffer);
-        
-        // --- Bitmap File Header ---
-        view.setUint16(0, 0x4D42, true); // "BM"
-        view.setUint32(2, fileSize, true); // File size
-        view.setUint16(6, 0, true); // Reserved
-        view.setUint16(8, 0, true); // Reserved
-        view.setUint32(10, fileHeaderSize + infoHeaderSize + colorTableSize, true); // Offset to pixel data
-        
-        // --- Bitmap Info Header (BITMAPINFOHEADER) ---
-        view.setUint32(14, infoHeaderSize, true); // Header size
-        view.setInt32(18, WIDTH, true); // Width
-        view.setInt32(22, HEIGHT, true); // Height (positive = bottom-up, we'll handle flipping)
-        view.setUint16(26, 1, true); // Planes
-        view.setUint16(28, 1, true); // Bits per pixel (1-bit)
-        view.setUint32(30, 0, true); // Compression (BI_RGB)
-        view.setUint32(34, pixelArraySize, true); // Image size
-        view.setInt32(38, 0, true); // X pixels/meter
-        view.setInt32(42, 0, true); // Y pixels/meter
-        view.setUint32(46, 2, true); // Colors used
-        view.setUint32(50, 2, true); // Important colors
-        
-        // --- Color Table (Black & White) ---
-        // Color 0: Black (0x000000)
-        view.setUint32(54, 0x00000000, true);
-        // Color 1: White (0xFFFFFF)
-        view.setUint32(58, 0x00FFFFFF, true);
-        
-        // --- Pixel Data ---
-        // We want light pixels (avg > 128) to be White (Color 1, Bit 1).
-        // We want dark pixels (avg <= 128) to be Black (Color 0, Bit 0).
-        const pixelDataStart = 62;
-        
-        for (let row = 0; row < HEIGHT; row++) {
-          // Flip row index for bottom-up storage
-          const srcRow = HEIGHT - 1 - row;
-          
-          for (let col = 0; col < WIDTH; col++) {
-            const i = (srcRow * WIDTH + col) * 4;
-            // Simple luminance threshold
-            const avg = (data[i] + data[i+1] + data[i+2]) / 3;
-            
-            // 1 for white (lit), 0 for black (unlit)
-            const bit = avg > 128 ? 1 : 0;
-            
-            // Set or clear bit in buffer
-            if (bit) { // If bit is 1 (light pixel, maps to Color 1 / White)
-              const byteIdx = pixelDataStart + row * rowSize + Math.floor(col / 8);
-              const bitIdx = 7 - (col % 8);
-              const currentByte = view.getUint8(byteIdx);
-              view.setUint8(byteIdx, currentByte | (1 << bitIdx));
-            } else { // If bit is 0 (dark pixel, maps to Color 0 / Black)
-              const byteIdx = pixelDataStart + row * rowSize + Math.floor(col / 8);
-              const bitIdx = 7 - (col % 8);
-              const currentByte = view.getUint8(byteIdx);
-              view.setUint8(byteIdx, currentByte & ~(1 << bitIdx)); // Ensure bit is cleared
-            }
-          }
-        }
-        
-        resolve(new Uint8Array(buffer));
-      };
-      img.src = previewUrl!;
-    });
-  };
+  const refreshGallery = useCallback(() => {
+    listGallery().then(setGallery).catch((e) => console.warn("Boot screen gallery unavailable:", e));
+  }, []);
+
+  useEffect(refreshGallery, [refreshGallery]);
 
-  const handleUpload = async () => {
+  const uploadBitmap = async (bmpData: Uint8Array, name: string, force = false) => {
     if (!isConnected) return;
-    
+
     setIsProcessing(true);
     setStatus("idle");
-    
+    setLastUpload({ bmp: bmpData, name });
+
     try {
-      const bmpData = await processImage();
-      if (!bmpData) {
-        throw new Error("Failed to process image");
+      console.log(`Uploading BMP: ${bmpData.length} bytes`);
+      const outcome = await uploadBootScreen(bmpData, { force });
+
+      if (outcome === "failed") {
+        setStatus("error");
+        setStatusMessage("Failed to upload boot screen. Check device connection.");
+        return;
       }
 
-      console.log(`Uploading BMP: ${bmpData.length} bytes`);
-      const success = await uploadBootScreen(bmpData);
-      
-      if (success) {
+      if (outcome === "skipped") {
+        setStatus("skipped");
+        setStatusMessage("This device already shows this boot screen, so nothing was written.");
+      } else {
         setStatus("success");
         setStatusMessage("Boot screen updated successfully!");
-      } else {
-        setStatus("error");
-        setStatusMessage("Failed to upload boot screen. Check device connection.");
       }
+      await saveToGallery(bmpData, name).catch((e) => console.warn("Could not save to gallery:", e));
+      refreshGallery();
     } catch (e) {
       console.error(e);
       setStatus("error");
@@ -165,6 +121,16 @@ export function BootScreenEditor() {
     }
   };
 
+  const handleUpload = () => {
+    if (!bmp) return;
+    return uploadBitmap(bmp, selectedFile?.name ?? "Boot screen");
+  };
+
+  const handleDeleteFromGallery = async (hash: string) => {
+    await deleteFromGallery(hash).catch(console.warn);
+    refreshGallery();
+  };
+
   const handleClear = async () => {
     if (!isConnected) return;
     
@@ -177,7 +143,6 @@ export function BootScreenEditor() {
         setStatus("success");
         setStatusMessage("Default boot screen restored.");
         setSelectedFile(null);
-        setPreviewUrl(null);
       } else {
         setStatus("error");
         setStatusMessage("Failed to clear boot screen.");
@@ -185,37 +150,16 @@ export function BootScreenEditor() {
     }
   };
 
-  // Effect to update canvas preview with monochrome version
+  // Draw the converted preview
   useEffect(() => {
-    if (previewUrl && canvasRef.current) {
-        const img = new Image();
-        img.onload = () => {
-            const canvas = canvasRef.current!;
-            const ctx = canvas.getContext("2d")!;
-            ctx.fillStyle = "white";
-            ctx.fillRect(0, 0, WIDTH, HEIGHT);
-             const scale = Math.min(WIDTH / img.width, HEIGHT / img.height);
-            const w = img.width * scale;
-            const h = img.height * scale;
-            const x = (WIDTH - w) / 2;
-            const y = (HEIGHT - h) / 2;
-            ctx.drawImage(img, x, y, w, h);
-            
-            // Dither / Threshold preview
-            const imageData = ctx.getImageData(0, 0, WIDTH, HEIGHT);
-            const data = imageData.data;
-            for (let i = 0; i < data.length; i += 4) {
-                const avg = (data[i] + data[i+1] + data[i+2]) / 3;
-                const val = avg > 128 ? 255 : 0;
-                data[i] = val;
-                data[i+1] = val;
-                data[i+2] = val;
-            }
-            ctx.putImageData(imageData, 0, 0);
-        };
-        img.src = previewUrl;
+    const ctx = canvasRef.current?.getContext("2d");
+    if (!ctx) return;
+    if (preview) {
+      ctx.putImageData(new ImageData(new Uint8ClampedArray(preview), BOOT_SCREEN_WIDTH, BOOT_SCREEN_HEIGHT), 0, 0);
+    } else if (!selectedFile) {
+      ctx.clearRect(0, 0, BOOT_SCREEN_WIDTH, BOOT_SCREEN_HEIGHT);
     }
-  }, [previewUrl]);
+  }, [preview, selectedFile]);
 
   return (
     <Card>
@@ -225,7 +169,7 @@ export function BootScreenEditor() {
           <HelpButton helpKey="boot-screen" />
         </CardTitle>
         <CardDescription>
-          Customize the startup logo (128x64 pixels). Images will be converted to 1-bit monochrome.
+          Customize the startup logo (128x64 pixels). Images are converted to 1-bit monochrome; pick a dithering style for photos.
         </CardDescription>
       </CardHeader>
       <CardContent className="space-y-4">
@@ -242,10 +186,91 @@ export function BootScreenEditor() {
               />
             </div>
 
+            <div className="grid w-full max-w-sm gap-3">
+              <div className="flex items-center justify-between gap-2">
+                <Label className="text-sm">Dithering</Label>
+                <Select
+                  value={ditherOptions.method}
+                  onValueChange={(value) => updateOption("method", value as DitherMethod)}
+                >
+                  <SelectTrigger className="w-44">
+                    <SelectValue />
+                  </SelectTrigger>
+                  <SelectContent>
+                    {DITHER_METHODS.map((m) => (
+                      <SelectItem key={m.value} value={m.value}>
+                        {m.label}
+                      </SelectItem>
+                    ))}
+                  </SelectContent>
+                </Select>
+              </div>
+
+              <div className="space-y-2">
+                <div className="flex items-center justify-between">
+                  <Label className="text-sm">Brightness</Label>
+                  <span className="text-xs text-muted-foreground tabular-nums">{ditherOptions.brightness}</span>
+                </div>
+                <Slider
+                  value={[ditherOptions.brightness]}
+                  onValueChange={(v) => updateOption("brightness", v[0])}
+                  min={-100}
+                  max={100}
+                  step={1}
+                />
+              </div>
+
+              <div className="space-y-2">
+                <div className="flex items-center justify-between">
+                  <Label className="text-sm">Contrast</Label>
+                  <span className="text-xs text-muted-foreground tabular-nums">{ditherOptions.contrast}</span>
+                </div>
+                <Slider
+                  value={[ditherOptions.contrast]}
+                  onValueChange={(v) => updateOption("contrast", v[0])}
+                  min={-100}
+                  max={100}
+                  step={1}
+                />
+              </div>
+
+              <div className="space-y-2">
+                <div className="flex items-center justify-between">
+                  <Label className="text-sm">Threshold</Label>
+                  <span className="text-xs text-muted-foreground tabular-nums">{ditherOptions.threshold}</span>
+                </div>
+                <Slider
+                  value={[ditherOptions.threshold]}
+                  onValueChange={(v) => updateOption("threshold", v[0])}
+                  min={1}
+                  max={254}
+                  step={1}
+                />
+              </div>
+
+              <div className="flex items-center justify-between">
+                <Label htmlFor="boot-invert" className="text-sm">Invert</Label>
+                <Switch
+                  id="boot-invert"
+                  checked={ditherOptions.invert}
+                  onCheckedChange={(checked) => updateOption("invert", checked)}
+                />
+              </div>
+
+              <Button
+                variant="ghost"
+                size="sm"
+                className="justify-self-start"
+                onClick={() => setDitherOptions(DEFAULT_DITHER_OPTIONS)}
+              >
+                Reset adjustments
+              </Button>
+            </div>
+
             <div className="flex gap-2">
               <Button 
                 onClick={handleUpload} 
-                disabled={!selectedFile || !isConnected || isProcessing}
+                disabled={!bmp || isConverting || !isConnected || isProcessing}
                 className="flex-1"
               >
                 {isProcessing ? "Uploading..." : "Upload to Device"}
@@ -278,6 +303,37 @@ export function BootScreenEditor() {
               </div>
             )}
 
+            {conversionError && (
+              <div className="bg-destructive/15 text-destructive border-destructive/20 border rounded-lg p-3 flex items-start gap-3">
+                <AlertCircle className="h-4 w-4 mt-0.5" />
+                <div>
+                  <h5 className="font-medium text-sm">Could not read image</h5>
+                  <p className="text-sm opacity-90">{conversionError}</p>
+                </div>
+              </div>
+            )}
+
+            {status === "skipped" && (
+              <div className="bg-muted text-foreground border rounded-lg p-3 flex items-start gap-3">
+                <Info className="h-4 w-4 mt-0.5" />
+                <div className="flex-1">
+                  <h5 className="font-medium text-sm">Already up to date</h5>
+                  <p className="text-sm opacity-90">{statusMessage}</p>
+                  {lastUpload && (
+                    <Button
+                      variant="link"
+                      size="sm"
+                      className="h-auto p-0"
+                      onClick={() => uploadBitmap(lastUpload.bmp, lastUpload.name, true)}
+                      disabled={isProcessing}
+                    >
+                      Upload anyway
+                    </Button>
+                  )}
+                </div>
+              </div>
+            )}
+
             {status === "error" && (
               <div className="bg-destructive/15 text-destructive border-destructive/20 border rounded-lg p-3 flex items-start gap-3">
                 <AlertCircle className="h-4 w-4 mt-0.5" />
@@ -294,8 +350,8 @@ export function BootScreenEditor() {
              <div className="border border-foreground/20 shadow-sm bg-black">
                 <canvas 
                     ref={canvasRef} 
-                    width={WIDTH} 
-                    height={HEIGHT} 
+                    width={BOOT_SCREEN_WIDTH} 
+                    height={BOOT_SCREEN_HEIGHT} 
                     className="block"
                     style={{ 
                         width: "128px", 
@@ -310,6 +366,36 @@ export function BootScreenEditor() {
              </p>
           </div>
         </div>
+
+        {gallery.length > 0 && (
+          <div className="space-y-2">
+            <Label className="text-sm">Recent boot screens</Label>
+            <div className="grid grid-cols-3 sm:grid-cols-4 md:grid-cols-6 gap-2">
+              {gallery.map((item) => (
+                <div key={item.hash} className="group relative">
+                  <button
+                    type="button"
+                    className="block w-full rounded border border-foreground/20 overflow-hidden hover:ring-2 hover:ring-primary disabled:opacity-50"
+                    onClick={() => uploadBitmap(item.bmp, item.name)}
+                    disabled={!isConnected || isProcessing}
+                    title={`Upload ${item.name}`}
+                  >
+                    <GalleryThumbnail item={item} />
+                  </button>
+                  <button
+                    type="button"
+                    className="absolute top-1 right-1 rounded bg-background/80 p-0.5 opacity-0 group-hover:opacity-100"
+                    onClick={() => handleDeleteFromGallery(item.hash)}
+                    title="Remove from gallery"
+                  >
+                    <X className="h-3 w-3" />
+                  </button>
+                  <p className="mt-1 truncate text-xs text-muted-foreground">{item.name}</p>
+                </div>
+              ))}
+            </div>
+          </div>
+        )}
       </CardContent>
     </Card>
   );
@@ -0,0 +1,41 @@
+import { useDevice } from "@/context/DeviceContext";
+import { Button } from "@/components/ui/button";
+import { Card, CardContent } from "@/components/ui/card";
+import { AlertCircle } from "lucide-react";
+
+// Shown when settings were edited while the cached ones were on screen and
+// the live read then found the drum set differently
+export function ConfigConflictBanner() {
+  const { configConflict, resolveConfigConflict } = useDevice();
+  if (!configConflict) return null;
+
+  const count = configConflict.fields.length;
+
+  return (
+    <div className="animate-in slide-in-from-top-5 fade-in duration-300">
+      <Card className="border-amber-500/50 bg-amber-500/10 shadow-md">
+        <CardContent className="flex flex-wrap items-center justify-between gap-3">
+          <div className="flex items-center gap-2 text-amber-600 font-medium">
+            <AlertCircle className="h-3.5 w-3.5" />
+            <span>
+              The drum has {count} setting{count === 1 ? "" : "s"} different from the saved copy you edited
+            </span>
+          </div>
+          <div className="flex gap-2">
+            <Button size="sm" variant="outline" onClick={() => resolveConfigConflict("device")}>
+              Use drum's settings
+            </Button>
+            <Button
+              size="sm"
+              variant="ghost"
+              className="bg-amber-600 hover:bg-amber-700 text-white hover:text-white border-none rounded-sm"
+              onClick={() => resolveConfigConflict("edits")}
+            >
+              Keep my edits
+            </Button>
+          </div>
+        </CardContent>
+      </Card>
+    </div>
+  );
+}
@@ -1,4 +1,4 @@
-import { useEffect, useRef, useState } from "react";
+import { Suspense, useEffect, useRef, useState } from "react";
 import { useDevice } from "@/context/DeviceContext";
 import { Card, CardContent, CardHeader, CardTitle } from "@/components/ui/card";
 import { Switch } from "@/components/ui/switch";
@@ -7,8 +7,7 @@ import { Button } from "@/components/ui/button";
 import { PadConfigGroup } from "./PadConfigGroup";
 import { TimingSettings } from "./TimingSettings";
 import { ADCChannelSettings } from "./ADCChannelSettings";
-import { InteractiveKeyMapping } from "./InteractiveKeyMapping";
-import { BootScreenEditor } from "./BootScreenEditor";
+import { ConfigConflictBanner } from "./ConfigConflictBanner";
 import { PAD_NAMES, PAD_COLORS } from "@/types";
 import { HelpButton } from "@/components/ui/help-modal";
 import { HitHistoryGrid } from "@/components/visual/HitHistoryGrid";
@@ -22,6 +21,10 @@ import {
   DialogTitle,
 } from "@/components/ui/dialog";
 import { useSearchParams } from "react-router-dom";
+import { chunkLoaders, lazyNamed } from "@/lib/lazy-chunks";
+
+const InteractiveKeyMapping = lazyNamed(chunkLoaders.keyMapping, "InteractiveKeyMapping");
+const BootScreenEditor = lazyNamed(chunkLoaders.bootScreenEditor, "BootScreenEditor");
 
 export function ConfigurationTab() {
   const {
@@ -32,6 +35,8 @@ export function ConfigurationTab() {
     triggers,
     saveToFlash,
     configDirty,
+    configSource,
+    configConflict,
     resetPadThresholds,
     resetToDefaults,
     exportConfig,
@@ -77,6 +82,9 @@ export function ConfigurationTab() {
     setSearchParams(searchParams);
   };
 
+  // Cached settings show before the live read has finished
+  const showConfig = isReady || configSource === "cache";
+
   const isFirstRender = useRef(true);
 
   // Debounced auto-save: save to flash 500ms after config changes
@@ -92,15 +100,17 @@ export function ConfigurationTab() {
       return;
     }
 
-    // Only auto-save if connected and there are unsaved changes
+    // Only auto-save if connected and there are unsaved changes made on
+    // settings the device confirmed
     if (!isConnected || !configDirty) return;
+    if (configSource !== "device" || configConflict) return;
 
     const timeoutId = setTimeout(() => {
       saveToFlashRef.current();
     }, 500);
 
     return () => clearTimeout(timeoutId);
-  }, [config, isConnected, configDirty]);
+  }, [config, isConnected, configDirty, configSource, configConflict]);
 
   return (
     <div className="space-y-6">
@@ -108,7 +118,7 @@ export function ConfigurationTab() {
       <div className="flex flex-col items-center py-4 relative">
         {/* Drum Container - Blurred when not ready */}
         <div
-          className={`relative w-144 h-144 transition-all duration-500 ${!isReady ? "blur-sm opacity-50 grayscale" : ""}`}
+          className={`relative w-144 h-144 transition-all duration-500 ${!showConfig ? "blur-sm opacity-50 grayscale" : ""}`}
         >
           {/* Background Image */}
           <img
@@ -158,7 +168,7 @@ export function ConfigurationTab() {
         </div>
 
         {/* Connect Overlay - Centered over the drum */}
-        {!isReady && (
+        {!showConfig && (
           <div className="absolute inset-0 flex items-center justify-center z-10 pointer-events-none">
             <div className="bg-background/80 backdrop-blur-md px-6 py-3 rounded-2xl border shadow-sm text-center">
               <p className="text-lg font-semibold">Connect your drum</p>
@@ -173,7 +183,9 @@ export function ConfigurationTab() {
 
 
       {/* Configuration Settings - Deactivated when not ready */}
-      <div className={`space-y-6 transition-all duration-500 ${!isReady ? "pointer-events-none opacity-50" : ""}`}>
+      <div className={`space-y-6 transition-all duration-500 ${!showConfig ? "pointer-events-none opacity-50" : ""}`}>
+        <ConfigConflictBanner />
+
         {/* Global Settings - Advanced only */}
         {advancedMode && (
           <Card>
@@ -235,11 +247,13 @@ export function ConfigurationTab() {
             {/* ADC Channel Mapping */}
             <ADCChannelSettings />
 
-            {/* Key Mappings */}
-            <InteractiveKeyMapping />
+            <Suspense fallback={null}>
+              {/* Key Mappings */}
+              <InteractiveKeyMapping />
 
-            {/* Custom Boot Screen */}
-            <BootScreenEditor />
+              {/* Custom Boot Screen */}
+              <BootScreenEditor />
+            </Suspense>
           </>
         )}
 
@@ -18,6 +18,7 @@ interface PadThresholdSettingProps {
   value: number;
   onChange: (value: number, commit?: boolean) => void;
   disabled: boolean;
+  flash?: boolean;
 }
 
 function PadThresholdSetting({
@@ -26,6 +27,7 @@ function PadThresholdSetting({
   value,
   onChange,
   disabled,
+  flash,
 }: PadThresholdSettingProps) {
   const handleValueChange = (val: number | undefined) => {
     if (val !== undefined) {
@@ -42,7 +44,7 @@ function PadThresholdSetting({
   };
 
   return (
-    <div className="space-y-2">
+    <div className={`space-y-2 ${flash ? "config-flash" : ""}`}>
       <div className="flex items-center justify-between">
         <Label htmlFor={id} className="text-sm">
           {label}
@@ -71,7 +73,7 @@ function PadThresholdSetting({
 }
 
 export function PadConfigGroup({ pad, simpleMode = false }: PadConfigGroupProps) {
-  const { config, updatePadThreshold, isConnected } = useDevice();
+  const { config, updatePadThreshold, isConnected, flashedFields } = useDevice();
   const thresholds = config.pads[pad];
   const showHeavy = config.doubleInputMode && !simpleMode;
 
@@ -94,6 +96,7 @@ export function PadConfigGroup({ pad, simpleMode = false }: PadConfigGroupProps)
           value={thresholds.light}
           onChange={(val, commit) => updatePadThreshold(pad, "light", val, commit)}
           disabled={!isConnected}
+          flash={flashedFields.has(`pads.${pad}.light`)}
         />
 
         {/* Heavy Threshold (only when double mode enabled) */}
@@ -104,6 +107,7 @@ export function PadConfigGroup({ pad, simpleMode = false }: PadConfigGroupProps)
             value={thresholds.heavy}
             onChange={(val, commit) => updatePadThreshold(pad, "heavy", val, commit)}
             disabled={!isConnected}
+            flash={flashedFields.has(`pads.${pad}.heavy`)}
           />
         )}
 
@@ -115,6 +119,7 @@ export function PadConfigGroup({ pad, simpleMode = false }: PadConfigGroupProps)
             value={thresholds.cutoff}
             onChange={(val, commit) => updatePadThreshold(pad, "cutoff", val, commit)}
             disabled={!isConnected}
+            flash={flashedFields.has(`pads.${pad}.cutoff`)}
           />
         )}
       </CardContent>
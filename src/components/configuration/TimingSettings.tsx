@@ -15,6 +15,7 @@ interface TimingSettingProps {
   value: number;
   onChange: (field: keyof TimingConfig, value: number, commit?: boolean) => void;
   disabled?: boolean;
+  flash?: boolean;
 }
 
 function TimingSetting({
@@ -23,6 +24,7 @@ function TimingSetting({
   value,
   onChange,
   disabled,
+  flash,
 }: TimingSettingProps) {
   const handleSliderChange = (newValue: number[]) => {
     onChange(field, newValue[0], false);
@@ -39,7 +41,7 @@ function TimingSetting({
   };
 
   return (
-    <div className="space-y-2">
+    <div className={`space-y-2 ${flash ? "config-flash" : ""}`}>
       <div className="flex items-center justify-between">
         <Label className="text-sm">{label}</Label>
         <div className="flex items-center gap-1">
@@ -69,7 +71,7 @@ function TimingSetting({
 }
 
 export function TimingSettings() {
-  const { config, updateTiming, isConnected, resetTiming } = useDevice();
+  const { config, updateTiming, isConnected, resetTiming, flashedFields } = useDevice();
   const timing = config.timing;
 
   return (
@@ -98,6 +100,7 @@ export function TimingSettings() {
           value={timing.keyHoldTime}
           onChange={updateTiming}
           disabled={!isConnected}
+          flash={flashedFields.has("timing.keyHoldTime")}
         />
         <TimingSetting
           label="Don Debounce"
@@ -105,6 +108,7 @@ export function TimingSettings() {
           value={timing.donDebounce}
           onChange={updateTiming}
           disabled={!isConnected}
+          flash={flashedFields.has("timing.donDebounce")}
         />
         <TimingSetting
           label="Ka Debounce"
@@ -112,6 +116,7 @@ export function TimingSettings() {
           value={timing.kaDebounce}
           onChange={updateTiming}
           disabled={!isConnected}
+          flash={flashedFields.has("timing.kaDebounce")}
         />
         <TimingSetting
           label="Crosstalk Debounce"
@@ -119,6 +124,7 @@ export function TimingSettings() {
           value={timing.crosstalkDebounce}
           onChange={updateTiming}
           disabled={!isConnected}
+          flash={flashedFields.has("timing.crosstalkDebounce")}
         />
         <TimingSetting
           label="Individual Debounce"
@@ -126,6 +132,7 @@ export function TimingSettings() {
           value={timing.individualDebounce}
           onChange={updateTiming}
           disabled={!isConnected}
+          flash={flashedFields.has("timing.individualDebounce")}
         />
       </CardContent>
     </Card>
@@ -1,11 +1,14 @@
-import { useEffect, useState } from "react";
+import { Suspense, useEffect, useState } from "react";
 import { useDevice } from "@/context/DeviceContext";
 import { Button } from "@/components/ui/button";
 import { Badge } from "@/components/ui/badge";
 import { Card, CardContent } from "@/components/ui/card";
 import { Usb, AlertCircle, Skull } from "lucide-react";
 import { toast } from "sonner";
-import { EmergencyRecoveryModal } from "./EmergencyRecoveryModal";
+import { chunkLoaders, lazyNamed } from "@/lib/lazy-chunks";
+import { useOpenedOnce } from "@/hooks/useOpenedOnce";
+
+const EmergencyRecoveryModal = lazyNamed(chunkLoaders.recoveryModal, "EmergencyRecoveryModal");
 
 export function ConnectionPanel() {
   const {
@@ -20,6 +23,7 @@ export function ConnectionPanel() {
   } = useDevice();
 
   const [recoveryModalOpen, setRecoveryModalOpen] = useState(false);
+  const recoveryModalMounted = useOpenedOnce(recoveryModalOpen);
 
   // Show error as toast instead of inline
   useEffect(() => {
@@ -29,7 +33,7 @@ export function ConnectionPanel() {
   }, [error]);
 
   const handleConnect = async () => {
-    if (isConnected) {
+    if (isConnected || status === "reconnecting") {
       await disconnect();
     } else {
       const port = await requestPort();
@@ -68,7 +72,7 @@ export function ConnectionPanel() {
                 variant={
                   status === "connected"
                     ? "default"
-                    : status === "connecting"
+                    : status === "connecting" || status === "reconnecting"
                       ? "secondary"
                       : status === "error"
                         ? "destructive"
@@ -79,9 +83,11 @@ export function ConnectionPanel() {
                   ? "Connected"
                   : status === "connecting"
                     ? "Connecting..."
-                    : status === "error"
-                      ? "Error"
-                      : "Disconnected"}
+                    : status === "reconnecting"
+                      ? "Reconnecting..."
+                      : status === "error"
+                        ? "Error"
+                        : "Disconnected"}
               </Badge>
               {isConnected && config.firmwareVersion && (
                 <span className="text-xs text-muted-foreground font-mono border rounded px-1.5 py-0.5 bg-muted/50">
@@ -107,14 +113,18 @@ export function ConnectionPanel() {
           variant={isConnected ? "outline" : "default"}
           disabled={status === "connecting"}
         >
-          {isConnected ? "Disconnect" : "Connect"}
+          {isConnected ? "Disconnect" : status === "reconnecting" ? "Stop" : "Connect"}
         </Button>
       </CardContent>
 
-      <EmergencyRecoveryModal
-        open={recoveryModalOpen}
-        onOpenChange={setRecoveryModalOpen}
-      />
+      {recoveryModalMounted && (
+        <Suspense fallback={null}>
+          <EmergencyRecoveryModal
+            open={recoveryModalOpen}
+            onOpenChange={setRecoveryModalOpen}
+          />
+        </Suspense>
+      )}
     </Card>
   );
 }
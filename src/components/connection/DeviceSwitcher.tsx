@@ -0,0 +1,78 @@
+import { useDevice } from "@/context/DeviceContext";
+import { DeviceScope, useDeviceManager } from "@/context/DeviceManagerContext";
+import { Button } from "@/components/ui/button";
+import { Columns2, Plus, X } from "lucide-react";
+import { cn } from "@/lib/utils";
+import { FleetRolloutDialog } from "./FleetRolloutDialog";
+
+function DeviceStatusDot() {
+  const { status } = useDevice();
+  return (
+    <span
+      className={cn(
+        "h-2 w-2 rounded-full",
+        status === "connected" && "bg-green-500",
+        (status === "connecting" || status === "reconnecting") && "bg-amber-500",
+        status === "error" && "bg-destructive",
+        status === "disconnected" && "bg-muted-foreground/40"
+      )}
+    />
+  );
+}
+
+// Tabs for the connected drums. Hidden until a second one is added.
+export function DeviceSwitcher() {
+  const { deviceIds, activeId, setActiveId, addDevice, removeDevice, layout, setLayout } = useDeviceManager();
+  const { isSupported } = useDevice();
+
+  if (!isSupported) return null;
+
+  if (deviceIds.length < 2) {
+    return (
+      <Button variant="ghost" size="icon" className="h-8 w-8" onClick={addDevice} title="Add another drum">
+        <Plus className="h-4 w-4" />
+      </Button>
+    );
+  }
+
+  return (
+    <div className="flex items-center gap-1">
+      {deviceIds.map((id, index) => (
+        <div key={id} className="group relative">
+          <Button
+            variant={id === activeId ? "secondary" : "ghost"}
+            size="sm"
+            className="h-8 gap-2 pr-6"
+            onClick={() => setActiveId(id)}
+          >
+            <DeviceScope id={id}>
+              <DeviceStatusDot />
+            </DeviceScope>
+            Drum {index + 1}
+          </Button>
+          <button
+            type="button"
+            className="absolute right-1 top-1/2 -translate-y-1/2 rounded p-0.5 text-muted-foreground opacity-0 hover:text-foreground group-hover:opacity-100"
+            onClick={() => removeDevice(id)}
+            title={`Close drum ${index + 1}`}
+          >
+            <X className="h-3 w-3" />
+          </button>
+        </div>
+      ))}
+      <Button variant="ghost" size="icon" className="h-8 w-8" onClick={addDevice} title="Add another drum">
+        <Plus className="h-4 w-4" />
+      </Button>
+      <FleetRolloutDialog />
+      <Button
+        variant={layout === "side-by-side" ? "secondary" : "ghost"}
+        size="icon"
+        className="h-8 w-8"
+        onClick={() => setLayout(layout === "side-by-side" ? "single" : "side-by-side")}
+        title="Monitor all drums side by side"
+      >
+        <Columns2 className="h-4 w-4" />
+      </Button>
+    </div>
+  );
+}
@@ -1,4 +1,4 @@
-import { useState, useRef, useEffect } from "react";
+import { Suspense, useState, useRef, useEffect } from "react";
 import { useDevice } from "@/context/DeviceContext";
 import {
   Dialog,
@@ -10,9 +10,20 @@ import {
 } from "@/components/ui/dialog";
 import { Button } from "@/components/ui/button";
 import { AlertTriangle, Loader2, CheckCircle2, Skull, Download } from "lucide-react";
-import { DotLottieReact } from '@lottiefiles/dotlottie-react';
 import { Switch } from "@/components/ui/switch";
 import { Label } from "@/components/ui/label";
+import { waitForSerialEvent, startPhase } from "@/lib/device-readiness";
+import { openBootDriveFile, waitForBootDrive } from "@/lib/boot-drive";
+import { chunkLoaders, lazyNamed } from "@/lib/lazy-chunks";
+
+// The player is only needed when no device is connected
+const DotLottieReact = lazyNamed(chunkLoaders.lottie, "DotLottieReact");
+
+// Upper bounds only; each step continues as soon as the device is ready
+const BOOTSEL_TIMEOUT_MS = 5000;
+const NUKE_UNMOUNT_TIMEOUT_MS = 10000;
+const NUKE_REMOUNT_TIMEOUT_MS = 15000;
+const NUKE_FALLBACK_DELAY_MS = 5000;  // Only when the drive can't be watched
 
 type RecoveryStatus =
   | 'idle'
@@ -42,6 +53,8 @@ export function EmergencyRecoveryModal({ open, onOpenChange }: EmergencyRecovery
   const nukeBlobRef = useRef<Blob | null>(null);
   const firmwareBlobRef = useRef<Blob | null>(null);
   const firmwareNameRef = useRef<string>('firmware.uf2');
+  // RPI-RP2 drive once the user has selected it, so its remount can be watched
+  const driveRef = useRef<FileSystemDirectoryHandle | null>(null);
 
   const isRecovering = status !== 'idle' && status !== 'complete' && status !== 'error';
   const canClose = !isRecovering || status === 'ready_to_nuke' || status === 'ready_to_flash';
@@ -54,6 +67,7 @@ export function EmergencyRecoveryModal({ open, onOpenChange }: EmergencyRecovery
         setError(null);
         nukeBlobRef.current = null;
         firmwareBlobRef.current = null;
+        driveRef.current = null;
       }, 300); // Wait for transition
       return () => clearTimeout(timeout);
     }
@@ -76,11 +90,12 @@ export function EmergencyRecoveryModal({ open, onOpenChange }: EmergencyRecovery
 
     try {
       if (isConnected) {
-        // Reboot to bootsel first
+        // Reboot to bootsel first; listen before the port can disappear
         setStatus('rebooting');
+        const portGone = waitForSerialEvent('disconnect', BOOTSEL_TIMEOUT_MS);
+        const phase = startPhase('recovery', 'reboot to BOOTSEL');
         await rebootToBootsel();
-        // Wait for device to reboot
-        await new Promise(resolve => setTimeout(resolve, 3000));
+        phase.end((await portGone) ? 'port removed' : 'no disconnect event');
       }
 
       // Pre-fetch the flash nuke file
@@ -114,8 +129,6 @@ export function EmergencyRecoveryModal({ open, onOpenChange }: EmergencyRecovery
 
   const handleNukeConfirmed = async () => {
       setStatus('waiting_after_nuke');
-      // Give it a moment for the device to actually reboot if they just dragged it
-      await new Promise(resolve => setTimeout(resolve, 3000));
       try {
         await prepareFirmware();
       } catch (err) {
@@ -137,22 +150,24 @@ export function EmergencyRecoveryModal({ open, onOpenChange }: EmergencyRecovery
       setStatus('nuking');
 
       if ('showSaveFilePicker' in window) {
-        // Show save dialog for flash_nuke - this is triggered by user click!
-        // @ts-expect-error - showSaveFilePicker is not in standard types yet
-        const nukeHandle = await window.showSaveFilePicker({
-          suggestedName: 'flash_nuke.uf2',
-          types: [{
-            description: 'UF2 Firmware',
-            accept: { 'application/x-uf2': ['.uf2'] },
-          }],
-        });
-        const nukeWritable = await nukeHandle.createWritable();
-        await nukeWritable.write(nukeBlobRef.current);
-        await nukeWritable.close();
+        // Pick the drive (or reuse it) - this is triggered by user click!
+        const { writable, drive } = await openBootDriveFile('flash_nuke.uf2', driveRef.current);
+        driveRef.current = drive;
+        await writable.write(nukeBlobRef.current);
+        await writable.close();
         
-        // Automatic: Wait for device to wipe and reboot
+        // Automatic: the wipe ends with a reboot back into BOOTSEL, so the
+        // drive disappears and mounts again
         setStatus('waiting_after_nuke');
-        await new Promise(resolve => setTimeout(resolve, 5000));
+        const phase = startPhase('recovery', 'flash nuke');
+        if (drive) {
+          const unmounted = await waitForBootDrive(drive, false, NUKE_UNMOUNT_TIMEOUT_MS);
+          const remounted = await waitForBootDrive(drive, true, NUKE_REMOUNT_TIMEOUT_MS);
+          phase.end(unmounted && remounted ? 'drive remounted' : 'timed out');
+        } else {
+          await new Promise(resolve => setTimeout(resolve, NUKE_FALLBACK_DELAY_MS));
+          phase.end('fixed delay, drive not selected');
+        }
         await prepareFirmware();
       } else {
         // Fallback: Manual download
@@ -191,18 +206,11 @@ export function EmergencyRecoveryModal({ open, onOpenChange }: EmergencyRecovery
       setStatus('flashing');
 
       if ('showSaveFilePicker' in window) {
-        // Show save dialog for firmware - this is triggered by user click!
-        // @ts-expect-error - showSaveFilePicker is not in standard types yet
-        const firmwareHandle = await window.showSaveFilePicker({
-          suggestedName: firmwareNameRef.current,
-          types: [{
-            description: 'UF2 Firmware',
-            accept: { 'application/x-uf2': ['.uf2'] },
-          }],
-        });
-        const firmwareWritable = await firmwareHandle.createWritable();
-        await firmwareWritable.write(firmwareBlobRef.current);
-        await firmwareWritable.close();
+        // Reuses the drive from the nuke step - this is triggered by user click!
+        const { writable, drive } = await openBootDriveFile(firmwareNameRef.current, driveRef.current);
+        driveRef.current = drive;
+        await writable.write(firmwareBlobRef.current);
+        await writable.close();
         
         setStatus('complete');
       } else {
@@ -475,12 +483,14 @@ export function EmergencyRecoveryModal({ open, onOpenChange }: EmergencyRecovery
                     (RPI-RP2 drive should be visible) before proceeding.
                   </p>
                   <div className="flex justify-center">
-                    <DotLottieReact
-                      src="/lottie/enter_bootsel.lottie"
-                      loop
-                      autoplay
-                      style={{ width: 192, height: 192 }}
-                    />
+                    <Suspense fallback={<div style={{ width: 192, height: 192 }} />}>
+                      <DotLottieReact
+                        src="/lottie/enter_bootsel.lottie"
+                        loop
+                        autoplay
+                        style={{ width: 192, height: 192 }}
+                      />
+                    </Suspense>
                   </div>
                   <p className="text-xs text-blue-700 text-center">
                     Hold 1 then hold 2. Once the controller disconnects, release 1 then 2. A RPI-RP2 drive should appear on your computer.
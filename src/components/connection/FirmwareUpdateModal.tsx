@@ -9,13 +9,36 @@ import {
   DialogFooter,
 } from "@/components/ui/dialog";
 import { Button } from "@/components/ui/button";
-import { AlertCircle, Loader2, CheckCircle2, Download } from "lucide-react";
+import { Badge } from "@/components/ui/badge";
+import { AlertCircle, Loader2, CheckCircle2, Download, HardDrive } from "lucide-react";
 import { Switch } from "@/components/ui/switch";
 import { Label } from "@/components/ui/label";
+import {
+  Select,
+  SelectContent,
+  SelectItem,
+  SelectTrigger,
+  SelectValue,
+} from "@/components/ui/select";
+import { compareVersions } from "@/lib/utils";
 
 export function FirmwareUpdateModal() {
-  const { firmwareUpdate, isConnected, exportConfig } = useDevice();
-  const { status, progress, error, latestFirmware, modalOpen, setModalOpen, installUpdate } = firmwareUpdate;
+  const { firmwareUpdate, isConnected, exportConfig, config } = useDevice();
+  const {
+    status,
+    progress,
+    bytesWritten,
+    error,
+    latestFirmware,
+    releases,
+    manifestOffline,
+    pinnedVersion,
+    setPinnedVersion,
+    selectVersion,
+    modalOpen,
+    setModalOpen,
+    installUpdate,
+  } = firmwareUpdate;
   const [backupEnabled, setBackupEnabled] = useState(true);
 
   // Track if we reached 'complete' status to auto-close on reconnect
@@ -31,7 +54,7 @@ export function FirmwareUpdateModal() {
     }
 
     // If we were complete and device reconnected (status changed to idle/checking), close modal
-    if (wasCompleteRef.current && isConnected && (status === 'idle' || status === 'checking')) {
+    if (wasCompleteRef.current && isConnected && (status === 'idle' || status === 'checking' || status === 'available')) {
       wasCompleteRef.current = false;
       setModalOpen(false);
     }
@@ -42,6 +65,7 @@ export function FirmwareUpdateModal() {
       // Don't allow closing while updating
       return;
     }
+    if (!open) selectVersion(null);
     setModalOpen(open);
   };
 
@@ -52,6 +76,17 @@ export function FirmwareUpdateModal() {
     installUpdate();
   };
 
+  // Version choice is offered whenever nothing is running
+  const canChoose = (status === 'available' || status === 'idle') && latestFirmware !== null;
+  const installed = config.firmwareVersion;
+  const direction = !latestFirmware || !installed
+    ? 'update'
+    : compareVersions(latestFirmware.version, installed) > 0
+      ? 'update'
+      : compareVersions(latestFirmware.version, installed) < 0
+        ? 'rollback'
+        : 'reinstall';
+
   return (
     <Dialog open={modalOpen} onOpenChange={handleOpenChange}>
       <DialogContent className="sm:max-w-[500px]">
@@ -59,26 +94,68 @@ export function FirmwareUpdateModal() {
           <DialogTitle>Firmware Update</DialogTitle>
           <DialogDescription>
             {status === 'available' && (latestFirmware ? `Version ${latestFirmware.version} is available.` : "New version available.")}
-            {status === 'idle' && "Check for firmware updates."}
+            {status === 'idle' && (latestFirmware ? `Installed: v${installed ?? "unknown"}. Choose a version to install.` : "Check for firmware updates.")}
             {status === 'complete' && "Update successful!"}
           </DialogDescription>
         </DialogHeader>
 
         <div className="py-4">
-          {status === 'available' && latestFirmware && (
+          {canChoose && latestFirmware && (
             <div className="space-y-4">
+               <div className="space-y-3">
+                 <div className="flex items-center justify-between gap-2">
+                   <Label className="text-sm">Version</Label>
+                   <Select value={latestFirmware.version} onValueChange={selectVersion}>
+                     <SelectTrigger className="w-56">
+                       <SelectValue />
+                     </SelectTrigger>
+                     <SelectContent>
+                       {releases.map((r, i) => (
+                         <SelectItem key={r.version} value={r.version} disabled={!r.compatible}>
+                           v{r.version}
+                           {i === 0 && " (latest)"}
+                           {r.version === installed && " (installed)"}
+                           {!r.compatible && " (incompatible)"}
+                         </SelectItem>
+                       ))}
+                     </SelectContent>
+                   </Select>
+                 </div>
+
+                 <div className="flex items-center justify-between gap-2">
+                   <Label htmlFor="pin-firmware" className="text-sm">Stay on this version</Label>
+                   <Switch
+                     id="pin-firmware"
+                     checked={pinnedVersion === latestFirmware.version}
+                     onCheckedChange={(checked) => setPinnedVersion(checked ? latestFirmware.version : null)}
+                   />
+                 </div>
+
+                 <div className="flex flex-wrap gap-2">
+                   {latestFirmware.offline && (
+                     <Badge variant="secondary" className="gap-1">
+                       <HardDrive className="h-3 w-3" />
+                       Available offline
+                     </Badge>
+                   )}
+                   {manifestOffline && <Badge variant="outline">Offline: using saved release list</Badge>}
+                   {direction === 'rollback' && <Badge variant="outline">Rollback from v{installed}</Badge>}
+                 </div>
+               </div>
+
                <div className="space-y-2 text-sm text-muted-foreground">
                  <p className="font-medium text-foreground">How it works:</p>
                  <ol className="list-decimal list-inside space-y-1 ml-1">
-                   <li>The update file will be downloaded.</li>
+                   <li>{latestFirmware.offline ? "The verified local copy is used." : "The update file will be downloaded."}</li>
                    <li>Your device will reboot into bootloader mode.</li>
-                   <li>A "Save File" dialog will appear. Save the file to the "RPI-RP2" drive.</li>
+                   <li>Select the "RPI-RP2" drive when asked (only the first time).</li>
+                   <li>Your settings are restored automatically when the device reconnects.</li>
                  </ol>
                </div>
 
                <div className="flex items-center space-x-2 py-4 border-t">
                  <Switch id="backup-update" checked={backupEnabled} onCheckedChange={setBackupEnabled} />
-                 <Label htmlFor="backup-update">Backup configuration before updating</Label>
+                 <Label htmlFor="backup-update">Also download a backup file</Label>
                </div>
             </div>
           )}
@@ -99,7 +176,14 @@ export function FirmwareUpdateModal() {
               <div className="space-y-2">
                 <div className="flex justify-between text-sm font-medium">
                   <span className="capitalize">{status.replace(/_/g, ' ')}...</span>
-                  <span>{progress}%</span>
+                  <span className="tabular-nums">
+                    {status === 'writing' && latestFirmware && (
+                      <span className="text-muted-foreground font-normal mr-2">
+                        {Math.round(bytesWritten / 1024)} / {Math.round(latestFirmware.size / 1024)} KB
+                      </span>
+                    )}
+                    {progress}%
+                  </span>
                 </div>
                 <div className="h-2 w-full bg-secondary rounded-full overflow-hidden">
                   <div className="h-full bg-primary transition-all duration-300" style={{ width: `${progress}%` }} />
@@ -114,7 +198,7 @@ export function FirmwareUpdateModal() {
               
               {status === 'flashing' && (
                 <p className="text-sm text-amber-600 font-medium text-center bg-amber-50 p-2 rounded border border-amber-200">
-                  Please save the file to the "RPI-RP2" drive.
+                  Please select the "RPI-RP2" drive. It is remembered for future updates.
                 </p>
               )}
 
@@ -165,10 +249,12 @@ export function FirmwareUpdateModal() {
         </div>
 
         <DialogFooter className="sm:justify-between">
-           {status === 'available' ? (
+           {canChoose ? (
              <>
-               <Button variant="outline" onClick={() => setModalOpen(false)}>Cancel</Button>
-               <Button onClick={handleStartUpdate}>Start Update</Button>
+               <Button variant="outline" onClick={() => handleOpenChange(false)}>Cancel</Button>
+               <Button onClick={handleStartUpdate} disabled={!isConnected || !latestFirmware?.compatible}>
+                 {direction === 'rollback' ? "Roll Back" : direction === 'reinstall' ? "Reinstall" : "Start Update"}
+               </Button>
              </>
            ) : status === 'complete' ? (
              <Button className="w-full" onClick={() => setModalOpen(false)}>Close</Button>
@@ -0,0 +1,185 @@
+import { useRef, useState } from "react";
+import { useDevice } from "@/context/DeviceContext";
+import { DeviceScope, useDeviceManager } from "@/context/DeviceManagerContext";
+import {
+  Dialog,
+  DialogContent,
+  DialogDescription,
+  DialogFooter,
+  DialogHeader,
+  DialogTitle,
+  DialogTrigger,
+} from "@/components/ui/dialog";
+import { Button } from "@/components/ui/button";
+import { AlertCircle, CheckCircle2, ListChecks, Loader2, Upload } from "lucide-react";
+import { parseConfigProfile, type ConfigProfile, type ProfileApplyResult } from "@/lib/config-profile";
+
+type RowState = ProfileApplyResult | "running";
+
+function describeResult(result: ProfileApplyResult): string {
+  const time = `${(result.durationMs / 1000).toFixed(1)} s`;
+  if (result.error) return `${result.error} (${time})`;
+  if (result.mismatched.length > 0) return `Keys ${result.mismatched.join(", ")} read back differently (${time})`;
+  if (result.invalid.length > 0) return `Out of range: ${result.invalid.join(", ")} (${time})`;
+  return `${result.changed === 0 ? "Already up to date" : `${result.changed} changed, verified`} (${time})`;
+}
+
+function RolloutRow({ label, checked, onCheckedChange, state, disabled }: {
+  label: string;
+  checked: boolean;
+  onCheckedChange: (checked: boolean) => void;
+  state?: RowState;
+  disabled: boolean;
+}) {
+  const { isConnected, config } = useDevice();
+
+  return (
+    <label className="flex items-center gap-3 rounded-md border px-3 py-2 text-sm">
+      <input
+        type="checkbox"
+        checked={checked && isConnected}
+        disabled={disabled || !isConnected}
+        onChange={(e) => onCheckedChange(e.target.checked)}
+      />
+      <span className="font-medium">{label}</span>
+      <span className="text-xs text-muted-foreground">
+        {isConnected ? `v${config.firmwareVersion ?? "?"}` : "Not connected"}
+      </span>
+      <span className="ml-auto flex items-center gap-1 text-xs">
+        {state === "running" && <Loader2 className="h-4 w-4 animate-spin" />}
+        {state && state !== "running" && (
+          <>
+            {state.ok ? (
+              <CheckCircle2 className="h-4 w-4 text-green-500" />
+            ) : (
+              <AlertCircle className="h-4 w-4 text-destructive" />
+            )}
+            <span className={state.ok ? "text-muted-foreground" : "text-destructive"}>{describeResult(state)}</span>
+          </>
+        )}
+      </span>
+    </label>
+  );
+}
+
+// Applies one exported profile to every selected drum at once. Each device
+// writes only what differs, saves once and is verified by reading back, so
+// the whole rollout takes as long as the slowest drum.
+export function FleetRolloutDialog() {
+  const { deviceIds, getSession } = useDeviceManager();
+  const [open, setOpen] = useState(false);
+  const [profile, setProfile] = useState<{ name: string; profile: ConfigProfile } | null>(null);
+  const [profileError, setProfileError] = useState<string | null>(null);
+  const [excluded, setExcluded] = useState<Set<number>>(() => new Set());
+  const [results, setResults] = useState<Map<number, RowState>>(() => new Map());
+  const [totalMs, setTotalMs] = useState<number | null>(null);
+  const [running, setRunning] = useState(false);
+  const fileInputRef = useRef<HTMLInputElement>(null);
+
+  const handleFileChange = async (e: React.ChangeEvent<HTMLInputElement>) => {
+    const file = e.target.files?.[0];
+    e.target.value = "";
+    if (!file) return;
+    try {
+      setProfile({ name: file.name, profile: parseConfigProfile(await file.text()) });
+      setProfileError(null);
+    } catch (err) {
+      setProfile(null);
+      setProfileError(err instanceof Error ? err.message : String(err));
+    }
+    setResults(new Map());
+    setTotalMs(null);
+  };
+
+  const toggle = (id: number, checked: boolean) => {
+    setExcluded((prev) => {
+      const next = new Set(prev);
+      if (checked) next.delete(id);
+      else next.add(id);
+      return next;
+    });
+  };
+
+  const selectedIds = deviceIds.filter((id) => !excluded.has(id));
+
+  const handleApply = async () => {
+    const targets = selectedIds.filter((id) => getSession(id)?.isConnected);
+    if (!profile || targets.length === 0) return;
+    setRunning(true);
+    setTotalMs(null);
+    setResults(new Map(targets.map((id) => [id, "running"])));
+
+    const start = performance.now();
+    await Promise.all(
+      targets.map(async (id) => {
+        const session = getSession(id);
+        const result: ProfileApplyResult = session
+          ? await session.applyProfile(profile.profile)
+          : { ok: false, changed: 0, mismatched: [], invalid: [], error: "Device closed", durationMs: 0 };
+        setResults((prev) => new Map(prev).set(id, result));
+      })
+    );
+    setTotalMs(performance.now() - start);
+    setRunning(false);
+  };
+
+  const finished = [...results.values()].filter((r): r is ProfileApplyResult => r !== "running");
+  const failed = finished.filter((r) => !r.ok).length;
+
+  return (
+    <Dialog open={open} onOpenChange={(next) => !running && setOpen(next)}>
+      <DialogTrigger asChild>
+        <Button variant="ghost" size="icon" className="h-8 w-8" title="Apply a profile to several drums">
+          <ListChecks className="h-4 w-4" />
+        </Button>
+      </DialogTrigger>
+      <DialogContent className="sm:max-w-2xl">
+        <DialogHeader>
+          <DialogTitle>Profile Rollout</DialogTitle>
+          <DialogDescription>
+            Apply an exported configuration to the selected drums at the same time. Each drum is saved to flash
+            once and verified by reading its settings back.
+          </DialogDescription>
+        </DialogHeader>
+
+        <div className="flex items-center gap-3">
+          <Button variant="outline" size="sm" onClick={() => fileInputRef.current?.click()} disabled={running}>
+            <Upload className="h-4 w-4 mr-2" />
+            Choose Profile
+          </Button>
+          <span className="text-sm text-muted-foreground truncate">
+            {profile ? profile.name : "No profile selected"}
+          </span>
+          <input ref={fileInputRef} type="file" accept=".json" onChange={handleFileChange} className="hidden" />
+        </div>
+        {profileError && <p className="text-sm text-destructive">{profileError}</p>}
+
+        <div className="flex flex-col gap-2">
+          {deviceIds.map((id, index) => (
+            <DeviceScope key={id} id={id}>
+              <RolloutRow
+                label={`Drum ${index + 1}`}
+                checked={!excluded.has(id)}
+                onCheckedChange={(checked) => toggle(id, checked)}
+                state={results.get(id)}
+                disabled={running}
+              />
+            </DeviceScope>
+          ))}
+        </div>
+
+        <DialogFooter className="items-center">
+          {totalMs !== null && (
+            <span className="mr-auto text-sm text-muted-foreground">
+              {finished.length - failed} of {finished.length} verified in {(totalMs / 1000).toFixed(1)} s
+            </span>
+          )}
+          <Button onClick={handleApply} disabled={!profile || selectedIds.length === 0 || running}>
+            {running && <Loader2 className="h-4 w-4 mr-2 animate-spin" />}
+            Apply to Selected
+          </Button>
+        </DialogFooter>
+      </DialogContent>
+    </Dialog>
+  );
+}
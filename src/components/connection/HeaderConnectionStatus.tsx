@@ -1,10 +1,14 @@
-import { useEffect, useState } from "react";
+import { Suspense, useEffect, useState } from "react";
 import { useDevice } from "@/context/DeviceContext";
 import { Button } from "@/components/ui/button";
 import { Badge } from "@/components/ui/badge";
 import { Usb, AlertCircle, Skull } from "lucide-react";
 import { toast } from "sonner";
-import { EmergencyRecoveryModal } from "./EmergencyRecoveryModal";
+import { chunkLoaders, lazyNamed } from "@/lib/lazy-chunks";
+import { useOpenedOnce } from "@/hooks/useOpenedOnce";
+import { LinkHealthDialog } from "./LinkHealthDialog";
+
+const EmergencyRecoveryModal = lazyNamed(chunkLoaders.recoveryModal, "EmergencyRecoveryModal");
 
 export function HeaderConnectionStatus() {
   const {
@@ -16,9 +20,11 @@ export function HeaderConnectionStatus() {
     connect,
     disconnect,
     config,
+    firmwareUpdate,
   } = useDevice();
 
   const [recoveryModalOpen, setRecoveryModalOpen] = useState(false);
+  const recoveryModalMounted = useOpenedOnce(recoveryModalOpen);
 
   useEffect(() => {
     if (error) {
@@ -27,7 +33,7 @@ export function HeaderConnectionStatus() {
   }, [error]);
 
   const handleConnect = async () => {
-    if (isConnected) {
+    if (isConnected || status === "reconnecting") {
       await disconnect();
     } else {
       const port = await requestPort();
@@ -68,7 +74,7 @@ export function HeaderConnectionStatus() {
         variant={
           status === "connected"
             ? "default"
-            : status === "connecting"
+            : status === "connecting" || status === "reconnecting"
               ? "secondary"
               : status === "error"
                 ? "destructive"
@@ -80,14 +86,22 @@ export function HeaderConnectionStatus() {
           ? "Connected"
           : status === "connecting"
             ? "Connecting..."
-            : status === "error"
-              ? "Error"
-              : "Disconnected"}
+            : status === "reconnecting"
+              ? "Reconnecting..."
+              : status === "error"
+                ? "Error"
+                : "Disconnected"}
       </Badge>
+      {isConnected && <LinkHealthDialog />}
       {isConnected && config.firmwareVersion && (
-        <span className="text-xs text-muted-foreground font-mono">
+        <button
+          type="button"
+          className="text-xs text-muted-foreground font-mono hover:text-foreground hover:underline"
+          onClick={() => firmwareUpdate.setModalOpen(true)}
+          title="Firmware versions"
+        >
           v{config.firmwareVersion}
-        </span>
+        </button>
       )}
       <Button
         variant="ghost"
@@ -104,13 +118,17 @@ export function HeaderConnectionStatus() {
         size="sm"
         disabled={status === "connecting"}
       >
-        {isConnected ? "Disconnect" : "Connect"}
+        {isConnected ? "Disconnect" : status === "reconnecting" ? "Stop" : "Connect"}
       </Button>
 
-      <EmergencyRecoveryModal
-        open={recoveryModalOpen}
-        onOpenChange={setRecoveryModalOpen}
-      />
+      {recoveryModalMounted && (
+        <Suspense fallback={null}>
+          <EmergencyRecoveryModal
+            open={recoveryModalOpen}
+            onOpenChange={setRecoveryModalOpen}
+          />
+        </Suspense>
+      )}
     </div>
   );
 }
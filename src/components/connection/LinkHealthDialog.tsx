@@ -0,0 +1,144 @@
+import { useState, useSyncExternalStore } from "react";
+import { useDevice } from "@/context/DeviceContext";
+import {
+  Dialog,
+  DialogContent,
+  DialogDescription,
+  DialogHeader,
+  DialogTitle,
+  DialogTrigger,
+} from "@/components/ui/dialog";
+import { Button } from "@/components/ui/button";
+import { Label } from "@/components/ui/label";
+import { NumberInput } from "@/components/ui/numberinput";
+import { Activity } from "lucide-react";
+import {
+  DEFAULT_LINK_LIMITS,
+  HEARTBEAT_MS,
+  RTT_BIN_EDGES_MS,
+  getLinkLimits,
+  setLinkLimits,
+  subscribeLinkLimits,
+  type LinkLimits,
+} from "@/lib/link-health";
+
+const BIN_LABELS = [
+  ...RTT_BIN_EDGES_MS.map((edge) => `<${edge}`),
+  `≥${RTT_BIN_EDGES_MS[RTT_BIN_EDGES_MS.length - 1]}`,
+];
+
+const formatMs = (ms: number | null) => (ms === null ? "–" : `${ms < 10 ? ms.toFixed(1) : Math.round(ms)} ms`);
+
+// Round trip and stream rate of the active drum. The trigger is a quiet icon
+// while the link is fine and a warning when it exceeds the limits.
+export function LinkHealthDialog() {
+  const { linkHealth: health, isStreaming, ownsPort } = useDevice();
+  const limits = useSyncExternalStore(subscribeLinkLimits, getLinkLimits);
+  const [open, setOpen] = useState(false);
+
+  const setLimit = (field: keyof LinkLimits, value: number | undefined) => {
+    if (value === undefined || value <= 0) return;
+    setLinkLimits({ ...limits, [field]: value });
+  };
+
+  const largestBin = Math.max(1, ...health.histogram);
+
+  return (
+    <Dialog open={open} onOpenChange={setOpen}>
+      <DialogTrigger asChild>
+        {health.degraded ? (
+          <Button
+            variant="ghost"
+            size="sm"
+            className="h-7 px-2 text-xs text-amber-600 hover:text-amber-600"
+            title={health.reasons.join("\n")}
+          >
+            <Activity className="h-3.5 w-3.5 mr-1" />
+            Slow link
+          </Button>
+        ) : (
+          <Button variant="ghost" size="icon" className="h-8 w-8 text-muted-foreground" title="Connection health">
+            <Activity className="h-4 w-4" />
+          </Button>
+        )}
+      </DialogTrigger>
+      <DialogContent className="sm:max-w-md">
+        <DialogHeader>
+          <DialogTitle>Connection Health</DialogTitle>
+          <DialogDescription>
+            A settings read every {HEARTBEAT_MS / 1000} s measures the round trip to the drum.
+            {!ownsPort
+              ? " The drum is connected in another tab, which runs the heartbeat."
+              : health.samples > 0
+                ? ` Last ${health.samples} heartbeats.`
+                : " Waiting for the first heartbeat."}
+          </DialogDescription>
+        </DialogHeader>
+
+        {health.degraded && (
+          <ul className="rounded-md border border-amber-500/50 bg-amber-500/10 p-3 text-sm text-amber-600 space-y-1">
+            {health.reasons.map((reason) => <li key={reason}>{reason}</li>)}
+          </ul>
+        )}
+
+        <div className="grid grid-cols-2 gap-x-4 gap-y-1 text-sm">
+          <span className="text-muted-foreground">Round trip (median)</span>
+          <span className="font-mono text-right">{formatMs(health.p50Ms)}</span>
+          <span className="text-muted-foreground">Round trip (p95)</span>
+          <span className="font-mono text-right">{formatMs(health.p95Ms)}</span>
+          <span className="text-muted-foreground">Jitter</span>
+          <span className="font-mono text-right">{formatMs(health.jitterMs)}</span>
+          <span className="text-muted-foreground">Unanswered</span>
+          <span className="font-mono text-right">{health.timeouts}</span>
+          {isStreaming && health.lineRate !== null && (
+            <>
+              <span className="text-muted-foreground">Stream rate</span>
+              <span className="font-mono text-right">
+                {Math.round(health.lineRate)}/s ±{Math.round((health.lineRateVariation ?? 0) * 100)}%
+              </span>
+            </>
+          )}
+        </div>
+
+        {/* Round trip histogram */}
+        <div className="flex items-end gap-1 h-24 pt-2">
+          {health.histogram.map((count, i) => (
+            <div key={BIN_LABELS[i]} className="flex-1 flex flex-col items-center justify-end h-full gap-1">
+              <div
+                className="w-full rounded-sm bg-primary/70"
+                style={{ height: `${(count / largestBin) * 100}%`, minHeight: count > 0 ? 2 : 0 }}
+                title={`${count} heartbeat${count === 1 ? "" : "s"}`}
+              />
+              <span className="text-[9px] text-muted-foreground">{BIN_LABELS[i]}</span>
+            </div>
+          ))}
+        </div>
+
+        <div className="space-y-2 border-t pt-4">
+          <p className="text-sm font-medium">Warn above</p>
+          <div className="flex items-center justify-between gap-2">
+            <Label className="text-sm font-normal">Round trip (p95)</Label>
+            <NumberInput value={limits.rttMs} onValueChange={(v) => setLimit("rttMs", v)} className="w-24" min={1} suffix=" ms" />
+          </div>
+          <div className="flex items-center justify-between gap-2">
+            <Label className="text-sm font-normal">Jitter</Label>
+            <NumberInput value={limits.jitterMs} onValueChange={(v) => setLimit("jitterMs", v)} className="w-24" min={1} suffix=" ms" />
+          </div>
+          <div className="flex items-center justify-between gap-2">
+            <Label className="text-sm font-normal">Stream rate variation</Label>
+            <NumberInput
+              value={Math.round(limits.lineRateVariation * 100)}
+              onValueChange={(v) => setLimit("lineRateVariation", v === undefined ? v : v / 100)}
+              className="w-24"
+              min={1}
+              suffix=" %"
+            />
+          </div>
+          <Button variant="ghost" size="sm" onClick={() => setLinkLimits(DEFAULT_LINK_LIMITS)}>
+            Reset limits
+          </Button>
+        </div>
+      </DialogContent>
+    </Dialog>
+  );
+}
@@ -0,0 +1,132 @@
+import { useEffect, useState } from "react";
+import {
+  Dialog,
+  DialogContent,
+  DialogDescription,
+  DialogHeader,
+  DialogTitle,
+  DialogTrigger,
+} from "@/components/ui/dialog";
+import { Button } from "@/components/ui/button";
+import {
+  Select,
+  SelectContent,
+  SelectItem,
+  SelectTrigger,
+  SelectValue,
+} from "@/components/ui/select";
+import { Download, Pause, Play, ScrollText, Trash2 } from "lucide-react";
+import {
+  traceRxEnabled,
+  traceTxEnabled,
+  getTraceRecords,
+  getTraceStats,
+  formatTracePayload,
+  exportTraceText,
+  clearTrace,
+} from "@/lib/serial-trace";
+import { useDeviceManager } from "@/context/DeviceManagerContext";
+
+const WINDOW_OPTIONS = [5, 10, 30, 60];
+const MAX_ROWS = 500;       // Rendering is the expensive part, not the ring
+const REFRESH_MS = 500;
+
+function formatTrace(seconds: number, device: number): { text: string; shown: number; total: number } {
+  const records = getTraceRecords(seconds, device);
+  const visible = records.slice(-MAX_ROWS);
+  const text = visible
+    .map((r) => `${(r.time / 1000).toFixed(4).padStart(10)}  ${r.direction === "tx" ? "TX" : "RX"}  ${formatTracePayload(r)}`)
+    .join("\n");
+  return { text, shown: visible.length, total: records.length };
+}
+
+// Shows and exports the trace of the active drum
+export function SerialTraceDialog() {
+  const { deviceIds, activeId } = useDeviceManager();
+  const [open, setOpen] = useState(false);
+  const [seconds, setSeconds] = useState(10);
+  const [paused, setPaused] = useState(false);
+  const [view, setView] = useState(() => formatTrace(10, activeId));
+
+  // Only format while the dialog is visible
+  useEffect(() => {
+    if (!open || paused) return;
+    const refresh = () => setView(formatTrace(seconds, activeId));
+    refresh();
+    const timer = setInterval(refresh, REFRESH_MS);
+    return () => clearInterval(timer);
+  }, [open, paused, seconds, activeId]);
+
+  const drum = deviceIds.length > 1 ? deviceIds.indexOf(activeId) + 1 : null;
+
+  const handleExport = () => {
+    const blob = new Blob([exportTraceText(undefined, activeId)], { type: "text/plain" });
+    const url = URL.createObjectURL(blob);
+    const a = document.createElement("a");
+    a.href = url;
+    a.download = `itaiko-trace-${drum ? `drum${drum}-` : ""}${new Date().toISOString().replace(/[:.]/g, "-")}.txt`;
+    document.body.appendChild(a);
+    a.click();
+    document.body.removeChild(a);
+    URL.revokeObjectURL(url);
+  };
+
+  const handleClear = () => {
+    clearTrace();
+    setView(formatTrace(seconds, activeId));
+  };
+
+  const stats = getTraceStats();
+  const directions = [traceRxEnabled && "RX", traceTxEnabled && "TX"].filter(Boolean).join(" + ");
+
+  return (
+    <Dialog open={open} onOpenChange={setOpen}>
+      <DialogTrigger asChild>
+        <Button variant="ghost" size="sm" title="Serial trace">
+          <ScrollText className="h-4 w-4 mr-1" />
+          Trace
+        </Button>
+      </DialogTrigger>
+      <DialogContent className="sm:max-w-3xl">
+        <DialogHeader>
+          <DialogTitle>Serial Trace{drum && ` – Drum ${drum}`}</DialogTitle>
+          <DialogDescription>
+            Recording {directions}. {stats.records.toLocaleString()} records in the buffer,
+            showing the last {view.shown} of {view.total} from the selected window.
+          </DialogDescription>
+        </DialogHeader>
+
+        <div className="flex flex-wrap items-center gap-2">
+          <Select value={seconds.toString()} onValueChange={(v) => setSeconds(parseInt(v, 10))}>
+            <SelectTrigger className="w-32">
+              <SelectValue />
+            </SelectTrigger>
+            <SelectContent>
+              {WINDOW_OPTIONS.map((s) => (
+                <SelectItem key={s} value={s.toString()}>
+                  Last {s} s
+                </SelectItem>
+              ))}
+            </SelectContent>
+          </Select>
+          <Button variant="outline" size="sm" onClick={() => setPaused((p) => !p)}>
+            {paused ? <Play className="h-4 w-4 mr-1" /> : <Pause className="h-4 w-4 mr-1" />}
+            {paused ? "Resume" : "Pause"}
+          </Button>
+          <Button variant="outline" size="sm" onClick={handleClear}>
+            <Trash2 className="h-4 w-4 mr-1" />
+            Clear
+          </Button>
+          <Button size="sm" onClick={handleExport} className="ml-auto">
+            <Download className="h-4 w-4 mr-1" />
+            Export
+          </Button>
+        </div>
+
+        <pre className="h-96 overflow-auto rounded-md border bg-muted/40 p-2 text-xs font-mono whitespace-pre">
+          {view.text || "No traffic in this window."}
+        </pre>
+      </DialogContent>
+    </Dialog>
+  );
+}
@@ -0,0 +1,61 @@
+import { useRef } from "react";
+import { Button } from "@/components/ui/button";
+import { Label } from "@/components/ui/label";
+import { NumberInput } from "@/components/ui/numberinput";
+import { FileUp, Radio, ScanLine } from "lucide-react";
+import { SAMPLE_RATE_MIN, SAMPLE_RATE_MAX } from "@/lib/signal-generator";
+import type { AnalysisSource } from "@/hooks/useAnalysisSource";
+
+interface AnalysisSourceControlsProps {
+  source: AnalysisSource;
+  onAnalyze: () => void;
+  isRunning: boolean;
+}
+
+// Graph buffer or recorded session, sample rate and the Analyze button
+export function AnalysisSourceControls({ source, onAnalyze, isRunning }: AnalysisSourceControlsProps) {
+  const fileInputRef = useRef<HTMLInputElement>(null);
+
+  const handleFileChange = (e: React.ChangeEvent<HTMLInputElement>) => {
+    const file = e.target.files?.[0];
+    e.target.value = "";
+    if (file) source.loadFile(file);
+  };
+
+  return (
+    <div className="space-y-2">
+      <div className="flex flex-wrap items-center gap-2">
+        <Button variant={source.session ? "ghost" : "secondary"} onClick={source.selectGraphBuffer}>
+          <Radio className="h-4 w-4 mr-2" />
+          Graph buffer
+        </Button>
+        <Button
+          variant={source.session ? "secondary" : "ghost"}
+          onClick={() => fileInputRef.current?.click()}
+          title="Raw stream capture or serial trace export"
+        >
+          <FileUp className="h-4 w-4 mr-2" />
+          {source.session ? source.session.name : "Load session..."}
+        </Button>
+        <input ref={fileInputRef} type="file" accept=".txt,.log" onChange={handleFileChange} className="hidden" />
+
+        <div className="flex items-center gap-2 ml-auto">
+          <Label className="text-sm font-normal">Sample rate</Label>
+          <NumberInput
+            value={source.sampleRate}
+            onValueChange={source.setSampleRate}
+            className="w-28"
+            min={SAMPLE_RATE_MIN}
+            max={SAMPLE_RATE_MAX}
+            suffix=" Hz"
+          />
+        </div>
+        <Button onClick={onAnalyze} disabled={isRunning}>
+          <ScanLine className="h-4 w-4 mr-2" />
+          {isRunning ? "Analyzing..." : "Analyze"}
+        </Button>
+      </div>
+      {source.error && <p className="text-sm text-destructive">{source.error}</p>}
+    </div>
+  );
+}
@@ -0,0 +1,193 @@
+import { useState } from "react";
+import { useDevice } from "@/context/DeviceContext";
+import { useStreamAnalysis } from "@/hooks/useStreamAnalysis";
+import { useAnalysisSource, type AnalysisOutcome } from "@/hooks/useAnalysisSource";
+import { AnalysisSourceControls } from "./AnalysisSourceControls";
+import { Button } from "@/components/ui/button";
+import { Card, CardContent, CardHeader, CardTitle } from "@/components/ui/card";
+import { X } from "lucide-react";
+import { PAD_NAMES, PAD_LABELS } from "@/types";
+import { LAG_BIN_MS, type CrosstalkResult } from "@/lib/crosstalk";
+
+interface CrosstalkCardProps {
+  onClose: () => void;
+}
+
+// Fewer hits say little about the bleed's p99, so the debounce isn't offered
+const MIN_APPLY_HITS = 20;
+
+const percent = (ratio: number) => `${(ratio * 100).toFixed(ratio < 0.1 ? 1 : 0)}%`;
+
+// Bleed between pads over the graph buffer or a recorded session, and the
+// crosstalk debounce that would reject it
+export function CrosstalkCard({ onClose }: CrosstalkCardProps) {
+  const { buffers, config, linkHealth, isConnected, updateTiming } = useDevice();
+  const analyze = useStreamAnalysis();
+  const source = useAnalysisSource(buffers, linkHealth.lineRate);
+  // Tagged with the source revision it ran on, so another source hides it
+  const [outcome, setOutcome] = useState<AnalysisOutcome<CrosstalkResult> | null>(null);
+  const [isRunning, setIsRunning] = useState(false);
+  const current = outcome?.revision === source.revision ? outcome : null;
+  const result = current?.result ?? null;
+  const error = current?.error ?? null;
+
+  const handleAnalyze = async () => {
+    const input = source.getFrames();
+    if (!input) return;
+    const revision = source.revision;
+    setIsRunning(true);
+    setOutcome((prev) => prev && { ...prev, error: null });
+    try {
+      const next = await analyze("crosstalk", {
+        frames: input.frames,
+        sampleIntervalMs: input.sampleIntervalMs,
+        light: {
+          kaLeft: config.pads.kaLeft.light,
+          donLeft: config.pads.donLeft.light,
+          donRight: config.pads.donRight.light,
+          kaRight: config.pads.kaRight.light,
+        },
+      });
+      setOutcome({ revision, result: next, error: null });
+    } catch (err) {
+      setOutcome({ revision, result: null, error: err instanceof Error ? err.message : String(err) });
+    } finally {
+      setIsRunning(false);
+    }
+  };
+
+  const current = config.timing.crosstalkDebounce;
+  const largestBin = result ? Math.max(1, ...result.lagHistogram) : 1;
+  const totalHits = result ? PAD_NAMES.reduce((sum, pad) => sum + result.hits[pad], 0) : 0;
+
+  return (
+    <Card>
+      <CardHeader className="flex flex-row items-center justify-between space-y-0 pb-2">
+        <CardTitle className="text-base">Crosstalk</CardTitle>
+        <Button variant="ghost" size="icon" className="h-8 w-8" onClick={onClose} title="Close">
+          <X className="h-4 w-4" />
+        </Button>
+      </CardHeader>
+      <CardContent className="space-y-4">
+        <AnalysisSourceControls source={source} onAnalyze={handleAnalyze} isRunning={isRunning} />
+
+        {error && <p className="text-sm text-destructive">{error}</p>}
+
+        {result && (
+          <>
+            <p className="text-sm text-muted-foreground">
+              {result.samples.toLocaleString()} samples,{" "}
+              {totalHits.toLocaleString()} hits
+              {result.secondHits > 0 && `, ${result.secondHits} simultaneous hits left out`}
+              {" "}({Math.round(result.elapsedMs)} ms)
+            </p>
+
+            {/* Bleed ratio: hit pad (row) into the others (columns) */}
+            <table className="w-full text-sm font-mono tabular-nums">
+              <thead>
+                <tr className="text-xs text-muted-foreground [&>th]:font-normal [&>th]:text-right [&>th:first-child]:text-left">
+                  <th>Hit ↓ / bleed →</th>
+                  {PAD_NAMES.map((pad) => <th key={pad} className="font-sans">{PAD_LABELS[pad]}</th>)}
+                </tr>
+              </thead>
+              <tbody>
+                {PAD_NAMES.map((source) => (
+                  <tr key={source} className="[&>td]:text-right [&>td:first-child]:text-left">
+                    <td className="font-sans">{PAD_LABELS[source]} ({result.hits[source]})</td>
+                    {PAD_NAMES.map((target) => {
+                      const cell = result.matrix[source][target];
+                      if (!cell) return <td key={target} className="text-muted-foreground">–</td>;
+                      return (
+                        <td
+                          key={target}
+                          className={cell.triggered > 0 ? "text-amber-600" : ""}
+                          title={`${cell.count} responses, p95 ${percent(cell.p95Ratio)} at ${cell.p95LagMs.toFixed(1)} ms, ${cell.triggered} above the light threshold`}
+                        >
+                          {cell.count > 0 ? percent(cell.medianRatio) : "–"}
+                        </td>
+                      );
+                    })}
+                  </tr>
+                ))}
+              </tbody>
+            </table>
+
+            {/* Bleed peak lag after the hit */}
+            <div className="space-y-1">
+              <p className="text-xs text-muted-foreground">Bleed peak after the hit ({LAG_BIN_MS} ms bins)</p>
+              <div className="flex items-end gap-px h-16">
+                {result.lagHistogram.map((count, i) => (
+                  <div
+                    key={i}
+                    className="flex-1 rounded-sm bg-primary/70"
+                    style={{ height: `${(count / largestBin) * 100}%`, minHeight: count > 0 ? 2 : 0 }}
+                    title={`${i * LAG_BIN_MS}-${(i + 1) * LAG_BIN_MS} ms: ${count}`}
+                  />
+                ))}
+              </div>
+            </div>
+
+            {/* Threshold margins against the bleed */}
+            <table className="w-full text-sm font-mono tabular-nums">
+              <thead>
+                <tr className="text-xs text-muted-foreground [&>th]:font-normal [&>th]:text-right [&>th:first-child]:text-left">
+                  <th>Pad</th>
+                  <th>Bleed p99</th>
+                  <th>Light</th>
+                  <th>Margin</th>
+                  <th>Light without debounce</th>
+                </tr>
+              </thead>
+              <tbody>
+                {PAD_NAMES.map((pad) => {
+                  const margin = config.pads[pad].light - result.bleedP99[pad];
+                  return (
+                    <tr key={pad} className="[&>td]:text-right [&>td:first-child]:text-left">
+                      <td className="font-sans">{PAD_LABELS[pad]}</td>
+                      <td>{result.bleedP99[pad]}</td>
+                      <td>{config.pads[pad].light}</td>
+                      <td className={margin <= 0 ? "text-amber-600" : ""}>{margin > 0 ? `+${margin}` : margin}</td>
+                      <td>{result.suggestedLight[pad] ?? "–"}</td>
+                    </tr>
+                  );
+                })}
+              </tbody>
+            </table>
+
+            <div className="flex flex-wrap items-center gap-3 rounded-md border p-3 text-sm">
+              {result.recommendedDebounceMs > 0 ? (
+                <span>
+                  Crosstalk debounce needed: <span className="font-mono font-semibold">{result.recommendedDebounceMs} ms</span>
+                  <span className="text-muted-foreground"> (now {current} ms)</span>
+                </span>
+              ) : (
+                <span>No bleed crossed a light threshold.</span>
+              )}
+              {result.recommendedDebounceMs > 0 && totalHits >= MIN_APPLY_HITS && (
+                <Button
+                  size="sm"
+                  variant="outline"
+                  className="ml-auto"
+                  onClick={() => updateTiming("crosstalkDebounce", result.recommendedDebounceMs)}
+                  disabled={!isConnected || result.recommendedDebounceMs === current}
+                >
+                  Apply
+                </Button>
+              )}
+              {result.recommendedDebounceMs > 0 && totalHits < MIN_APPLY_HITS && (
+                <p className="w-full text-muted-foreground">
+                  Only {totalHits} hits analysed; record at least {MIN_APPLY_HITS} before applying.
+                </p>
+              )}
+              {result.earlyBleed > 0 && (
+                <p className="w-full text-amber-600">
+                  {result.earlyBleed} bleed responses crossed before the hit itself; only a higher light threshold rejects those.
+                </p>
+              )}
+            </div>
+          </>
+        )}
+      </CardContent>
+    </Card>
+  );
+}
@@ -1,37 +1,78 @@
-import { useEffect, useRef } from "react";
+import { useEffect, useState } from "react";
+import { useSearchParams } from "react-router-dom";
 import { useDevice } from "@/context/DeviceContext";
-import { MonitorControls } from "./MonitorControls";
+import { DeviceScope, useDeviceManager } from "@/context/DeviceManagerContext";
+import { MonitorControls, type MonitorPanel } from "./MonitorControls";
 import { PadGraph } from "./PadGraph";
+import { PerfHud } from "./PerfHud";
+import { NoiseFloorCard } from "./NoiseFloorCard";
+import { CrosstalkCard } from "./CrosstalkCard";
+import { RetriggerCard } from "./RetriggerCard";
 import { PAD_NAMES } from "@/types";
+import { AudioWaveform, Gauge, Repeat, Waypoints } from "lucide-react";
 
-export function LiveMonitorTab() {
-  const { buffers, config, maxBufferSize, isReady, startStreaming, stopStreaming } = useDevice();
+type PanelId = "noise" | "crosstalk" | "retriggers" | "perf";
 
-  // Use ref to always have latest function without causing effect re-runs
-  const startStreamingRef = useRef(startStreaming);
-  const stopStreamingRef = useRef(stopStreaming);
-  useEffect(() => {
-    startStreamingRef.current = startStreaming;
-    stopStreamingRef.current = stopStreaming;
-  });
+const PANELS: readonly MonitorPanel<PanelId>[] = [
+  { id: "noise", icon: AudioWaveform, label: "Noise floor" },
+  { id: "crosstalk", icon: Waypoints, label: "Crosstalk" },
+  { id: "retriggers", icon: Repeat, label: "Retriggers" },
+  { id: "perf", icon: Gauge, label: "Performance" },  // Only where allowPerf
+];
+
+interface DeviceMonitorProps {
+  title?: string;
+  allowPerf?: boolean;
+}
 
-  // Start streaming when device is ready (after config read)
+// Streams from the device in scope while mounted and graphs its pads
+function DeviceMonitor({ title, allowPerf = false }: DeviceMonitorProps) {
+  const { buffers, config, maxBufferSize, isReady, holdStreaming } = useDevice();
+  const [searchParams] = useSearchParams();
+  const [openPanels, setOpenPanels] = useState<ReadonlySet<PanelId>>(
+    () => new Set(allowPerf && searchParams.get("perf") === "true" ? ["perf"] : [])
+  );
+  const panels = allowPerf ? PANELS : PANELS.filter((panel) => panel.id !== "perf");
+
+  const togglePanel = (id: PanelId) => {
+    setOpenPanels((prev) => {
+      const next = new Set(prev);
+      if (!next.delete(id)) next.add(id);
+      return next;
+    });
+  };
+  const closePanel = (id: PanelId) => {
+    setOpenPanels((prev) => {
+      const next = new Set(prev);
+      next.delete(id);
+      return next;
+    });
+  };
+
+  // Stream when device is ready (after config read). The pop-out window may
+  // hold the stream too, so leaving this tab doesn't stop it under it.
   useEffect(() => {
-    if (isReady) {
-      startStreamingRef.current('raw');
-    }
-    return () => {
-      stopStreamingRef.current();
-    };
-  }, [isReady]);
+    if (!isReady) return;
+    return holdStreaming();
+  }, [isReady, holdStreaming]);
 
   return (
     <div className="space-y-4">
       {/* Controls */}
-      <MonitorControls />
+      <MonitorControls
+        title={title}
+        panels={panels}
+        openPanels={openPanels}
+        onTogglePanel={togglePanel}
+      />
+
+      {openPanels.has("noise") && <NoiseFloorCard onClose={() => closePanel("noise")} />}
+      {openPanels.has("crosstalk") && <CrosstalkCard onClose={() => closePanel("crosstalk")} />}
+      {openPanels.has("retriggers") && <RetriggerCard onClose={() => closePanel("retriggers")} />}
 
       {/* Graphs Grid */}
       <div className="flex flex-col gap-4">
+        {openPanels.has("perf") && <PerfHud onClose={() => closePanel("perf")} />}
         {PAD_NAMES.map((pad) => (
           <PadGraph
             key={pad}
@@ -49,3 +90,21 @@ export function LiveMonitorTab() {
     </div>
   );
 }
+
+export function LiveMonitorTab() {
+  const { deviceIds, layout } = useDeviceManager();
+
+  if (layout === "side-by-side" && deviceIds.length > 1) {
+    return (
+      <div className="grid gap-4 lg:grid-cols-2">
+        {deviceIds.map((id, index) => (
+          <DeviceScope key={id} id={id}>
+            <DeviceMonitor title={`Drum ${index + 1}`} />
+          </DeviceScope>
+        ))}
+      </div>
+    );
+  }
+
+  return <DeviceMonitor allowPerf />;
+}
@@ -1,9 +1,24 @@
 import { useDevice } from "@/context/DeviceContext";
+import { useMonitorPopout } from "@/context/MonitorPopoutContext";
 import { Button } from "@/components/ui/button";
 import { Card, CardContent } from "@/components/ui/card";
-import { Play, Pause, Trash2 } from "lucide-react";
+import { Play, Pause, Trash2, ExternalLink, type LucideIcon } from "lucide-react";
 
-export function MonitorControls() {
+// A card or overlay the live monitor can show
+export interface MonitorPanel<Id extends string> {
+  id: Id;
+  icon: LucideIcon;
+  label: string;
+}
+
+interface MonitorControlsProps<Id extends string> {
+  title?: string;
+  panels?: readonly MonitorPanel<Id>[];
+  openPanels?: ReadonlySet<Id>;
+  onTogglePanel?: (id: Id) => void;
+}
+
+export function MonitorControls<Id extends string>({ title, panels = [], openPanels, onTogglePanel }: MonitorControlsProps<Id>) {
   const {
     isConnected,
     isStreaming,
@@ -11,6 +26,7 @@ export function MonitorControls() {
     stopStreaming,
     clearData,
   } = useDevice();
+  const popout = useMonitorPopout();
 
   const handleTogglePause = async () => {
     if (isStreaming) {
@@ -23,6 +39,8 @@ export function MonitorControls() {
   return (
     <Card>
       <CardContent className="flex flex-wrap items-center gap-6 py-4">
+        {title && <span className="font-medium">{title}</span>}
+
         {/* Pause/Resume Control */}
         <div className="flex items-center gap-2">
           <Button
@@ -51,6 +69,27 @@ export function MonitorControls() {
             Clear
           </Button>
         </div>
+
+        <Button
+          variant={popout.isOpen ? "secondary" : "ghost"}
+          onClick={popout.open}
+          className="ml-auto"
+          title="Keep the graphs in their own window while editing settings"
+        >
+          <ExternalLink className="h-4 w-4 mr-2" />
+          {popout.isOpen ? "Popped out" : "Pop out graphs"}
+        </Button>
+
+        {panels.map(({ id, icon: Icon, label }) => (
+          <Button
+            key={id}
+            variant={openPanels?.has(id) ? "secondary" : "ghost"}
+            onClick={() => onTogglePanel?.(id)}
+          >
+            <Icon className="h-4 w-4 mr-2" />
+            {label}
+          </Button>
+        ))}
       </CardContent>
     </Card>
   );
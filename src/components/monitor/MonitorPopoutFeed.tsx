@@ -0,0 +1,53 @@
+import { useEffect } from "react";
+import { useDevice } from "@/context/DeviceContext";
+import { useDeviceManager } from "@/context/DeviceManagerContext";
+import { useMonitorPopout } from "@/context/MonitorPopoutContext";
+import {
+  MONITOR_BATCH_MS,
+  createSampleCursor,
+  takeNewSamples,
+  type MonitorMessage,
+} from "@/lib/monitor-channel";
+
+// Feeds the pop-out window from the device in scope: holds the raw stream
+// while the window is open and posts the new samples every batch interval.
+// The main window only copies the samples out of its ring buffers; the
+// graphs are drawn in the pop-out.
+export function MonitorPopoutFeed() {
+  const { port } = useMonitorPopout();
+  const { buffers, config, maxBufferSize, isReady, holdStreaming } = useDevice();
+  const { deviceIds, activeId } = useDeviceManager();
+  const title = deviceIds.length > 1 ? `Drum ${deviceIds.indexOf(activeId) + 1}` : "ITAIKO";
+
+  useEffect(() => {
+    if (!port || !isReady) return;
+    return holdStreaming();
+  }, [port, isReady, holdStreaming]);
+
+  useEffect(() => {
+    if (!port) return;
+    port.postMessage({ type: "reset", capacity: maxBufferSize, title } satisfies MonitorMessage);
+
+    const cursor = createSampleCursor();
+    const timer = setInterval(() => {
+      const batch = takeNewSamples(cursor, buffers.current);
+      if (!batch) return;
+      const message: MonitorMessage = { type: "samples", ...batch };
+      port.postMessage(message, [batch.data.buffer]);
+    }, MONITOR_BATCH_MS);
+
+    return () => clearInterval(timer);
+  }, [port, buffers, maxBufferSize, title]);
+
+  // Threshold lines follow the editor as values are dragged
+  useEffect(() => {
+    if (!port) return;
+    port.postMessage({
+      type: "thresholds",
+      thresholds: config.pads,
+      showHeavy: config.doubleInputMode,
+    } satisfies MonitorMessage);
+  }, [port, config.pads, config.doubleInputMode]);
+
+  return null;
+}
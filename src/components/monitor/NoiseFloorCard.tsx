@@ -0,0 +1,113 @@
+import { useEffect, useState } from "react";
+import { useDevice } from "@/context/DeviceContext";
+import { Button } from "@/components/ui/button";
+import { Card, CardContent, CardHeader, CardTitle } from "@/components/ui/card";
+import { RotateCcw, Save, Wand2, X } from "lucide-react";
+import { PAD_NAMES, PAD_LABELS } from "@/types";
+import { MIN_NOISE_SAMPLES } from "@/lib/noise-stats";
+
+interface NoiseFloorCardProps {
+  onClose: () => void;
+}
+
+const REFRESH_MS = 500;
+
+// Idle noise per pad from the running stream, with a light threshold that
+// keeps the loudest 0.1% of the noise below it
+export function NoiseFloorCard({ onClose }: NoiseFloorCardProps) {
+  const { getNoiseSummary, resetNoise, config, configDirty, isConnected, updatePadThreshold, saveToFlash } = useDevice();
+  const [summary, setSummary] = useState(getNoiseSummary);
+
+  useEffect(() => {
+    const timer = setInterval(() => setSummary(getNoiseSummary()), REFRESH_MS);
+    return () => clearInterval(timer);
+  }, [getNoiseSummary]);
+
+  const handleReset = () => {
+    resetNoise();
+    setSummary(getNoiseSummary());
+  };
+
+  // One undo step for all pads
+  const suggestedPads = PAD_NAMES.filter((pad) => summary[pad].suggestedLight !== null);
+  const handleApply = () => {
+    suggestedPads.forEach((pad, i) => {
+      updatePadThreshold(pad, "light", summary[pad].suggestedLight!, i === suggestedPads.length - 1);
+    });
+  };
+
+  const collected = Math.min(...PAD_NAMES.map((pad) => summary[pad].samples));
+
+  return (
+    <Card>
+      <CardHeader className="flex flex-row items-center justify-between space-y-0 pb-2">
+        <CardTitle className="text-base">Noise Floor</CardTitle>
+        <div className="flex gap-1">
+          <Button variant="ghost" size="sm" onClick={handleReset} title="Start measuring again">
+            <RotateCcw className="h-4 w-4 mr-2" />
+            Reset
+          </Button>
+          <Button variant="ghost" size="icon" className="h-8 w-8" onClick={onClose} title="Close">
+            <X className="h-4 w-4" />
+          </Button>
+        </div>
+      </CardHeader>
+      <CardContent className="space-y-3">
+        <p className="text-sm text-muted-foreground">
+          Leave the drum untouched while samples collect; hits and their decay are left out on every pad.
+          {collected < MIN_NOISE_SAMPLES && ` Suggestions after ${MIN_NOISE_SAMPLES.toLocaleString()} idle samples, about ${Math.round(MIN_NOISE_SAMPLES / 100)} s at the drum's 100 Hz.`}
+        </p>
+
+        <table className="w-full text-sm font-mono tabular-nums">
+          <thead>
+            <tr className="text-xs text-muted-foreground [&>th]:font-normal [&>th]:text-right [&>th:first-child]:text-left">
+              <th>Pad</th>
+              <th>Samples</th>
+              <th>Mean</th>
+              <th>σ</th>
+              <th>p99</th>
+              <th>p99.9</th>
+              <th>Peak</th>
+              <th>Light</th>
+              <th>Suggested</th>
+            </tr>
+          </thead>
+          <tbody>
+            {PAD_NAMES.map((pad) => {
+              const noise = summary[pad];
+              const light = config.pads[pad].light;
+              // Noise alone would trigger the pad
+              const tooLow = noise.samples > 0 && noise.p999 >= light;
+              return (
+                <tr key={pad} className="[&>td]:text-right [&>td:first-child]:text-left">
+                  <td className="font-sans">{PAD_LABELS[pad]}</td>
+                  <td>{noise.samples.toLocaleString()}</td>
+                  <td>{noise.mean.toFixed(1)}</td>
+                  <td>{noise.stdDev.toFixed(1)}</td>
+                  <td>{noise.p99}</td>
+                  <td>{noise.p999}</td>
+                  <td>{noise.peak}</td>
+                  <td className={tooLow ? "text-destructive font-semibold" : ""}>{light}</td>
+                  <td>{noise.suggestedLight ?? "–"}</td>
+                </tr>
+              );
+            })}
+          </tbody>
+        </table>
+
+        <div className="flex flex-wrap gap-2">
+          <Button variant="outline" onClick={handleApply} disabled={!isConnected || suggestedPads.length === 0}>
+            <Wand2 className="h-4 w-4 mr-2" />
+            Use suggested light thresholds
+          </Button>
+          {configDirty && (
+            <Button onClick={saveToFlash} disabled={!isConnected}>
+              <Save className="h-4 w-4 mr-2" />
+              Save to drum
+            </Button>
+          )}
+        </div>
+      </CardContent>
+    </Card>
+  );
+}
@@ -4,7 +4,9 @@ import { Card, CardContent, CardHeader, CardTitle } from "@/components/ui/card";
 import { Button } from "@/components/ui/button";
 import { RotateCcw } from "lucide-react";
 import type { PadName, PadBuffer } from "@/types";
-import { PAD_LABELS, PAD_COLORS } from "@/types";
+import { PAD_LABELS, PAD_COLORS, PAD_NAMES } from "@/types";
+import { downsamplePeak } from "@/lib/pad-buffer";
+import { perfEnabled, recordRender } from "@/lib/perf-metrics";
 
 interface PadGraphProps {
   pad: PadName;
@@ -34,6 +36,9 @@ function hexToRgba(hex: string, alpha: number = 1): ColorRGBA {
 const Y_AXIS_ZONE = 0.12;
 const X_AXIS_ZONE = 0.15;
 
+// Lost-connection gaps shown at once; markers are positioned by the render loop
+const MAX_GAP_MARKERS = 4;
+
 // Generate nice tick values
 function generateTicks(min: number, max: number, maxTicks: number): number[] {
   const range = max - min;
@@ -54,21 +59,6 @@ function generateTicks(min: number, max: number, maxTicks: number): number[] {
   return ticks;
 }
 
-// Helper to read from circular buffer at logical index
-function readFromCircularBuffer(
-  buffer: Float32Array,
-  head: number,
-  count: number,
-  capacity: number,
-  logicalIndex: number
-): number {
-  if (logicalIndex < 0 || logicalIndex >= count) return 0;
-  // Convert logical index (0 = oldest) to physical index
-  const startIdx = (head - count + capacity) % capacity;
-  const physicalIdx = (startIdx + logicalIndex) % capacity;
-  return buffer[physicalIdx];
-}
-
 export function PadGraph({
   pad,
   buffer,
@@ -83,6 +73,7 @@ export function PadGraph({
   const containerRef = useRef<HTMLDivElement>(null);
   const wglpRef = useRef<WebglPlot | null>(null);
   const deltaLineRef = useRef<WebglLine | null>(null);
+  const gapMarkersRef = useRef<(HTMLDivElement | null)[]>([]);
 
   // Zoom state
   const [isZoomed, setIsZoomed] = useState(false);
@@ -306,8 +297,11 @@ export function PadGraph({
   // SELF-DRIVING RENDER LOOP: Uses requestAnimationFrame instead of React state
   useEffect(() => {
     let animationId: number;
+    const peaks = new Float32Array(displayPoints);
+    const padIndex = PAD_NAMES.indexOf(pad);
 
     const renderFrame = () => {
+      const renderStart = perfEnabled ? performance.now() : 0;
       const deltaLine = deltaLineRef.current;
       const wglp = wglpRef.current;
 
@@ -329,56 +323,53 @@ export function PadGraph({
       const clampedEnd = Math.min(count, Math.ceil(viewEnd));
       const sourceCount = clampedEnd - clampedStart;
 
+      const markers = gapMarkersRef.current;
+      let markerCount = 0;
+
       // Safety check - clear lines if no data
       if (sourceCount <= 0 || displayPoints <= 0 || count === 0) {
         for (let i = 0; i < displayPoints; i++) {
           deltaLine.setX(i, -2);
         }
+        for (const marker of markers) if (marker) marker.style.display = "none";
         wglp.update();
         animationId = requestAnimationFrame(renderFrame);
         return;
       }
 
       const step = sourceCount / displayPoints;
+      downsamplePeak(delta, head, count, capacity, clampedStart, clampedEnd, peaks);
 
       // Direct write to WebGL buffer - ZERO allocation in this loop
       for (let i = 0; i < displayPoints; i++) {
-        // Calculate the range of data indices this pixel covers
-        const fStart = clampedStart + i * step;
-        const fEnd = clampedStart + (i + 1) * step;
-        
-        const iStart = Math.floor(fStart);
-        const iEnd = Math.floor(fEnd);
-
-        let val = 0;
-
-        // If the window falls within a single integer index (oversampling/zoomed in)
-        if (iStart === iEnd) {
-          val = readFromCircularBuffer(delta, head, count, capacity, iStart);
-        } else {
-          // Downsample by MAX (peak detection) across the range
-          let maxV = 0;
-          const loopEnd = Math.min(iEnd, clampedEnd);
-          
-          for (let j = iStart; j < loopEnd; j++) {
-            const v = readFromCircularBuffer(delta, head, count, capacity, j);
-            if (v > maxV) maxV = v;
-          }
-          val = maxV;
-        }
-
         const dataX = clampedStart + (i + 0.5) * step;
 
         // Transform to WebGL coordinates (-1 to 1)
         const relativeX = dataX - dataOffset;
         const webglX = (relativeX / numPoints) * 2 - 1;
-        const webglYDelta = (val / maxADC) * 2 - 1;
+        const isGap = Number.isNaN(peaks[i]);
+        const webglYDelta = isGap ? -1 : (peaks[i] / maxADC) * 2 - 1;
 
         deltaLine.setX(i, webglX);
         deltaLine.setY(i, webglYDelta);
+
+        // One marker at the start of each gap
+        if (isGap && (i === 0 || !Number.isNaN(peaks[i - 1])) && markerCount < MAX_GAP_MARKERS) {
+          const marker = markers[markerCount++];
+          if (marker) {
+            const screenX = webglX * wglp.gScaleX + wglp.gOffsetX;
+            marker.style.left = `${((screenX + 1) / 2) * 100}%`;
+            marker.style.display = "block";
+          }
+        }
+      }
+      for (let m = markerCount; m < markers.length; m++) {
+        const marker = markers[m];
+        if (marker) marker.style.display = "none";
       }
 
       wglp.update();
+      if (perfEnabled) recordRender(padIndex, performance.now() - renderStart);
       animationId = requestAnimationFrame(renderFrame);
     };
 
@@ -389,7 +380,7 @@ export function PadGraph({
     return () => {
       cancelAnimationFrame(animationId);
     };
-  }, [buffer, displayPoints, numPoints, maxADC]);
+  }, [pad, buffer, displayPoints, numPoints, maxADC]);
 
   // Calculate threshold line positions
   const lightPos = dataToScreenY(lightThreshold);
@@ -448,6 +439,18 @@ export function PadGraph({
 
               <canvas ref={canvasRef} className="absolute inset-0 w-full h-full" />
 
+              {/* Connection gaps */}
+              <div className="absolute inset-0 pointer-events-none overflow-hidden">
+                {Array.from({ length: MAX_GAP_MARKERS }, (_, i) => (
+                  <div
+                    key={i}
+                    ref={(el) => { gapMarkersRef.current[i] = el; }}
+                    className="absolute h-full border-l-2 border-dashed border-white/60"
+                    style={{ display: "none" }}
+                  />
+                ))}
+              </div>
+
               {/* Thresholds */}
               <div className="absolute inset-0 pointer-events-none overflow-hidden">
                 {lightPos >= 0 && lightPos <= 100 && <div className="absolute w-full border-t border-dashed border-yellow-500" style={{ bottom: `${lightPos}%` }} />}
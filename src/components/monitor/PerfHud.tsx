@@ -0,0 +1,102 @@
+import { useEffect, useState } from "react";
+import { useDevice } from "@/context/DeviceContext";
+import { Button } from "@/components/ui/button";
+import { Download, Trash2, X } from "lucide-react";
+import { PAD_NAMES, PAD_LABELS } from "@/types";
+import {
+  startPerfSampling,
+  stopPerfSampling,
+  clearPerfSamples,
+  subscribePerfSamples,
+  getLatestPerfSample,
+  createPerfReport,
+  type PerfSample,
+} from "@/lib/perf-metrics";
+
+interface PerfHudProps {
+  onClose: () => void;
+}
+
+function Metric({ label, value, warn = false }: { label: string; value: string; warn?: boolean }) {
+  return (
+    <>
+      <span className="text-muted-foreground">{label}</span>
+      <span className={`text-right tabular-nums ${warn ? "text-destructive font-semibold" : ""}`}>{value}</span>
+    </>
+  );
+}
+
+const fixed = (value: number, digits = 1) => value.toFixed(digits);
+
+export function PerfHud({ onClose }: PerfHudProps) {
+  const { streamingMode, maxBufferSize, config } = useDevice();
+  const [sample, setSample] = useState<PerfSample | null>(getLatestPerfSample);
+
+  // Sampling only runs while the HUD is open
+  useEffect(() => {
+    startPerfSampling();
+    const unsubscribe = subscribePerfSamples(() => setSample(getLatestPerfSample()));
+    return () => {
+      unsubscribe();
+      stopPerfSampling();
+    };
+  }, []);
+
+  const handleExport = () => {
+    const report = createPerfReport({
+      streamingMode,
+      bufferSize: maxBufferSize,
+      firmwareVersion: config.firmwareVersion ?? null,
+      url: window.location.href,
+    });
+    const blob = new Blob([JSON.stringify(report, null, 2)], {
+      type: "application/json",
+    });
+    const url = URL.createObjectURL(blob);
+    const a = document.createElement("a");
+    a.href = url;
+    a.download = `itaiko-perf-${new Date().toISOString().replace(/[:.]/g, "-")}.json`;
+    document.body.appendChild(a);
+    a.click();
+    document.body.removeChild(a);
+    URL.revokeObjectURL(url);
+  };
+
+  return (
+    <div className="fixed bottom-4 right-4 z-50 w-64 rounded-md border bg-background/90 p-3 text-xs font-mono shadow-lg backdrop-blur">
+      <div className="flex items-center justify-between mb-2">
+        <span className="font-semibold">Performance</span>
+        <div className="flex gap-1">
+          <Button variant="ghost" size="icon" className="h-6 w-6" onClick={handleExport} title="Export JSON">
+            <Download className="h-3 w-3" />
+          </Button>
+          <Button variant="ghost" size="icon" className="h-6 w-6" onClick={clearPerfSamples} title="Clear samples">
+            <Trash2 className="h-3 w-3" />
+          </Button>
+          <Button variant="ghost" size="icon" className="h-6 w-6" onClick={onClose} title="Close">
+            <X className="h-3 w-3" />
+          </Button>
+        </div>
+      </div>
+
+      {sample ? (
+        <div className="grid grid-cols-2 gap-x-3 gap-y-0.5">
+          <Metric label="lines/s" value={fixed(sample.linesPerSec, 0)} />
+          <Metric label="bytes/s" value={fixed(sample.bytesPerSec, 0)} />
+          <Metric label="parse/batch" value={`${fixed(sample.parseMsAvg, 2)} ms`} />
+          <Metric label="parse max" value={`${fixed(sample.parseMsMax, 2)} ms`} warn={sample.parseMsMax > 8} />
+          <Metric label="queue depth" value={fixed(sample.queueDepth, 0)} warn={sample.queueDepth > 500} />
+          <Metric label="fps" value={fixed(sample.fps, 0)} />
+          <Metric label="dropped frames" value={fixed(sample.droppedFrames, 0)} warn={sample.droppedFrames > 0} />
+          {PAD_NAMES.map((pad) => (
+            <Metric key={pad} label={`render ${PAD_LABELS[pad]}`} value={`${fixed(sample.renderMs[pad], 2)} ms`} />
+          ))}
+          <Metric label="long tasks" value={`${sample.longTasks} (${fixed(sample.longTaskMs, 0)} ms)`} warn={sample.longTasks > 0} />
+          <Metric label="JS heap" value={sample.heapMB === null ? "n/a" : `${fixed(sample.heapMB)} MB`} />
+        </div>
+      ) : (
+        <p className="text-muted-foreground">Collecting…</p>
+      )}
+    </div>
+  );
+}
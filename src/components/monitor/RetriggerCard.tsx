@@ -0,0 +1,175 @@
+import { useState } from "react";
+import { useDevice } from "@/context/DeviceContext";
+import { useStreamAnalysis } from "@/hooks/useStreamAnalysis";
+import { useAnalysisSource, type AnalysisOutcome } from "@/hooks/useAnalysisSource";
+import { AnalysisSourceControls } from "./AnalysisSourceControls";
+import { Button } from "@/components/ui/button";
+import { Card, CardContent, CardHeader, CardTitle } from "@/components/ui/card";
+import { Label } from "@/components/ui/label";
+import { NumberInput } from "@/components/ui/numberinput";
+import { X } from "lucide-react";
+import { PAD_NAMES, PAD_LABELS } from "@/types";
+import { DEFAULT_RETRIGGER_WINDOW_MS, RETRIGGER_BIN_MS, type RetriggerResult } from "@/lib/retrigger";
+
+interface RetriggerCardProps {
+  onClose: () => void;
+}
+
+const WINDOW_MIN_MS = 10;
+const WINDOW_MAX_MS = 500;
+
+const formatMs = (ms: number | null) => (ms === null ? "–" : `${Math.round(ms)}`);
+
+function IntervalBars({ histogram }: { histogram: number[] }) {
+  const largest = Math.max(1, ...histogram);
+  return (
+    <div className="flex items-end gap-px h-6 w-32">
+      {histogram.map((count, i) => (
+        <div
+          key={i}
+          className="flex-1 rounded-sm bg-primary/70"
+          style={{ height: `${(count / largest) * 100}%`, minHeight: count > 0 ? 2 : 0 }}
+          title={`${i * RETRIGGER_BIN_MS}-${(i + 1) * RETRIGGER_BIN_MS} ms: ${count}`}
+        />
+      ))}
+    </div>
+  );
+}
+
+// Same-pad retriggers over the graph buffer or a recorded session, and the
+// smallest Debounce Delay that removes them
+export function RetriggerCard({ onClose }: RetriggerCardProps) {
+  const { buffers, config, linkHealth, isConnected, updateTiming } = useDevice();
+  const analyze = useStreamAnalysis();
+  const source = useAnalysisSource(buffers, linkHealth.lineRate);
+  const [windowMs, setWindowMs] = useState(DEFAULT_RETRIGGER_WINDOW_MS);
+  // Tagged with the source revision it ran on, so another source hides it
+  const [outcome, setOutcome] = useState<AnalysisOutcome<RetriggerResult> | null>(null);
+  const [isRunning, setIsRunning] = useState(false);
+  const current = outcome?.revision === source.revision ? outcome : null;
+  const result = current?.result ?? null;
+  const error = current?.error ?? null;
+
+  const handleAnalyze = async () => {
+    const input = source.getFrames();
+    if (!input) return;
+    const revision = source.revision;
+    setIsRunning(true);
+    setOutcome((prev) => prev && { ...prev, error: null });
+    try {
+      const next = await analyze("retrigger", {
+        ...input,
+        windowMs,
+        light: {
+          kaLeft: config.pads.kaLeft.light,
+          donLeft: config.pads.donLeft.light,
+          donRight: config.pads.donRight.light,
+          kaRight: config.pads.kaRight.light,
+        },
+      });
+      setOutcome({ revision, result: next, error: null });
+    } catch (err) {
+      setOutcome({ revision, result: null, error: err instanceof Error ? err.message : String(err) });
+    } finally {
+      setIsRunning(false);
+    }
+  };
+
+  const current = config.timing.individualDebounce;
+  const hasInput = result !== null && result.pads.kaLeft.ghostNotes !== null;
+
+  return (
+    <Card>
+      <CardHeader className="flex flex-row items-center justify-between space-y-0 pb-2">
+        <CardTitle className="text-base">Retriggers</CardTitle>
+        <Button variant="ghost" size="icon" className="h-8 w-8" onClick={onClose} title="Close">
+          <X className="h-4 w-4" />
+        </Button>
+      </CardHeader>
+      <CardContent className="space-y-4">
+        <AnalysisSourceControls source={source} onAnalyze={handleAnalyze} isRunning={isRunning} />
+        <div className="flex items-center gap-2">
+          <Label className="text-sm font-normal">Look for retriggers up to</Label>
+          <NumberInput
+            value={windowMs}
+            onValueChange={(v) => v !== undefined && setWindowMs(v)}
+            className="w-28"
+            min={WINDOW_MIN_MS}
+            max={WINDOW_MAX_MS}
+            suffix=" ms"
+          />
+          <span className="text-sm text-muted-foreground">after a hit</span>
+        </div>
+
+        {error && <p className="text-sm text-destructive">{error}</p>}
+
+        {result && (
+          <>
+            <p className="text-sm text-muted-foreground">
+              {result.samples.toLocaleString()} samples at {(1000 / result.sampleIntervalMs).toFixed(0)} Hz
+              {hasInput ? ", with the input stream" : "; record both streams to see which retriggers became key presses"}
+              {" "}({Math.round(result.elapsedMs)} ms)
+            </p>
+
+            <table className="w-full text-sm font-mono tabular-nums">
+              <thead>
+                <tr className="text-xs text-muted-foreground [&>th]:font-normal [&>th]:text-right [&>th:first-child]:text-left">
+                  <th>Pad</th>
+                  <th>Hits</th>
+                  <th>Retriggers</th>
+                  {hasInput && <th>Ghost notes</th>}
+                  <th>Latest ms</th>
+                  <th>Fastest hit ms</th>
+                  <th className="!text-left pl-4">Interval ({RETRIGGER_BIN_MS} ms bins)</th>
+                </tr>
+              </thead>
+              <tbody>
+                {PAD_NAMES.map((pad) => {
+                  const stats = result.pads[pad];
+                  return (
+                    <tr key={pad} className="[&>td]:text-right [&>td:first-child]:text-left">
+                      <td className="font-sans">{PAD_LABELS[pad]}</td>
+                      <td>{stats.hits}</td>
+                      <td>{stats.retriggers}</td>
+                      {hasInput && <td className={stats.ghostNotes ? "text-amber-600" : ""}>{stats.ghostNotes}</td>}
+                      <td>{formatMs(stats.maxIntervalMs)}</td>
+                      <td>{formatMs(stats.fastestHitMs)}</td>
+                      <td className="!text-left pl-4"><IntervalBars histogram={stats.histogram} /></td>
+                    </tr>
+                  );
+                })}
+              </tbody>
+            </table>
+
+            <div className="flex flex-wrap items-center gap-3 rounded-md border p-3 text-sm">
+              {result.recommendedDebounceMs > 0 ? (
+                <span>
+                  Debounce Delay needed: <span className="font-mono font-semibold">{result.recommendedDebounceMs} ms</span>
+                  <span className="text-muted-foreground"> (now {current} ms)</span>
+                </span>
+              ) : (
+                <span>No retriggers within {result.windowMs} ms of a hit.</span>
+              )}
+              {result.recommendedDebounceMs > 0 && (
+                <Button
+                  size="sm"
+                  variant="outline"
+                  className="ml-auto"
+                  onClick={() => updateTiming("individualDebounce", result.recommendedDebounceMs)}
+                  disabled={!isConnected || result.recommendedDebounceMs === current}
+                >
+                  Apply
+                </Button>
+              )}
+              {result.lostHits > 0 && (
+                <p className="w-full text-amber-600">
+                  {result.lostHits} hits in this session followed the previous one on the same pad sooner than that and would be dropped.
+                </p>
+              )}
+            </div>
+          </>
+        )}
+      </CardContent>
+    </Card>
+  );
+}
@@ -32,36 +32,50 @@ export function getHelp(key: string): HelpContent | undefined {
   return helpRegistry[key];
 }
 
+// The help texts are a chunk of their own, registered on first use
+let helpContentLoad: Promise<void> | null = null;
+
+export function loadHelpContent(): Promise<void> {
+  helpContentLoad ??= import("@/lib/help-content").then((module) => module.initializeHelpContent());
+  return helpContentLoad;
+}
+
 export function HelpButton({ helpKey, className }: HelpButtonProps) {
   const [open, setOpen] = useState(false);
-  const help = getHelp(helpKey);
+  const [help, setHelp] = useState(() => getHelp(helpKey));
 
-  if (!help) {
-    console.warn(`No help content registered for key: ${helpKey}`);
-    return null;
-  }
+  const handleOpenChange = (next: boolean) => {
+    setOpen(next);
+    if (next && !help) {
+      loadHelpContent().then(() => {
+        const loaded = getHelp(helpKey);
+        if (!loaded) console.warn(`No help content registered for key: ${helpKey}`);
+        setHelp(loaded);
+      });
+    }
+  };
 
   return (
-    <Dialog open={open} onOpenChange={setOpen}>
+    <Dialog open={open} onOpenChange={handleOpenChange}>
       <DialogTrigger asChild>
         <Button
           variant="ghost"
           size="icon"
           className={`h-6 w-6 rounded-full text-muted-foreground hover:text-foreground ${className}`}
-          title={`Help: ${help.title}`}
+          title={help ? `Help: ${help.title}` : "Help"}
         >
           <HelpCircle className="h-4 w-4" />
         </Button>
       </DialogTrigger>
       <DialogContent className="sm:max-w-[500px] max-h-[80vh] overflow-y-auto">
         <DialogHeader>
-          <DialogTitle>{help.title}</DialogTitle>
-          {help.description && (
+          <DialogTitle>{help?.title ?? "Help"}</DialogTitle>
+          {help?.description && (
             <DialogDescription>{help.description}</DialogDescription>
           )}
         </DialogHeader>
         <div className="py-4 prose prose-sm dark:prose-invert max-w-none">
-          {help.content}
+          {help ? help.content : <p className="text-muted-foreground">Loading…</p>}
         </div>
       </DialogContent>
     </Dialog>
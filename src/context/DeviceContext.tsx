@@ -1,10 +1,42 @@
 import { createContext, useContext, useMemo, useEffect, useRef, useState } from "react";
-import type { ReactNode, RefObject } from "react";
-import { useWebSerial } from "@/hooks/useWebSerial";
+import type { RefObject } from "react";
+import type { UseWebSerialReturn } from "@/hooks/useWebSerial";
 import { useDeviceConfig } from "@/hooks/useDeviceConfig";
 import { useDeviceStreaming, type TriggerState, type StreamingMode } from "@/hooks/useDeviceStreaming";
 import { useKeyboardInput } from "@/hooks/useKeyboardInput";
+import { useLinkHealth } from "@/hooks/useLinkHealth";
 import { useFirmwareUpdate, type FirmwareInfo, type UpdateStatus } from "@/hooks/useFirmwareUpdate";
+import { uploadBootScreenData, type BootScreenUploadOutcome } from "@/lib/boot-screen-upload";
+import { hashBitmap } from "@/lib/boot-screen-gallery";
+import { getDeviceKey, getConfigFingerprint } from "@/lib/device-identity";
+import { waitForSerialDevice, startPhase } from "@/lib/device-readiness";
+import {
+  saveConfigSnapshot,
+  getPendingConfigSnapshot,
+  listOrphanedConfigSnapshots,
+  markConfigSnapshotRestored,
+  migrateSettings,
+  diffSettings,
+  type ConfigSnapshot,
+} from "@/lib/config-snapshot";
+import {
+  profileToSettings,
+  validateSettings,
+  type ConfigProfile,
+  type ProfileApplyResult,
+} from "@/lib/config-profile";
+import {
+  getCachedConfig,
+  cacheConfig,
+  changedConfigFields,
+  mergeConfigFields,
+  type ConfigConflict,
+  type ConfigSource,
+} from "@/lib/config-cache";
+import { settingsToConfig, configToSettings } from "@/lib/serial-protocol";
+import type { LinkHealthSummary } from "@/lib/link-health";
+import type { PadNoiseSummary } from "@/lib/noise-stats";
+import { toast } from "sonner";
 import {
   DeviceCommand,
   type ConnectionStatus,
@@ -17,13 +49,15 @@ import {
   type ADCChannels,
 } from "@/types";
 
-interface DeviceContextValue {
+export interface DeviceContextValue {
   // Connection
   status: ConnectionStatus;
   error: string | null;
   isSupported: boolean;
   isConnected: boolean;
   isReady: boolean;  // True after initial config read completes
+  linkHealth: LinkHealthSummary;
+  ownsPort: boolean;  // False when the port is shared from another tab
   hasAuthorizedDevice: boolean;
   requestPort: () => Promise<SerialPort | null>;
   connect: () => Promise<boolean>;
@@ -33,6 +67,11 @@ interface DeviceContextValue {
   config: DeviceConfig;
   configLoading: boolean;
   configDirty: boolean;
+  configSource: ConfigSource;
+  // The live read disagrees with cached settings that were already edited
+  configConflict: ConfigConflict | null;
+  resolveConfigConflict: (keep: "device" | "edits") => void;
+  flashedFields: ReadonlySet<string>;  // Paths the live read just changed
   readFromDevice: () => Promise<boolean>;
   writeToDevice: () => Promise<boolean>;
   saveToFlash: () => Promise<boolean>;
@@ -49,8 +88,9 @@ interface DeviceContextValue {
   exportConfig: () => void;
   importConfig: (file: File) => Promise<boolean>;
   rebootToBootsel: () => Promise<void>;
-  uploadBootScreen: (data: Uint8Array) => Promise<boolean>;
+  uploadBootScreen: (data: Uint8Array, options?: { force?: boolean }) => Promise<BootScreenUploadOutcome>;
   clearBootScreen: () => Promise<boolean>;
+  applyProfile: (profile: ConfigProfile) => Promise<ProfileApplyResult>;
 
   // Streaming
   isStreaming: boolean;
@@ -60,15 +100,24 @@ interface DeviceContextValue {
   startStreaming: (mode?: StreamingMode) => Promise<void>;
   stopStreaming: () => Promise<void>;
   clearData: () => void;
+  holdStreaming: () => () => void;
+  getNoiseSummary: () => Record<PadName, PadNoiseSummary>;
+  resetNoise: () => void;
   maxBufferSize: number;
   setMaxBufferSize: (size: number) => void;
 
   // Firmware Update
   firmwareUpdate: {
     status: UpdateStatus;
-    latestFirmware: FirmwareInfo | null;
+    latestFirmware: FirmwareInfo | null;  // Release the update installs
+    releases: FirmwareInfo[];
+    manifestOffline: boolean;
+    pinnedVersion: string | null;
+    setPinnedVersion: (version: string | null) => void;
+    selectVersion: (version: string | null) => void;
     error: string | null;
     progress: number;
+    bytesWritten: number;
     checkUpdate: () => Promise<void>;
     installUpdate: () => Promise<void>;
     modalOpen: boolean;
@@ -76,14 +125,27 @@ interface DeviceContextValue {
   };
 }
 
-const DeviceContext = createContext<DeviceContextValue | null>(null);
+const RECONNECT_TIMEOUT_MS = 120000;
+
+type SettingsRead = { settings: Map<number, number>; version?: string };
+
+export const DeviceContext = createContext<DeviceContextValue | null>(null);
+
+const NO_FIELDS: ReadonlySet<string> = new Set();
+const FLASH_MS = 1500;
 
-interface DeviceProviderProps {
-  children: ReactNode;
+interface DeviceSessionOptions {
+  // This tab's port, or the tab that owns it (see serial-share)
+  serial: UseWebSerialReturn;
+  // The owning tab runs the heartbeat; a follower's replies would be the
+  // owner's, delayed by the line batching
+  ownsPort: boolean;
 }
 
-export function DeviceProvider({ children }: DeviceProviderProps) {
-  const serial = useWebSerial();
+// One connected drum: transport, config state, streaming buffers and update
+// flow. The device manager runs one session per port and provides the active
+// one through DeviceContext.
+export function useDeviceSession({ serial, ownsPort }: DeviceSessionOptions): DeviceContextValue {
   const [isReady, setIsReady] = useState(false);
   const [modalOpen, setModalOpen] = useState(false);
 
@@ -91,7 +153,7 @@ export function DeviceProvider({ children }: DeviceProviderProps) {
 
   const deviceConfig = useDeviceConfig({
     sendCommand: serial.sendCommand,
-    readUntilTimeout: serial.readUntilTimeout,
+    waitForLine: serial.waitForLine,
     clearBuffer: serial.clearBuffer,
     isConnected,
   });
@@ -101,10 +163,19 @@ export function DeviceProvider({ children }: DeviceProviderProps) {
     startReading: serial.startReading,
     stopReading: serial.stopReading,
     isConnected,
+    isReconnecting: serial.status === "reconnecting",
   });
 
   const keyboardTriggers = useKeyboardInput(deviceConfig.config);
 
+  const linkHealth = useLinkHealth({
+    probeLatency: deviceConfig.probeLatency,
+    addLineListener: serial.addLineListener,
+    isReady,
+    isStreaming: streaming.isStreaming,
+    heartbeat: ownsPort,
+  });
+
   const triggers = useMemo(() => ({
     kaLeft: streaming.triggers.kaLeft || keyboardTriggers.kaLeft,
     donLeft: streaming.triggers.donLeft || keyboardTriggers.donLeft,
@@ -114,6 +185,234 @@ export function DeviceProvider({ children }: DeviceProviderProps) {
 
   const firmwareUpdate = useFirmwareUpdate(deviceConfig.config.firmwareVersion);
 
+  const [configSource, setConfigSource] = useState<ConfigSource>("none");
+  const [configConflict, setConfigConflict] = useState<ConfigConflict | null>(null);
+  const [flashedFields, setFlashedFields] = useState<ReadonlySet<string>>(NO_FIELDS);
+
+  // Read by the background revalidation and the profile rollout, which
+  // outlive the render they started in
+  const configDirtyRef = useRef(false);
+  useEffect(() => {
+    configDirtyRef.current = deviceConfig.isDirty;
+  });
+
+  // Id of the settings snapshot taken when this session started a firmware
+  // update. Same-model drums share a device key, so only the id ties the
+  // snapshot to this drum.
+  const updateSnapshotRef = useRef<string | null>(null);
+
+  // Stores the device's settings so they can be put back after the update
+  const snapshotSettings = async () => {
+    const deviceKey = getDeviceKey(serial.port.current);
+    const current = await deviceConfig.readSettings();
+    if (!deviceKey || !current) throw new Error("Could not back up the device settings");
+    updateSnapshotRef.current = await saveConfigSnapshot(deviceKey, current.settings, current.version);
+    console.log(`[update] settings snapshot: ${current.settings.size} keys from v${current.version ?? "?"}`);
+  };
+
+  // Writes the keys of `desired` that differ from `current`, saves once and
+  // reads back. `mismatched` lists keys the read-back doesn't match.
+  const writeVerified = async (desired: Map<number, number>, current: SettingsRead) => {
+    const changes = diffSettings(desired, current.settings);
+    if (changes.size === 0) return { changed: 0, mismatched: [] as number[], readBack: current };
+
+    const written = await deviceConfig.writeSettings(changes);
+    if (written) await serial.sendCommand(DeviceCommand.SAVE_TO_FLASH);
+    const readBack = await deviceConfig.readSettings();
+    const mismatched = readBack ? [...diffSettings(desired, readBack.settings).keys()] : [...changes.keys()];
+    return { changed: changes.size, mismatched, readBack };
+  };
+
+  // Applies a snapshot taken before an update: migrate it to the keys the new
+  // firmware reports, write only what differs, save once and read back to
+  // verify. Resolves true if it loaded the settings into the editor.
+  const restoreSnapshot = async (snapshot: ConfigSnapshot): Promise<boolean> => {
+    const phase = startPhase("update", "settings restore");
+    const current = await deviceConfig.readSettings();
+    if (!current) {
+      phase.end("read failed");
+      return false;
+    }
+
+    const desired = migrateSettings(snapshot, current.settings);
+    const { changed, mismatched, readBack } = await writeVerified(desired, current);
+    if (!readBack || mismatched.length > 0) {
+      phase.end(`verify failed, ${mismatched.length} keys differ`);
+      toast.error("Settings could not be restored after the update. Check them before saving.");
+      if (readBack) deviceConfig.applySettings(readBack.settings, readBack.version);
+      return readBack !== null;
+    }
+
+    await markConfigSnapshotRestored(snapshot.id).catch(console.warn);
+    deviceConfig.applySettings(readBack.settings, readBack.version);
+    phase.end(`${changed} keys written`);
+    toast.success(
+      changed > 0
+        ? `Restored ${changed} setting${changed === 1 ? "" : "s"} after the update`
+        : "Settings kept by the update"
+    );
+    return true;
+  };
+
+  // The snapshot this session took before its update, if any
+  const restorePendingSnapshot = async (): Promise<boolean> => {
+    const id = updateSnapshotRef.current;
+    if (!id) return false;
+    updateSnapshotRef.current = null;
+    const snapshot = await getPendingConfigSnapshot(id).catch(() => null);
+    return snapshot ? restoreSnapshot(snapshot) : false;
+  };
+
+  // A snapshot of this model that no session here took: the update started
+  // before a page reload. It may be another drum's, so the user decides.
+  const offerOrphanedSnapshot = async (deviceKey: string) => {
+    const [snapshot] = await listOrphanedConfigSnapshots(deviceKey).catch(() => []);
+    if (!snapshot) return;
+    const takenAt = new Date(snapshot.takenAt).toLocaleTimeString([], { hour: "2-digit", minute: "2-digit" });
+    toast("Settings from before a firmware update were not restored", {
+      description: `Taken at ${takenAt}${snapshot.firmwareVersion ? ` on v${snapshot.firmwareVersion}` : ""}, possibly from another drum of this model.`,
+      id: `config-snapshot-${snapshot.id}`,
+      duration: Infinity,
+      action: {
+        label: "Restore",
+        onClick: () => {
+          // The toast outlives this render: restore with the current state
+          const { withStreamingStopped, restoreSnapshot } = latestRef.current;
+          withStreamingStopped(() => restoreSnapshot(snapshot))
+            .then((loaded) => loaded && setConfigSource("device"))
+            .catch(console.warn);
+        },
+      },
+    });
+  };
+
+  // Stream lines would be taken for settings responses
+  const withStreamingStopped = async <T,>(fn: () => Promise<T>): Promise<T> => {
+    const resume = await streaming.pauseStreaming();
+    try {
+      return await fn();
+    } finally {
+      resume().catch(console.warn);
+    }
+  };
+
+  // For callbacks that outlive the render they were created in
+  const latestRef = useRef({ withStreamingStopped, restoreSnapshot });
+  useEffect(() => {
+    latestRef.current = { withStreamingStopped, restoreSnapshot };
+  });
+
+  // Applies a saved profile for the fleet rollout: the same write, save and
+  // read-back as the snapshot restore, plus a schema check of what the
+  // device reports afterwards
+  const applyProfile = async (profile: ConfigProfile): Promise<ProfileApplyResult> => {
+    const start = performance.now();
+    const fail = (error: string, changed = 0): ProfileApplyResult =>
+      ({ ok: false, changed, mismatched: [], invalid: [], error, durationMs: performance.now() - start });
+    if (!isConnected) return fail("Not connected");
+
+    try {
+      return await withStreamingStopped(async () => {
+        const current = await deviceConfig.readSettings();
+        if (!current) return fail("Could not read the settings");
+
+        const { changed, mismatched, readBack } = await writeVerified(profileToSettings(profile, current.settings), current);
+        if (!readBack) return fail("Could not read the settings back", changed);
+        if (configDirtyRef.current) {
+          // Unsaved edits stay; the user picks them or the profile, as after a
+          // live read that disagrees with them
+          const before = settingsToConfig(current.settings, current.version);
+          const after = settingsToConfig(readBack.settings, readBack.version);
+          const fields = changedConfigFields(before, after);
+          if (fields.length > 0) setConfigConflict({ cached: before, device: after, fields });
+        } else {
+          deviceConfig.applySettings(readBack.settings, readBack.version);
+        }
+
+        const invalid = validateSettings(readBack.settings);
+        return {
+          ok: mismatched.length === 0 && invalid.length === 0,
+          changed,
+          mismatched,
+          invalid,
+          durationMs: performance.now() - start,
+        };
+      });
+    } catch (e) {
+      return fail(e instanceof Error ? e.message : String(e));
+    }
+  };
+
+  useEffect(() => {
+    if (flashedFields.size === 0) return;
+    const timer = setTimeout(() => setFlashedFields(NO_FIELDS), FLASH_MS);
+    return () => clearTimeout(timer);
+  }, [flashedFields]);
+
+  // Shows the settings cached for this drum model right away, then reads the
+  // device and reconciles: unedited settings are replaced (the changed fields
+  // flash), edited ones raise a conflict instead of being overwritten. Edits
+  // still in the editor (a reconnect) are never replaced by the cache.
+  const loadConfig = async () => {
+    const deviceKey = getDeviceKey(serial.port.current);
+    const cached = deviceKey ? await getCachedConfig(deviceKey).catch(() => null) : null;
+    const shown = cached && !configDirtyRef.current ? settingsToConfig(new Map(cached.settings), cached.version) : null;
+    if (cached && shown) {
+      deviceConfig.applySettings(new Map(cached.settings), cached.version);
+      setConfigSource("cache");
+    }
+
+    // After a firmware update the settings snapshot is restored first; that
+    // read also fills the editor
+    if (await restorePendingSnapshot()) {
+      setConfigSource("device");
+      return;
+    }
+
+    const live = await deviceConfig.readSettings();
+    if (!live) {
+      if (shown) toast.warning("Could not read the drum's settings, showing the last known ones");
+      return;
+    }
+    setConfigSource("device");
+    if (deviceKey) {
+      cacheConfig(deviceKey, live.settings, live.version).catch(console.warn);
+      offerOrphanedSnapshot(deviceKey);
+    }
+
+    const liveConfig = settingsToConfig(live.settings, live.version);
+    const fields = shown ? changedConfigFields(shown, liveConfig) : [];
+    if (shown && fields.length > 0 && configDirtyRef.current) {
+      setConfigConflict({ cached: shown, device: liveConfig, fields });
+      return;
+    }
+    if (!configDirtyRef.current) deviceConfig.applySettings(live.settings, live.version);
+    if (fields.length > 0) setFlashedFields(new Set(fields));
+  };
+
+  const resolveConfigConflict = (keep: "device" | "edits") => {
+    if (!configConflict) return;
+    const { cached, device, fields } = configConflict;
+    if (keep === "device") {
+      deviceConfig.applyEdits(device, device);
+      setFlashedFields(new Set(fields));
+    } else {
+      // Only what was edited goes on top of the device's settings
+      const edited = changedConfigFields(cached, deviceConfig.config);
+      deviceConfig.applyEdits(device, mergeConfigFields(device, deviceConfig.config, edited));
+    }
+    setConfigConflict(null);
+  };
+
+  const saveToFlash = async () => {
+    const saved = await deviceConfig.saveToFlash();
+    const deviceKey = getDeviceKey(serial.port.current);
+    if (saved && deviceKey) {
+      cacheConfig(deviceKey, configToSettings(deviceConfig.config), deviceConfig.config.firmwareVersion).catch(console.warn);
+    }
+    return saved;
+  };
+
   // Track previous connection state to detect new connections
   const wasConnectedRef = useRef(false);
 
@@ -124,19 +423,22 @@ export function DeviceProvider({ children }: DeviceProviderProps) {
       setIsReady(false);
 
       // Safety: Force stop streaming in case it was left running from a previous session
-      // We don't await this because we want to start reading config ASAP, and the stop command
-      // will be processed by the device before the read command in the serial queue.
+      // We don't await this because we want to start reading config ASAP; the write queue
+      // sends the stop command before the read command.
       serial.sendCommand(DeviceCommand.STOP_STREAMING).catch(console.warn);
       
-      deviceConfig.readFromDevice().then(() => {
-        setIsReady(true);
-      });
+      // After a dropped connection the stream picks up where it was
+      loadConfig()
+        .then(streaming.resumeStreaming)
+        .finally(() => setIsReady(true));
     } else if (!isConnected) {
       // Disconnected
       setIsReady(false);
+      setConfigSource("none");
+      setConfigConflict(null);
     }
     wasConnectedRef.current = isConnected;
-  }, [isConnected, deviceConfig.readFromDevice]);
+  }, [isConnected, deviceConfig.readSettings]);
 
   const rebootToBootsel = async () => {
     if (isConnected) {
@@ -152,49 +454,57 @@ export function DeviceProvider({ children }: DeviceProviderProps) {
     }
   };
 
-  const uploadBootScreen = async (data: Uint8Array): Promise<boolean> => {
-    if (!isConnected) return false;
+  // Last boot screen written through this session and the port it went to.
+  // Same-model drums share a device key, so only the live port tells that
+  // this drum already has it.
+  const bootScreenRef = useRef<{ port: SerialPort; hash: string; configFingerprint: string } | null>(null);
+
+  // Skips the flash write when this port was last given the same bitmap and
+  // the settings the drum reports haven't changed since (same firmware and
+  // settings). `force` uploads regardless.
+  const uploadBootScreen = async (
+    data: Uint8Array,
+    { force = false }: { force?: boolean } = {}
+  ): Promise<BootScreenUploadOutcome> => {
+    if (!isConnected) return "failed";
+
     let previousMode: StreamingMode = 'none';
     try {
-      // 0. Ensure streaming is stopped to prevent buffer pollution
+      // 0. Stop streaming; leftover stream lines are skipped while waiting for replies
       if (streaming.isStreaming) {
          previousMode = streaming.streamingMode;
          await streaming.stopStreaming();
-         // Wait for streaming to actually stop and buffer to clear
-         await new Promise(r => setTimeout(r, 200));
       }
 
-      // 1. Start upload
-      serial.clearBuffer();
-      await serial.sendCommand(DeviceCommand.BOOT_SCREEN_START);
-      
-      // Give device a moment to enter upload mode
-      await new Promise(r => setTimeout(r, 200));
-
-      // 2. Send binary data in chunks of 64 bytes (USB CDC packet size)
-      const CHUNK_SIZE = 64;
-      for (let i = 0; i < data.length; i += CHUNK_SIZE) {
-        const chunk = data.slice(i, i + CHUNK_SIZE);
-        await serial.sendBinary(chunk);
-        // Small delay between chunks to prevent buffer overflow on device
-        await new Promise(r => setTimeout(r, 10));
+      // Fingerprint what the drum reports, not the editor, which may hold
+      // unsaved edits
+      const hash = await hashBitmap(data).catch(() => null);
+      const current = await deviceConfig.readSettings();
+      const configFingerprint = current ? getConfigFingerprint(settingsToConfig(current.settings, current.version)) : null;
+      const port = serial.port.current;
+      const last = bootScreenRef.current;
+      if (!force && hash && configFingerprint && last?.port === port &&
+          last.hash === hash && last.configFingerprint === configFingerprint) {
+        console.log("Boot screen unchanged, skipping upload");
+        return "skipped";
       }
-      
-      // 3. Wait for save confirmation (Flash write takes time)
-      const fullResponse = await serial.readUntilTimeout(5000); // Increased timeout to 5s
-      const lines = fullResponse.split('\n');
-      const savedSuccessfully = lines.some(line => line.includes("BITMAP_SAVED"));
 
-      if (savedSuccessfully) {
-        return true;
+      // Runs exclusively so no other command lands inside the image data
+      serial.clearBuffer();
+      const result = await serial.exclusive((io) => uploadBootScreenData(io, serial.waitForLine, data));
+
+      if (result.ok) {
+        console.log(`Boot screen saved (${result.savedBytes} bytes) in ${Math.round(result.durationMs)} ms`);
+        bootScreenRef.current = port && hash && configFingerprint ? { port, hash, configFingerprint } : null;
+        return "uploaded";
       }
-      
-      console.error("Bitmap save failed or timed out. Full response:", fullResponse);
-      return false;
+
+      console.error("Bitmap upload failed:", result.error);
+      return "failed";
 
     } catch (e) {
       console.error("Error uploading boot screen:", e);
-      return false;
+      return "failed";
     } finally {
         // Always restart streaming after the operation finishes
         if (previousMode !== 'none') {
@@ -209,7 +519,9 @@ export function DeviceProvider({ children }: DeviceProviderProps) {
       serial.clearBuffer();
       await serial.sendCommand(DeviceCommand.BOOT_SCREEN_CLEAR);
       const response = await serial.readUntilTimeout(1000);
-      return response.includes("BITMAP_CLEARED");
+      const cleared = response.includes("BITMAP_CLEARED");
+      if (cleared) bootScreenRef.current = null;
+      return cleared;
     } catch (e) {
       console.error("Error clearing boot screen:", e);
       return false;
@@ -217,36 +529,24 @@ export function DeviceProvider({ children }: DeviceProviderProps) {
   };
   
   const handleInstallUpdate = async () => {
-    await firmwareUpdate.installUpdate(rebootToBootsel);
-    
-    // Auto-reconnect logic
+    const handedOver = await firmwareUpdate.installUpdate(async () => {
+      await snapshotSettings();
+      await rebootToBootsel();
+    });
+    if (!handedOver) return;
+
+    // The device manager hands the flashed device back to this session as
+    // soon as it shows up again as a serial port. A manual copy can take a
+    // while, hence the long upper bound.
     console.log("Update process finished. Waiting for device reboot...");
-    
-    // Poll for the device for up to 20 seconds
-    const pollInterval = 1000;
-    const maxAttempts = 20;
-    let attempts = 0;
-
-    const pollForDevice = async () => {
-      attempts++;
-      console.log(`Searching for device (Attempt ${attempts}/${maxAttempts})...`);
-      
-      const port = await serial.findAuthorizedPort();
-      if (port) {
-        console.log("Device found! Connecting...");
-        await serial.connect();
-        return;
-      }
-
-      if (attempts < maxAttempts) {
-        setTimeout(pollForDevice, pollInterval);
-      } else {
-        console.log("Device not found after reboot.");
-      }
-    };
-
-    // Start polling after a short delay to allow reboot to start
-    setTimeout(pollForDevice, 2000);
+    const phase = startPhase("update", "reboot into firmware");
+    const port = await waitForSerialDevice(RECONNECT_TIMEOUT_MS);
+    if (!port) {
+      phase.end("timed out");
+      console.log("Device not found after reboot.");
+      return;
+    }
+    phase.end("port connected");
   };
 
   const handleDisconnect = async () => {
@@ -256,7 +556,7 @@ export function DeviceProvider({ children }: DeviceProviderProps) {
     await serial.disconnect();
   };
 
-  const value = useMemo<DeviceContextValue>(
+  return useMemo<DeviceContextValue>(
     () => ({
       // Connection
       status: serial.status,
@@ -264,6 +564,8 @@ export function DeviceProvider({ children }: DeviceProviderProps) {
       isSupported: serial.isSupported,
       isConnected,
       isReady,
+      linkHealth,
+      ownsPort,
       hasAuthorizedDevice: serial.hasAuthorizedDevice,
       requestPort: serial.requestPort,
       connect: serial.connect,
@@ -273,9 +575,13 @@ export function DeviceProvider({ children }: DeviceProviderProps) {
       config: deviceConfig.config,
       configLoading: deviceConfig.isLoading,
       configDirty: deviceConfig.isDirty,
+      configSource,
+      configConflict,
+      resolveConfigConflict,
+      flashedFields,
       readFromDevice: deviceConfig.readFromDevice,
       writeToDevice: deviceConfig.writeToDevice,
-      saveToFlash: deviceConfig.saveToFlash,
+      saveToFlash,
       resetToDefaults: deviceConfig.resetToDefaults,
       resetPadThresholds: deviceConfig.resetPadThresholds,
       resetTiming: deviceConfig.resetTiming,
@@ -291,6 +597,7 @@ export function DeviceProvider({ children }: DeviceProviderProps) {
       rebootToBootsel,
       uploadBootScreen,
       clearBootScreen,
+      applyProfile,
 
       // Streaming
       isStreaming: streaming.isStreaming,
@@ -300,6 +607,9 @@ export function DeviceProvider({ children }: DeviceProviderProps) {
       startStreaming: streaming.startStreaming,
       stopStreaming: streaming.stopStreaming,
       clearData: streaming.clearData,
+      holdStreaming: streaming.holdStreaming,
+      getNoiseSummary: streaming.getNoiseSummary,
+      resetNoise: streaming.resetNoise,
       maxBufferSize: streaming.maxBufferSize,
       setMaxBufferSize: streaming.setMaxBufferSize,
 
@@ -307,26 +617,28 @@ export function DeviceProvider({ children }: DeviceProviderProps) {
       firmwareUpdate: {
         status: firmwareUpdate.status,
         latestFirmware: firmwareUpdate.latestFirmware,
+        releases: firmwareUpdate.releases,
+        manifestOffline: firmwareUpdate.manifestOffline,
+        pinnedVersion: firmwareUpdate.pinnedVersion,
+        setPinnedVersion: firmwareUpdate.setPinnedVersion,
+        selectVersion: firmwareUpdate.selectVersion,
         error: firmwareUpdate.error,
         progress: firmwareUpdate.progress,
+        bytesWritten: firmwareUpdate.bytesWritten,
         checkUpdate: firmwareUpdate.checkUpdate,
         installUpdate: handleInstallUpdate,
         modalOpen,
         setModalOpen,
       },
     }),
-    [serial, deviceConfig, streaming, isConnected, isReady, firmwareUpdate, modalOpen]
-  );
-
-  return (
-    <DeviceContext.Provider value={value}>{children}</DeviceContext.Provider>
+    [serial, ownsPort, deviceConfig, streaming, isConnected, isReady, linkHealth, firmwareUpdate, modalOpen, configSource, configConflict, flashedFields]
   );
 }
 
 export function useDevice(): DeviceContextValue {
   const context = useContext(DeviceContext);
   if (!context) {
-    throw new Error("useDevice must be used within a DeviceProvider");
+    throw new Error("useDevice must be used within a DeviceManagerProvider");
   }
   return context;
 }
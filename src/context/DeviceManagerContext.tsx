@@ -0,0 +1,411 @@
+import { createContext, useCallback, useContext, useEffect, useLayoutEffect, useMemo, useRef, useState, useSyncExternalStore } from "react";
+import type { ReactNode } from "react";
+import { DeviceContext, useDeviceSession, type DeviceContextValue } from "@/context/DeviceContext";
+import { useWebSerial, type SerialPortBinding } from "@/hooks/useWebSerial";
+import { useSerialShareHost } from "@/hooks/useSerialShareHost";
+import { useRemoteSerial } from "@/hooks/useRemoteSerial";
+import {
+  SHARE_CHANNEL,
+  createTabId,
+  electSerialLeader,
+  type SerialShare,
+  type SharedDeviceState,
+  type ShareMessage,
+} from "@/lib/serial-share";
+import { PICO_VENDOR_ID } from "@/types";
+
+// Device manager
+// Every authorized drum gets a slot with its own session (transport, config,
+// stream buffers, update flow). Sessions run side by side and publish their
+// state to a per-slot store; DeviceScope provides one of them as DeviceContext,
+// so a busy device only re-renders the views that show it.
+//
+// A slot outlives its port: when a device is unplugged or reboots (BOOTSEL,
+// firmware update) the slot keeps its state and is given the port that
+// appears next.
+//
+// Only one tab can open a port. With several tabs open, the leader tab runs
+// the sessions on the real ports and the others mirror its device list with
+// sessions that go through it (see serial-share).
+
+export type DeviceLayout = "single" | "side-by-side";
+
+interface SessionStore {
+  get: () => DeviceContextValue | null;
+  set: (value: DeviceContextValue) => void;
+  subscribe: (listener: () => void) => () => void;
+}
+
+interface DeviceSlot {
+  id: number;
+  port: SerialPort | null;
+  attached: number;
+  store: SessionStore;
+}
+
+interface DeviceManagerValue {
+  deviceIds: number[];
+  getSession: (id: number) => DeviceContextValue | null;  // Latest state, for one-off actions
+  activeId: number;
+  setActiveId: (id: number) => void;
+  addDevice: () => Promise<void>;
+  removeDevice: (id: number) => void;
+  layout: DeviceLayout;
+  setLayout: (layout: DeviceLayout) => void;
+}
+
+const DeviceManagerContext = createContext<DeviceManagerValue | null>(null);
+const StoresContext = createContext<Map<number, SessionStore> | null>(null);
+
+const DISCONNECTED: SharedDeviceState = { id: 0, status: "disconnected", error: null, hasPort: false };
+
+const isPico = (port: SerialPort) => port.getInfo().usbVendorId === PICO_VENDOR_ID;
+
+function createSessionStore(): SessionStore {
+  let value: DeviceContextValue | null = null;
+  const listeners = new Set<() => void>();
+  return {
+    get: () => value,
+    set: (next) => {
+      value = next;
+      listeners.forEach((listener) => listener());
+    },
+    subscribe: (listener) => {
+      listeners.add(listener);
+      return () => listeners.delete(listener);
+    },
+  };
+}
+
+const createSlot = (id: number, port: SerialPort | null): DeviceSlot =>
+  ({ id, port, attached: 0, store: createSessionStore() });
+
+// Assigns newly appeared ports: a port a slot already had is handed back to
+// it, any other goes to a slot whose port is gone, else to a new slot
+function assignPorts(slots: DeviceSlot[], present: SerialPort[], appeared: SerialPort[], nextId: () => number): DeviceSlot[] {
+  let next = slots;
+  for (const port of appeared) {
+    const index = next.findIndex((s) => s.port === port);
+    const free = index !== -1 ? index : next.findIndex((s) => !s.port || !present.includes(s.port));
+    if (free !== -1) {
+      next = next.map((s, i) => (i === free ? { ...s, port, attached: s.attached + 1 } : s));
+    } else {
+      next = [...next, createSlot(nextId(), port)];
+    }
+  }
+  return next;
+}
+
+function usePublishSession(store: SessionStore, value: DeviceContextValue) {
+  // Before paint, so switching devices never shows a frame of the old one
+  useLayoutEffect(() => {
+    store.set(value);
+  }, [store, value]);
+}
+
+// Runs one session on a port of this tab and publishes its value. Renders
+// nothing itself.
+function LocalDeviceSession({ slot, claim, share, relay }: {
+  slot: DeviceSlot;
+  claim: (id: number, port: SerialPort) => boolean;
+  share: SerialShare | null;
+  relay: boolean;
+}) {
+  const claimPort = useCallback((port: SerialPort) => claim(slot.id, port), [claim, slot.id]);
+  const binding = useMemo<SerialPortBinding>(
+    () => ({ id: slot.id, port: slot.port, attached: slot.attached, claim: claimPort }),
+    [slot.id, slot.port, slot.attached, claimPort]
+  );
+  const local = useWebSerial(binding);
+  const serial = useSerialShareHost(share, slot.id, relay, local);
+  usePublishSession(slot.store, useDeviceSession({ serial, ownsPort: true }));
+  return null;
+}
+
+// Runs one session on a port of the leader tab
+function RemoteDeviceSession({ slot, share, device }: {
+  slot: DeviceSlot;
+  share: SerialShare;
+  device: SharedDeviceState;
+}) {
+  const serial = useRemoteSerial(share, device);
+  usePublishSession(slot.store, useDeviceSession({ serial, ownsPort: false }));
+  return null;
+}
+
+// Provides the session of device `id` to its children
+export function DeviceScope({ id, children }: { id: number; children: ReactNode }) {
+  const stores = useContext(StoresContext);
+  const store = stores?.get(id);
+  if (!store) throw new Error("DeviceScope must be used within a DeviceManagerProvider");
+  const value = useSyncExternalStore(store.subscribe, store.get);
+  if (!value) return null;
+  return <DeviceContext.Provider value={value}>{children}</DeviceContext.Provider>;
+}
+
+const isSupported = typeof navigator !== "undefined" && "serial" in navigator;
+const canShare = isSupported && typeof BroadcastChannel !== "undefined";
+
+export function DeviceManagerProvider({ children }: { children: ReactNode }) {
+  const [slots, setSlots] = useState<DeviceSlot[]>(() => [createSlot(1, null)]);
+  const [activeId, setActiveId] = useState(1);
+  const [layout, setLayout] = useState<DeviceLayout>("single");
+
+  // undefined until the tab election settles; null when tabs can't share
+  // (this tab then opens its ports itself)
+  const [share, setShare] = useState<SerialShare | null | undefined>(() => (canShare ? undefined : null));
+  const isFollower = share?.role === "follower";
+  const [followerCount, setFollowerCount] = useState(0);
+  const [remoteDevices, setRemoteDevices] = useState<SharedDeviceState[]>([]);
+
+  const nextIdRef = useRef(2);
+  const slotsRef = useRef(slots);
+  const knownPortsRef = useRef<SerialPort[]>([]);
+  const removedPortsRef = useRef(new WeakSet<SerialPort>());
+
+  useEffect(() => {
+    slotsRef.current = slots;
+  }, [slots]);
+
+  useEffect(() => {
+    if (!canShare) return;
+    const channel = new BroadcastChannel(SHARE_CHANNEL);
+    const tabId = createTabId();
+    const stopElection = electSerialLeader((role) => setShare({ channel, tabId, role }));
+    return () => {
+      stopElection();
+      channel.close();
+    };
+  }, []);
+
+  // Hand every authorized drum to a session, on load and whenever one is plugged in
+  useEffect(() => {
+    if (!isSupported || share === undefined || share?.role === "follower") return;
+    let cancelled = false;
+    knownPortsRef.current = [];
+
+    const syncPorts = async () => {
+      try {
+        const present = (await navigator.serial.getPorts()).filter(isPico);
+        if (cancelled) return;
+        const known = knownPortsRef.current;
+        knownPortsRef.current = present;
+        const appeared = present.filter((p) => !known.includes(p) && !removedPortsRef.current.has(p));
+        if (appeared.length === 0) return;
+        setSlots((prev) => assignPorts(prev, present, appeared, () => nextIdRef.current++));
+      } catch (e) {
+        console.error("Failed to check ports:", e);
+      }
+    };
+
+    // A follower tab authorized a port
+    const onMessage = (event: MessageEvent<ShareMessage>) => {
+      if (event.data.type === "rescan") syncPorts();
+    };
+
+    syncPorts();
+    navigator.serial.addEventListener("connect", syncPorts);
+    navigator.serial.addEventListener("disconnect", syncPorts);
+    share?.channel.addEventListener("message", onMessage);
+    return () => {
+      cancelled = true;
+      navigator.serial.removeEventListener("connect", syncPorts);
+      navigator.serial.removeEventListener("disconnect", syncPorts);
+      share?.channel.removeEventListener("message", onMessage);
+    };
+  }, [share]);
+
+  // A session's own Connect button picked `port`. Returns false (and shows
+  // the owner instead) when another session already has it.
+  const claim = useCallback((id: number, port: SerialPort): boolean => {
+    const owner = slotsRef.current.find((s) => s.port === port);
+    if (owner && owner.id !== id) {
+      setActiveId(owner.id);
+      return false;
+    }
+    removedPortsRef.current.delete(port);
+    setSlots((prev) => prev.map((s) => (s.id === id ? { ...s, port } : s)));
+    return true;
+  }, []);
+
+  const addDevice = useCallback(async () => {
+    if (!isSupported) return;
+    let port: SerialPort;
+    try {
+      port = await navigator.serial.requestPort({ filters: [{ usbVendorId: PICO_VENDOR_ID }] });
+    } catch (err) {
+      if (err instanceof Error && err.name !== "NotFoundError") console.error("Failed to add device:", err);
+      return;
+    }
+    if (share?.role === "follower") {
+      // The leader opens it and lists it with the other devices
+      share.channel.postMessage({ type: "rescan", from: share.tabId } satisfies ShareMessage);
+      return;
+    }
+
+    removedPortsRef.current.delete(port);
+    const current = slotsRef.current;
+    const owner = current.find((s) => s.port === port) ?? current.find((s) => !s.port);
+    const id = owner?.id ?? nextIdRef.current++;
+    setSlots((prev) => {
+      if (prev.some((s) => s.id === id)) {
+        // The session opens it unless it already is
+        return prev.map((s) => (s.id === id ? { ...s, port, attached: s.attached + 1 } : s));
+      }
+      return [...prev, { ...createSlot(id, port), attached: 1 }];
+    });
+    setActiveId(id);
+  }, [share]);
+
+  // Closes the device's session. Its port stays unused until it is added
+  // again or reconnected.
+  const removeDevice = useCallback((id: number) => {
+    if (share?.role === "follower") {
+      share.channel.postMessage({ type: "remove", from: share.tabId, device: id } satisfies ShareMessage);
+      return;
+    }
+    const current = slotsRef.current;
+    const slot = current.find((s) => s.id === id);
+    if (!slot) return;
+    if (slot.port) removedPortsRef.current.add(slot.port);
+
+    const remaining = current.filter((s) => s.id !== id);
+    const next = remaining.length > 0 ? remaining : [createSlot(nextIdRef.current++, null)];
+    setSlots(next);
+    setActiveId((active) => (active === id ? next[0].id : active));
+  }, [share]);
+
+  // Leader: keeps track of the follower tabs (lines are relayed only while
+  // there are any) and removes devices for them
+  useEffect(() => {
+    if (share?.role !== "leader") return;
+    const { channel, tabId } = share;
+    const followers = new Set<string>();
+
+    const onMessage = (event: MessageEvent<ShareMessage>) => {
+      const message = event.data;
+      if (message.type === "hello") followers.add(message.from);
+      else if (message.type === "bye") followers.delete(message.from);
+      else if (message.type === "remove") return removeDevice(message.device);
+      else return;
+      setFollowerCount(followers.size);
+    };
+
+    channel.addEventListener("message", onMessage);
+    channel.postMessage({ type: "leader", from: tabId } satisfies ShareMessage);
+    return () => channel.removeEventListener("message", onMessage);
+  }, [share, removeDevice]);
+
+  // Leader: publishes the device list whenever a session's connection changes
+  useEffect(() => {
+    if (share?.role !== "leader") return;
+    let last = "";
+
+    const publish = () => {
+      const devices: SharedDeviceState[] = slots.map((slot) => {
+        const session = slot.store.get();
+        return {
+          id: slot.id,
+          status: session?.status ?? "disconnected",
+          error: session?.error ?? null,
+          hasPort: slot.port !== null,
+        };
+      });
+      const json = JSON.stringify(devices);
+      if (json === last) return;
+      last = json;
+      share.channel.postMessage({ type: "devices", devices } satisfies ShareMessage);
+    };
+
+    // A new follower needs the list even if nothing changed
+    const onMessage = (event: MessageEvent<ShareMessage>) => {
+      if (event.data.type !== "hello") return;
+      last = "";
+      publish();
+    };
+
+    publish();
+    const unsubscribes = slots.map((slot) => slot.store.subscribe(publish));
+    share.channel.addEventListener("message", onMessage);
+    return () => {
+      unsubscribes.forEach((unsubscribe) => unsubscribe());
+      share.channel.removeEventListener("message", onMessage);
+    };
+  }, [share, slots]);
+
+  // Follower: mirrors the leader's device list
+  useEffect(() => {
+    if (share?.role !== "follower") return;
+    const { channel, tabId } = share;
+    const hello = () => channel.postMessage({ type: "hello", from: tabId } satisfies ShareMessage);
+    const bye = () => channel.postMessage({ type: "bye", from: tabId } satisfies ShareMessage);
+
+    const onMessage = (event: MessageEvent<ShareMessage>) => {
+      const message = event.data;
+      if (message.type === "leader") {
+        hello();
+      } else if (message.type === "devices") {
+        const { devices } = message;
+        nextIdRef.current = Math.max(nextIdRef.current, ...devices.map((d) => d.id + 1));
+        setRemoteDevices(devices);
+        setSlots((prev) => devices.map((d) => prev.find((s) => s.id === d.id) ?? createSlot(d.id, null)));
+      }
+    };
+
+    channel.addEventListener("message", onMessage);
+    window.addEventListener("pagehide", bye);
+    hello();
+    return () => {
+      bye();
+      window.removeEventListener("pagehide", bye);
+      channel.removeEventListener("message", onMessage);
+    };
+  }, [share]);
+
+  const stores = useMemo(() => new Map(slots.map((s) => [s.id, s.store])), [slots]);
+  const deviceIds = useMemo(() => slots.map((s) => s.id), [slots]);
+  const getSession = useCallback((id: number) => stores.get(id)?.get() ?? null, [stores]);
+  const shownId = stores.has(activeId) ? activeId : slots[0].id;
+
+  const value = useMemo<DeviceManagerValue>(
+    () => ({ deviceIds, getSession, activeId: shownId, setActiveId, addDevice, removeDevice, layout, setLayout }),
+    [deviceIds, getSession, shownId, addDevice, removeDevice, layout]
+  );
+
+  return (
+    <DeviceManagerContext.Provider value={value}>
+      <StoresContext.Provider value={stores}>
+        {share !== undefined && slots.map((slot) =>
+          share && isFollower ? (
+            <RemoteDeviceSession
+              key={`follower-${slot.id}`}
+              slot={slot}
+              share={share}
+              device={remoteDevices.find((d) => d.id === slot.id) ?? { ...DISCONNECTED, id: slot.id }}
+            />
+          ) : (
+            <LocalDeviceSession
+              key={`leader-${slot.id}`}
+              slot={slot}
+              claim={claim}
+              share={share}
+              relay={followerCount > 0}
+            />
+          )
+        )}
+        {/* Keyed so local UI state never carries over to another device */}
+        <DeviceScope key={shownId} id={shownId}>
+          {children}
+        </DeviceScope>
+      </StoresContext.Provider>
+    </DeviceManagerContext.Provider>
+  );
+}
+
+export function useDeviceManager(): DeviceManagerValue {
+  const context = useContext(DeviceManagerContext);
+  if (!context) {
+    throw new Error("useDeviceManager must be used within a DeviceManagerProvider");
+  }
+  return context;
+}
@@ -0,0 +1,108 @@
+import { createContext, useCallback, useContext, useEffect, useMemo, useRef, useState } from "react";
+import type { ReactNode } from "react";
+import {
+  MONITOR_PATH,
+  MONITOR_PORT,
+  MONITOR_RELAY,
+  type MonitorMessage,
+  type MonitorRelayMessage,
+  type MonitorWindowMessage,
+} from "@/lib/monitor-channel";
+
+// Owns the pop-out monitor window and the port feeding it. Sits outside the
+// device manager so switching the active drum keeps the window open; the
+// feed itself (MonitorPopoutFeed) runs in the device's scope.
+
+interface MonitorPopoutValue {
+  isOpen: boolean;
+  port: MessagePort | null;  // Set once the window has loaded
+  open: () => void;
+  close: () => void;
+}
+
+const MonitorPopoutContext = createContext<MonitorPopoutValue | null>(null);
+
+// A noopener window can't be watched, so it counts as closed when no port
+// arrives this long after opening it or after it hid (a reload rejoins)
+const CONNECT_TIMEOUT_MS = 10000;
+
+export function MonitorPopoutProvider({ children }: { children: ReactNode }) {
+  const [isOpen, setIsOpen] = useState(false);
+  const [port, setPort] = useState<MessagePort | null>(null);
+  const [session] = useState(() => crypto.randomUUID());
+  const portRef = useRef<MessagePort | null>(null);
+
+  useEffect(() => {
+    portRef.current = port;
+  }, [port]);
+
+  const close = useCallback(() => {
+    portRef.current?.postMessage({ type: "close" } satisfies MonitorMessage);
+    setIsOpen(false);
+    setPort(null);
+  }, []);
+
+  const open = useCallback(() => {
+    if (isOpen) {
+      portRef.current?.postMessage({ type: "focus" } satisfies MonitorMessage);
+      return;
+    }
+    // Its own browsing context: drawing the graphs doesn't compete with the
+    // stream on this page's main thread
+    const url = `${import.meta.env.BASE_URL}${MONITOR_PATH}?session=${session}`;
+    window.open(url, "_blank", "noopener,popup,width=960,height=1100");
+    setIsOpen(true);
+  }, [isOpen, session]);
+
+  useEffect(() => {
+    if (!isOpen) return;
+    let current: MessagePort | null = null;
+    let timeout = setTimeout(close, CONNECT_TIMEOUT_MS);
+
+    // The relay hands over a new port whenever the window (re)loads
+    const relay = new SharedWorker(new URL("../workers/monitor-relay.worker.ts", import.meta.url), {
+      type: "module",
+      name: MONITOR_RELAY,
+    });
+    relay.port.onmessage = (event: MessageEvent) => {
+      if (event.data?.type !== MONITOR_PORT || !event.ports[0]) return;
+      current?.close();
+      current = event.ports[0];
+      current.onmessage = (message: MessageEvent<MonitorWindowMessage>) => {
+        if (message.data.type !== "hidden") return;
+        clearTimeout(timeout);
+        timeout = setTimeout(close, CONNECT_TIMEOUT_MS);
+      };
+      clearTimeout(timeout);
+      setPort(current);
+    };
+    relay.port.postMessage({ type: "join", session, role: "feed" } satisfies MonitorRelayMessage);
+
+    // Without the configurator nothing feeds it
+    const onPageHide = () => current?.postMessage({ type: "close" } satisfies MonitorMessage);
+
+    window.addEventListener("pagehide", onPageHide);
+    return () => {
+      clearTimeout(timeout);
+      window.removeEventListener("pagehide", onPageHide);
+      relay.port.postMessage({ type: "leave", session } satisfies MonitorRelayMessage);
+      relay.port.close();
+      current?.close();
+    };
+  }, [isOpen, session, close]);
+
+  const value = useMemo<MonitorPopoutValue>(
+    () => ({ isOpen, port, open, close }),
+    [isOpen, port, open, close]
+  );
+
+  return <MonitorPopoutContext.Provider value={value}>{children}</MonitorPopoutContext.Provider>;
+}
+
+export function useMonitorPopout(): MonitorPopoutValue {
+  const context = useContext(MonitorPopoutContext);
+  if (!context) {
+    throw new Error("useMonitorPopout must be used within a MonitorPopoutProvider");
+  }
+  return context;
+}
@@ -0,0 +1,79 @@
+import { useState } from "react";
+import type { PadBuffers } from "@/types";
+import { framesFromPadBuffers, parseSession, type ParsedSession } from "@/lib/session-player";
+
+export interface AnalysisSession extends ParsedSession {
+  name: string;
+}
+
+export interface AnalysisFrames {
+  frames: Uint16Array;
+  inputMasks: Uint8Array | null;
+  sampleIntervalMs: number;
+}
+
+// A card's last run over a source
+export interface AnalysisOutcome<T> {
+  revision: number;
+  result: T | null;
+  error: string | null;
+}
+
+export interface AnalysisSource {
+  session: AnalysisSession | null;  // null: the graph buffer
+  revision: number;                 // Changes with the source; older results no longer apply
+  sampleRate: number;
+  setSampleRate: (rate: number | undefined) => void;
+  selectGraphBuffer: () => void;
+  loadFile: (file: File) => Promise<void>;
+  getFrames: () => AnalysisFrames | null;
+  error: string | null;
+}
+
+const ASSUMED_SAMPLE_RATE = 100;  // Hardware stream rate
+
+// What a session analysis runs over: the graph buffer of the drum in scope or
+// a loaded recording, and the sample rate to read it at. Trace exports carry
+// timestamps; live data uses the measured stream rate.
+export function useAnalysisSource(buffers: React.RefObject<PadBuffers>, liveRate: number | null): AnalysisSource {
+  const [session, setSession] = useState<AnalysisSession | null>(null);
+  const [rateOverride, setRateOverride] = useState<number | undefined>(undefined);
+  const [error, setError] = useState<string | null>(null);
+  const [revision, setRevision] = useState(0);
+
+  const detectedRate = session
+    ? session.sampleIntervalMs && 1000 / session.sampleIntervalMs
+    : liveRate;
+  const sampleRate = rateOverride ?? (detectedRate ? Math.round(detectedRate) : ASSUMED_SAMPLE_RATE);
+
+  const selectGraphBuffer = () => {
+    if (session) setRevision((r) => r + 1);
+    setSession(null);
+    setRateOverride(undefined);
+    setError(null);
+  };
+
+  const loadFile = async (file: File) => {
+    const parsed = parseSession(await file.text());
+    if (parsed.frames.length === 0) {
+      setError(`No raw stream lines in ${file.name}`);
+      return;
+    }
+    setSession({ name: file.name, ...parsed });
+    setRevision((r) => r + 1);
+    setRateOverride(undefined);
+    setError(null);
+  };
+
+  const getFrames = (): AnalysisFrames | null => {
+    const frames = session ? session.frames : framesFromPadBuffers(buffers.current);
+    if (frames.length < 8) {
+      setError("No stream data yet");
+      return null;
+    }
+    setError(null);
+    return { frames, inputMasks: session?.inputMasks ?? null, sampleIntervalMs: 1000 / sampleRate };
+  };
+
+  return { session, revision, sampleRate, setSampleRate: setRateOverride, selectGraphBuffer, loadFile, getFrames, error };
+}
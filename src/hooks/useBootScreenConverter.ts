@@ -0,0 +1,103 @@
+import { useCallback, useEffect, useRef, useState } from "react";
+import type { DitherOptions } from "@/lib/dither";
+import type { BootScreenWorkerRequest, BootScreenWorkerResponse } from "@/workers/boot-screen.worker";
+
+interface UseBootScreenConverterReturn {
+  preview: Uint8ClampedArray | null;  // 128x64 RGBA
+  bmp: Uint8Array | null;
+  error: string | null;
+  isConverting: boolean;              // The result doesn't match the current image/options yet
+}
+
+interface ConversionInput {
+  image: Blob;
+  options: DitherOptions;
+}
+
+interface ConversionResult extends ConversionInput {
+  preview: Uint8ClampedArray;
+  bmp: Uint8Array;
+}
+
+// Converts the selected image in a worker. While a conversion is running only
+// the newest options are kept, so dragging a slider never queues up work.
+export function useBootScreenConverter(image: Blob | null, options: DitherOptions): UseBootScreenConverterReturn {
+  const [result, setResult] = useState<ConversionResult | null>(null);
+  const [error, setError] = useState<{ image: Blob; message: string } | null>(null);
+
+  const workerRef = useRef<Worker | null>(null);
+  const requestIdRef = useRef(0);
+  const busyRef = useRef(false);
+  const loadedRef = useRef<Blob | null>(null);         // Image currently held by the worker
+  const loadingRef = useRef<Blob | null>(null);
+  const latestRef = useRef<ConversionInput | null>(null);
+  const inFlightRef = useRef<ConversionInput | null>(null);
+
+  // Send the newest input once the worker is idle
+  const pump = useCallback(() => {
+    const worker = workerRef.current;
+    const latest = latestRef.current;
+    if (!worker || !latest || busyRef.current) return;
+    if (latest === inFlightRef.current) return;  // Already converted
+
+    busyRef.current = true;
+    let request: BootScreenWorkerRequest;
+    if (loadedRef.current !== latest.image) {
+      // New image: decode and scale it once
+      loadingRef.current = latest.image;
+      request = { type: "load", id: ++requestIdRef.current, image: latest.image };
+    } else {
+      inFlightRef.current = latest;
+      request = { type: "convert", id: ++requestIdRef.current, options: latest.options };
+    }
+    worker.postMessage(request);
+  }, []);
+
+  useEffect(() => {
+    const worker = new Worker(new URL("../workers/boot-screen.worker.ts", import.meta.url), { type: "module" });
+    workerRef.current = worker;
+
+    worker.onmessage = (event: MessageEvent<BootScreenWorkerResponse>) => {
+      const response = event.data;
+      busyRef.current = false;
+
+      if (response.type === "loaded") {
+        loadedRef.current = loadingRef.current;
+      } else if (response.type === "converted" && inFlightRef.current) {
+        setResult({ ...inFlightRef.current, preview: response.preview, bmp: response.bmp });
+      } else if (response.type === "error") {
+        const failed = loadedRef.current === loadingRef.current ? inFlightRef.current?.image : loadingRef.current;
+        if (failed) setError({ image: failed, message: response.message });
+        latestRef.current = null;  // Don't retry until the input changes
+      }
+
+      pump();
+    };
+
+    pump();
+
+    return () => {
+      worker.terminate();
+      workerRef.current = null;
+      busyRef.current = false;
+      loadedRef.current = null;
+      loadingRef.current = null;
+      inFlightRef.current = null;
+    };
+  }, [pump]);
+
+  useEffect(() => {
+    latestRef.current = image ? { image, options } : null;
+    pump();
+  }, [image, options, pump]);
+
+  const current = result && result.image === image ? result : null;
+  const currentError = error && error.image === image ? error.message : null;
+
+  return {
+    preview: current?.preview ?? null,
+    bmp: current?.bmp ?? null,
+    error: currentError,
+    isConverting: image !== null && !currentError && (current === null || current.options !== options),
+  };
+}
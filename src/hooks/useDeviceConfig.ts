@@ -1,16 +1,25 @@
-import { useState, useCallback, useEffect } from "react";
+import { useState, useCallback, useEffect, useRef } from "react";
 import type { DeviceConfig, PadName, PadThresholds, TimingConfig, DeviceCommand, KeyMappings, ADCChannels } from "@/types";
 import { DeviceCommand as DeviceCommandValues } from "@/types";
 import {
+  isSettingsLine,
   parseSettingsResponse,
   settingsToConfig,
   configToSettingsString,
+  formatSettings,
 } from "@/lib/serial-protocol";
 import { DEFAULT_DEVICE_CONFIG } from "@/lib/default-config";
+import { collectLines } from "@/lib/line-router";
+import type { WaitForLine } from "@/lib/boot-screen-upload";
+import { HEARTBEAT_TIMEOUT_MS, HEARTBEAT_MAX_WRITE_MS } from "@/lib/link-health";
+
+// The settings arrive in one burst; a pause this long ends the response
+const SETTINGS_QUIET_MS = 50;
+const SETTINGS_TIMEOUT_MS = 1000;
 
 interface UseDeviceConfigProps {
   sendCommand: (command: DeviceCommand, data?: string) => Promise<void>;
-  readUntilTimeout: (timeoutMs?: number) => Promise<string>;
+  waitForLine: WaitForLine;
   clearBuffer?: () => void;
   isConnected: boolean;
 }
@@ -28,6 +37,17 @@ interface UseDeviceConfigReturn {
 
   // Actions
   readFromDevice: () => Promise<boolean>;
+  // Raw key:value access, leaves the editor state alone
+  readSettings: () => Promise<{ settings: Map<number, number>; version?: string } | null>;
+  // Link health heartbeat: ms until the settings response starts, null when
+  // there was none, undefined when skipped because a read is running or the
+  // write was held up
+  probeLatency: () => Promise<number | null | undefined>;
+  writeSettings: (settings: Map<number, number>) => Promise<boolean>;
+  // Show settings read elsewhere as the device state
+  applySettings: (settings: Map<number, number>, version?: string) => void;
+  // Show `edited` as unsaved changes on top of the device state `saved`
+  applyEdits: (saved: DeviceConfig, edited: DeviceConfig) => void;
   writeToDevice: () => Promise<boolean>;
   saveToFlash: () => Promise<boolean>;
   resetToDefaults: () => void;
@@ -66,7 +86,7 @@ interface UseDeviceConfigReturn {
 
 export function useDeviceConfig({
   sendCommand,
-  readUntilTimeout,
+  waitForLine,
   clearBuffer,
   isConnected,
 }: UseDeviceConfigProps): UseDeviceConfigReturn {
@@ -136,37 +156,115 @@ export function useDeviceConfig({
     setLastCommittedConfig(newConfig);
   };
 
-  const readFromDevice = useCallback(async (): Promise<boolean> => {
-    if (!isConnected) return false;
-
-    setIsLoading(true);
+  // Two reads at once would split the response lines between them
+  const readInFlightRef = useRef<Promise<unknown> | null>(null);
+
+  const readSettings = useCallback(async () => {
+    if (!isConnected) return null;
+    while (readInFlightRef.current) await readInFlightRef.current;
+
+    const read = (async () => {
+      try {
+        if (clearBuffer) clearBuffer();
+        await sendCommand(DeviceCommandValues.READ_SETTINGS);
+        const lines = await collectLines(waitForLine, isSettingsLine, {
+          timeoutMs: SETTINGS_TIMEOUT_MS,
+          quietMs: SETTINGS_QUIET_MS,
+        });
+        const parsed = parseSettingsResponse(lines.join("\n"));
+        return parsed.settings.size > 0 ? parsed : null;
+      } catch (err) {
+        console.error("Failed to read settings:", err);
+        return null;
+      }
+    })();
+    readInFlightRef.current = read;
     try {
-      if (clearBuffer) clearBuffer();
-      await sendCommand(DeviceCommandValues.READ_SETTINGS);
-      const response = await readUntilTimeout(1000);
-      const { settings, version } = parseSettingsResponse(response);
-
-      if (settings.size > 0) {
-        const newConfig = settingsToConfig(settings, version);
-        setConfig(newConfig);
-        setSavedConfig(newConfig);
-        
-        // Reset history
-        setLastCommittedConfig(newConfig);
-        setHistory([]);
-        setFuture([]);
-        
-        return true;
+      return await read;
+    } finally {
+      if (readInFlightRef.current === read) readInFlightRef.current = null;
+    }
+  }, [isConnected, sendCommand, waitForLine]);
+
+  const probeLatency = useCallback(async (): Promise<number | null | undefined> => {
+    if (!isConnected || readInFlightRef.current) return undefined;
+
+    const probe = (async () => {
+      try {
+        // A response that arrived after an earlier heartbeat gave up would
+        // be taken for this one's
+        while ((await waitForLine(isSettingsLine, 0)) !== null) {
+          // Discard
+        }
+
+        // Timed from the write so commands queued ahead of it don't count; a
+        // reply arriving before the wait starts is found in the queue
+        const queued = performance.now();
+        await sendCommand(DeviceCommandValues.READ_SETTINGS);
+        const sent = performance.now();
+        const response = await waitForLine(isSettingsLine, HEARTBEAT_TIMEOUT_MS);
+        const rtt = performance.now() - sent;
+        // Drop the rest of the response
+        if (response !== null) {
+          await collectLines(waitForLine, isSettingsLine, { timeoutMs: SETTINGS_TIMEOUT_MS, quietMs: SETTINGS_QUIET_MS });
+        }
+        if (sent - queued > HEARTBEAT_MAX_WRITE_MS) return undefined;
+        return response === null ? null : rtt;
+      } catch {
+        return null;
       }
+    })();
+    readInFlightRef.current = probe;
+    try {
+      return await probe;
+    } finally {
+      if (readInFlightRef.current === probe) readInFlightRef.current = null;
+    }
+  }, [isConnected, sendCommand, waitForLine]);
 
-      return false;
+  const writeSettings = useCallback(async (settings: Map<number, number>): Promise<boolean> => {
+    if (!isConnected || settings.size === 0) return false;
+    try {
+      await sendCommand(DeviceCommandValues.WRITE_MODE, formatSettings(settings));
+      return true;
     } catch (err) {
-      console.error("Failed to read config:", err);
+      console.error("Failed to write settings:", err);
       return false;
+    }
+  }, [isConnected, sendCommand]);
+
+  const applySettings = useCallback((settings: Map<number, number>, version?: string): void => {
+    const newConfig = settingsToConfig(settings, version);
+    setConfig(newConfig);
+    setSavedConfig(newConfig);
+
+    // Reset history
+    setLastCommittedConfig(newConfig);
+    setHistory([]);
+    setFuture([]);
+  }, []);
+
+  const applyEdits = useCallback((saved: DeviceConfig, edited: DeviceConfig): void => {
+    setConfig(edited);
+    setSavedConfig(saved);
+    setLastCommittedConfig(edited);
+    setHistory([]);
+    setFuture([]);
+  }, []);
+
+  const readFromDevice = useCallback(async (): Promise<boolean> => {
+    if (!isConnected) return false;
+
+    setIsLoading(true);
+    try {
+      const result = await readSettings();
+      if (!result) return false;
+      applySettings(result.settings, result.version);
+      return true;
     } finally {
       setIsLoading(false);
     }
-  }, [isConnected, sendCommand, readUntilTimeout]);
+  }, [isConnected, readSettings, applySettings]);
 
   const writeToDevice = useCallback(async (): Promise<boolean> => {
     if (!isConnected) return false;
@@ -421,6 +519,11 @@ export function useDeviceConfig({
     undo,
     redo,
     readFromDevice,
+    readSettings,
+    probeLatency,
+    writeSettings,
+    applySettings,
+    applyEdits,
     writeToDevice,
     saveToFlash,
     resetToDefaults,
@@ -1,17 +1,25 @@
 import { useState, useCallback, useRef, useEffect } from "react";
-import type { DeviceCommand, PadName, PadBuffer, PadBuffers } from "@/types";
+import type { DeviceCommand, PadBuffers, PadName, TriggerState } from "@/types";
 import { DeviceCommand as DeviceCommandValues, PAD_NAMES } from "@/types";
-import { parseRawStreamLine, parseInputStreamLine } from "@/lib/serial-protocol";
+import { createPadBuffers, resizePadBuffer } from "@/lib/pad-buffer";
+import { createStreamIngestState, ingestStreamLine, markStreamGap, resetStreamIngestState } from "@/lib/stream-ingest";
+import {
+  createNoiseStats,
+  resetNoiseStats,
+  summarizeNoise,
+  type PadNoiseSummary,
+} from "@/lib/noise-stats";
 
 interface UseDeviceStreamingProps {
   sendCommand: (command: DeviceCommand, data?: string) => Promise<void>;
   startReading: (onData: (line: string) => void) => void;
   stopReading: () => void;
   isConnected: boolean;
+  isReconnecting: boolean;  // The connection was lost and is being restored
 }
 
 // Simple trigger state - just 4 booleans
-export type TriggerState = Record<PadName, boolean>;
+export type { TriggerState };
 
 export type StreamingMode = 'none' | 'raw' | 'input' | 'both';
 
@@ -26,46 +34,23 @@ interface UseDeviceStreamingReturn {
   startStreaming: (mode?: StreamingMode) => Promise<void>;
   stopStreaming: () => Promise<void>;
   clearData: () => void;
+  // Raw streaming while any holder needs it (monitor tab, pop-out window).
+  // Returns the release; streaming stops when the last holder lets go.
+  holdStreaming: () => () => void;
+  // Restarts the mode that was streaming when the connection was lost
+  resumeStreaming: () => Promise<void>;
+  // Stops the stream for a command exchange. Resolves with the function that
+  // restarts the mode that was running, whichever render calls it.
+  pauseStreaming: () => Promise<() => Promise<void>>;
+
+  // Noise floor of the idle pads since the last reset (see noise-stats)
+  getNoiseSummary: () => Record<PadName, PadNoiseSummary>;
+  resetNoise: () => void;
 
   maxBufferSize: number;
   setMaxBufferSize: (size: number) => void;
 }
 
-function createPadBuffer(capacity: number): PadBuffer {
-  return {
-    raw: new Float32Array(capacity),
-    delta: new Float32Array(capacity),
-    head: 0,
-    count: capacity,
-    capacity,
-  };
-}
-
-function createPadBuffers(capacity: number): PadBuffers {
-  return {
-    kaLeft: createPadBuffer(capacity),
-    donLeft: createPadBuffer(capacity),
-    donRight: createPadBuffer(capacity),
-    kaRight: createPadBuffer(capacity),
-  };
-}
-
-function resizePadBuffer(buffer: PadBuffer, newCapacity: number): PadBuffer {
-  const newBuffer = createPadBuffer(newCapacity);
-  const copyCount = Math.min(buffer.capacity, newCapacity);
-  const startRead = buffer.head;
-
-  for (let i = 0; i < copyCount; i++) {
-    const readIdx = (startRead + buffer.capacity - copyCount + i) % buffer.capacity;
-    newBuffer.raw[i] = buffer.raw[readIdx];
-    newBuffer.delta[i] = buffer.delta[readIdx];
-  }
-
-  newBuffer.head = copyCount % newCapacity;
-  newBuffer.count = newCapacity;
-  return newBuffer;
-}
-
 const DEFAULT_BUFFER_SIZE = 5000;
 const INITIAL_TRIGGERS: TriggerState = { kaLeft: false, donLeft: false, donRight: false, kaRight: false };
 
@@ -74,17 +59,24 @@ export function useDeviceStreaming({
   startReading,
   stopReading,
   isConnected,
+  isReconnecting,
 }: UseDeviceStreamingProps): UseDeviceStreamingReturn {
   const [isStreaming, setIsStreaming] = useState(false);
   const [streamingMode, setStreamingMode] = useState<StreamingMode>('none');
+  // Current mode for start/stop, which may run from the closure of an
+  // earlier render (a restart after a command exchange)
+  const modeRef = useRef<StreamingMode>('none');
   const [triggers, setTriggers] = useState<TriggerState>(INITIAL_TRIGGERS);
   const [maxBufferSize, setMaxBufferSizeState] = useState(DEFAULT_BUFFER_SIZE);
 
   const buffersRef = useRef<PadBuffers>(createPadBuffers(DEFAULT_BUFFER_SIZE));
-  const previousRawRef = useRef<Record<PadName, number>>({ kaLeft: 0, donLeft: 0, donRight: 0, kaRight: 0 });
 
-  // Accumulate triggers between UI frames
-  const accumulatedTriggersRef = useRef<TriggerState>({ kaLeft: false, donLeft: false, donRight: false, kaRight: false });
+  // Previous raw values, triggers accumulated between UI frames, noise floor
+  const noiseRef = useRef(createNoiseStats());
+  const ingestRef = useRef(createStreamIngestState(buffersRef.current, noiseRef.current));
+
+  const getNoiseSummary = useCallback(() => summarizeNoise(noiseRef.current), []);
+  const resetNoise = useCallback(() => resetNoiseStats(noiseRef.current), []);
 
   // Throttling
   const lastFrameUpdateRef = useRef(0);
@@ -98,44 +90,10 @@ export function useDeviceStreaming({
   }, []);
 
   const handleStreamData = useCallback((line: string) => {
-    let inputs: Record<PadName, boolean> | null = null;
-    let raws: Record<PadName, number> | null = null;
-
-    // 1. Try Input Hex (1-2 chars)
-    if (line.length <= 2) {
-       inputs = parseInputStreamLine(line);
-    }
-    // 2. Try Raw Hex (16 chars)
-    else if (line.length === 16) {
-       raws = parseRawStreamLine(line);
-    }
+    ingestStreamLine(ingestRef.current, line);
 
     const now = performance.now();
-    const buffers = buffersRef.current;
-    const accumulated = accumulatedTriggersRef.current;
-
-    // Process Inputs
-    if (inputs) {
-        PAD_NAMES.forEach(pad => {
-            if (inputs![pad]) accumulated[pad] = true;
-        });
-    }
-
-    // Process Raws
-    if (raws) {
-        PAD_NAMES.forEach(pad => {
-            const buffer = buffers[pad];
-            const rawVal = raws![pad];
-            const previousRaw = previousRawRef.current[pad];
-            const delta = Math.max(0, rawVal - previousRaw);
-
-            buffer.raw[buffer.head] = rawVal;
-            buffer.delta[buffer.head] = delta;
-            buffer.head = (buffer.head + 1) % buffer.capacity;
-
-            previousRawRef.current[pad] = rawVal;
-        });
-    }
+    const accumulated = ingestRef.current.triggers;
 
     // Throttled UI update - only update if triggers changed
     if (now - lastFrameUpdateRef.current >= FRAME_THROTTLE_MS) {
@@ -162,10 +120,10 @@ export function useDeviceStreaming({
   }, []);
 
   const startStreamingFn = useCallback(async (mode: StreamingMode = 'raw'): Promise<void> => {
-    if (!isConnected || streamingMode === mode) return;
+    if (!isConnected || modeRef.current === mode) return;
     try {
       // Stop current if any
-      if (isStreaming) {
+      if (modeRef.current !== 'none') {
           stopReading();
           await sendCommand(DeviceCommandValues.STOP_STREAMING);
           await new Promise(r => setTimeout(r, 50));
@@ -174,26 +132,28 @@ export function useDeviceStreaming({
       if (mode === 'raw' || mode === 'both') await sendCommand(DeviceCommandValues.START_STREAMING);
       if (mode === 'input' || mode === 'both') await sendCommand(DeviceCommandValues.START_INPUT_STREAMING);
       
+      modeRef.current = mode;
       setStreamingMode(mode);
       setIsStreaming(true);
       startReading(handleStreamData);
     } catch (err) {
       console.error("Failed to start streaming:", err);
     }
-  }, [isConnected, isStreaming, streamingMode, sendCommand, startReading, handleStreamData]);
+  }, [isConnected, sendCommand, startReading, stopReading, handleStreamData]);
 
   const stopStreamingFn = useCallback(async (): Promise<void> => {
-    if (!isStreaming) return;
+    if (modeRef.current === 'none') return;
     try {
       stopReading();
       await sendCommand(DeviceCommandValues.STOP_STREAMING);
     } catch (err) {
       console.error("Failed to stop streaming:", err);
     } finally {
+      modeRef.current = 'none';
       setIsStreaming(false);
       setStreamingMode('none');
     }
-  }, [isStreaming, sendCommand, stopReading]);
+  }, [sendCommand, stopReading]);
 
   const clearData = useCallback((): void => {
     PAD_NAMES.forEach((pad) => {
@@ -202,13 +162,49 @@ export function useDeviceStreaming({
       buffer.count = buffer.capacity;
       buffer.raw.fill(0);
       buffer.delta.fill(0);
-      accumulatedTriggersRef.current[pad] = false;
     });
+    resetStreamIngestState(ingestRef.current);
     setTriggers(INITIAL_TRIGGERS);
-    previousRawRef.current = { kaLeft: 0, donLeft: 0, donRight: 0, kaRight: 0 };
     lastFrameUpdateRef.current = 0;
   }, []);
 
+  const holdsRef = useRef(0);
+  const startRef = useRef(startStreamingFn);
+  const stopRef = useRef(stopStreamingFn);
+  useEffect(() => {
+    startRef.current = startStreamingFn;
+    stopRef.current = stopStreamingFn;
+  });
+
+  // Mode to restart once the device is back; the buffers are kept
+  const resumeModeRef = useRef<StreamingMode>('none');
+
+  const resumeStreaming = useCallback(async () => {
+    const mode = resumeModeRef.current;
+    resumeModeRef.current = 'none';
+    if (mode !== 'none') await startRef.current(mode);
+  }, []);
+
+  const pauseStreaming = useCallback(async () => {
+    const mode = modeRef.current;
+    if (mode !== 'none') await stopRef.current();
+    return async () => {
+      if (mode !== 'none') await startRef.current(mode);
+    };
+  }, []);
+
+  const holdStreaming = useCallback(() => {
+    holdsRef.current++;
+    startRef.current('raw');
+    let released = false;
+    return () => {
+      if (released) return;
+      released = true;
+      holdsRef.current--;
+      if (holdsRef.current === 0) stopRef.current();
+    };
+  }, []);
+
   useEffect(() => {
     const handleBeforeUnload = () => {
       if (isStreaming) {
@@ -220,13 +216,19 @@ export function useDeviceStreaming({
     window.addEventListener("beforeunload", handleBeforeUnload);
     
     if (!isConnected && isStreaming) {
+      if (isReconnecting) {
+        resumeModeRef.current = streamingMode;
+        if (streamingMode !== 'input') markStreamGap(ingestRef.current);
+      }
+      modeRef.current = 'none';
       setIsStreaming(false);
+      setStreamingMode('none');
     }
 
     return () => {
       window.removeEventListener("beforeunload", handleBeforeUnload);
     };
-  }, [isConnected, isStreaming, sendCommand]);
+  }, [isConnected, isReconnecting, isStreaming, streamingMode, sendCommand]);
 
   return {
     isStreaming,
@@ -236,6 +238,11 @@ export function useDeviceStreaming({
     startStreaming: startStreamingFn,
     stopStreaming: stopStreamingFn,
     clearData,
+    holdStreaming,
+    resumeStreaming,
+    pauseStreaming,
+    getNoiseSummary,
+    resetNoise,
     maxBufferSize,
     setMaxBufferSize,
   };
@@ -1,122 +1,229 @@
 import { useState, useCallback, useEffect, useMemo } from 'react';
 import { compareVersions } from '../lib/utils';
+import { createUf2ValidationStream } from '../lib/uf2';
+import { waitForSerialEvent, startPhase } from '../lib/device-readiness';
+import {
+  getStoredBootDrive,
+  openBootDriveFile,
+  waitForBootDrive,
+} from '../lib/boot-drive';
+import {
+  loadFirmwareManifest,
+  findRelease,
+  getReleaseUrl,
+  isReleaseCompatible,
+  type FirmwareManifest,
+  type FirmwareRelease,
+} from '../lib/firmware-manifest';
+import { getStoredFirmware, listStoredFirmware, precacheFirmware } from '../lib/firmware-store';
 import { useSearchParams } from 'react-router-dom';
 
 export interface FirmwareInfo {
   version: string;
   firmwareUrl: string;
   firmwareName: string;
+  size: number;
+  sha256: string;
+  compatible: boolean;   // Can be installed over the current firmware
+  offline: boolean;      // A verified copy is stored locally
 }
 
+// Upper bounds only; each phase continues as soon as the device is ready
+const BOOTSEL_TIMEOUT_MS = 5000;
+const DRIVE_MOUNT_TIMEOUT_MS = 10000;
+
+const PIN_STORAGE_KEY = 'itaiko-firmware-pin';
+
 export type UpdateStatus = 'idle' | 'checking' | 'available' | 'downloading' | 'rebooting' | 'waiting_for_device' | 'flashing' | 'writing' | 'complete' | 'error' | 'manual_action_required';
 
+// 'available' is derived from the manifest, the pin and the installed version
+type UpdatePhase = Exclude<UpdateStatus, 'available'>;
+
 export function useFirmwareUpdate(currentVersion?: string) {
-  const [status, setStatus] = useState<UpdateStatus>('idle');
-  const [latestFirmware, setLatestFirmware] = useState<FirmwareInfo | null>(null);
+  const [phase, setPhase] = useState<UpdatePhase>('idle');
+  const [manifest, setManifest] = useState<FirmwareManifest | null>(null);
+  const [manifestOffline, setManifestOffline] = useState(false);
+  const [storedHashes, setStoredHashes] = useState<Set<string>>(() => new Set());
+  const [pinnedVersion, setPinnedVersionState] = useState<string | null>(() => localStorage.getItem(PIN_STORAGE_KEY));
+  const [selectedVersion, setSelectedVersion] = useState<string | null>(null);  // One-off choice (reinstall, rollback)
   const [error, setError] = useState<string | null>(null);
   const [progress, setProgress] = useState<number>(0);
+  const [bytesWritten, setBytesWritten] = useState<number>(0);
   const [searchParams] = useSearchParams();
 
   const forceUpdate = useMemo(() => searchParams.get('update') === 'true', [searchParams]);
 
+  const toInfo = useCallback((release: FirmwareRelease): FirmwareInfo => ({
+    version: release.version,
+    firmwareUrl: getReleaseUrl(release),
+    firmwareName: release.file,
+    size: release.size,
+    sha256: release.sha256,
+    compatible: isReleaseCompatible(release, currentVersion),
+    offline: storedHashes.has(release.sha256.toLowerCase()),
+  }), [currentVersion, storedHashes]);
+
+  const releases = useMemo(() => manifest?.releases.map(toInfo) ?? [], [manifest, toInfo]);
+
+  // Release the update flow installs: the explicit choice, else the pin, else the latest
+  const latestFirmware = useMemo(() => {
+    if (!manifest) return null;
+    const release =
+      findRelease(manifest, selectedVersion ?? pinnedVersion ?? manifest.latest) ??
+      findRelease(manifest, manifest.latest);
+    return release ? toInfo(release) : null;
+  }, [manifest, selectedVersion, pinnedVersion, toInfo]);
+
+  // A newer release, or a pinned one that differs from what is installed
+  const isUpdateAvailable = useMemo(() => {
+    if (!currentVersion || !manifest) return false;
+    const target = findRelease(manifest, pinnedVersion ?? manifest.latest);
+    if (!target || !isReleaseCompatible(target, currentVersion)) return forceUpdate;
+    const cmp = compareVersions(target.version, currentVersion);
+    return forceUpdate || (pinnedVersion ? cmp !== 0 : cmp > 0);
+  }, [currentVersion, manifest, pinnedVersion, forceUpdate]);
+
+  const status: UpdateStatus = phase === 'idle' && isUpdateAvailable ? 'available' : phase;
+
   const checkUpdate = useCallback(async () => {
     // Reset state if currentVersion is undefined or empty
     if (!currentVersion) {
-      setStatus('idle');
-      setLatestFirmware(null);
+      setPhase('idle');
       return;
     }
 
-    setStatus('checking');
+    setPhase('checking');
     setError(null);
 
     try {
-      // Fetch version from local firmware folder
-      const response = await fetch('/firmware/version.txt');
-      if (!response.ok) {
-        throw new Error('Failed to fetch firmware version');
-      }
-      const latestVersion = (await response.text()).trim();
-
-      const firmwareInfo: FirmwareInfo = {
-        version: latestVersion,
-        firmwareUrl: '/firmware/ITAIKO.uf2',
-        firmwareName: 'ITAIKO.uf2',
-      };
-
-      if (forceUpdate || compareVersions(latestVersion, currentVersion) > 0) {
-        setStatus('available');
-        setLatestFirmware(firmwareInfo);
-      } else {
-        setStatus('idle');
-      }
+      const { manifest, offline } = await loadFirmwareManifest();
+      setManifest(manifest);
+      setManifestOffline(offline);
     } catch (err) {
       console.error('Error checking for firmware update:', err);
       setError(err instanceof Error ? err.message : 'Unknown error');
-      setStatus('idle');
     }
-  }, [currentVersion, forceUpdate]);
+    setPhase('idle');
+  }, [currentVersion]);
 
-  // Automatically check when currentVersion changes and is defined, or when forceUpdate changes
+  // Automatically check when currentVersion changes and is defined
   useEffect(() => {
     if (currentVersion) {
       checkUpdate();
     }
-  }, [currentVersion, checkUpdate, forceUpdate]);
+  }, [currentVersion, checkUpdate]);
+
+  // Keep the latest and the pinned release available offline
+  useEffect(() => {
+    if (!manifest) return;
+    const keep = [manifest.latest, pinnedVersion]
+      .map((v) => (v ? findRelease(manifest, v) : null))
+      .filter((r, i, all): r is FirmwareRelease => r !== null && all.indexOf(r) === i);
+
+    let cancelled = false;
+    precacheFirmware(keep)
+      .then((result) => {
+        result.failed.forEach((f) => console.warn(`Firmware precache failed (${f.sha256}):`, f.error));
+        return listStoredFirmware();
+      })
+      .then((hashes) => {
+        if (!cancelled) setStoredHashes(hashes);
+      })
+      .catch((err) => console.warn('Firmware precache failed:', err));
+    return () => {
+      cancelled = true;
+    };
+  }, [manifest, pinnedVersion]);
 
-  const installUpdate = useCallback(async (rebootCallback: () => Promise<void>) => {
-    if (!latestFirmware) return;
+  const setPinnedVersion = useCallback((version: string | null) => {
+    if (version) localStorage.setItem(PIN_STORAGE_KEY, version);
+    else localStorage.removeItem(PIN_STORAGE_KEY);
+    setPinnedVersionState(version);
+    setSelectedVersion(null);
+  }, []);
 
-    let blob: Blob | null = null;
+  // Resolves true once the image has been handed over (written to the drive
+  // or downloaded for a manual copy)
+  const installUpdate = useCallback(async (rebootCallback: () => Promise<void>): Promise<boolean> => {
+    if (!latestFirmware) return false;
+
+    // The image is validated while it streams (UF2 blocks, size, SHA-256).
+    // A bad image errors the pipe before its last block is written, so the
+    // bootloader never completes it.
+    const validated = (body: ReadableStream<Uint8Array>) => {
+      let lastPercent = -1;
+      return body.pipeThrough(createUf2ValidationStream({
+        expectedSize: latestFirmware.size,
+        expectedSha256: latestFirmware.sha256,
+        onProgress: (bytes) => {
+          const percent = Math.floor((bytes / latestFirmware.size) * 100);
+          if (percent === lastPercent) return;
+          lastPercent = percent;
+          setProgress(percent);
+          setBytesWritten(bytes);
+        },
+      }));
+    };
 
     try {
-      // 1. Download from local firmware folder
-      setStatus('downloading');
+      // 1. Open the image: the verified local copy when there is one (works
+      // offline), else start the download. Only the headers are awaited, so a
+      // missing file or no network fails before the device is rebooted.
+      setPhase('downloading');
       setProgress(0);
+      setBytesWritten(0);
 
-      const response = await fetch(latestFirmware.firmwareUrl);
-      if (!response.ok) throw new Error(`Download failed: ${response.status} ${response.statusText}`);
-      blob = await response.blob();
-      setProgress(30);
+      const release = manifest && findRelease(manifest, latestFirmware.version);
+      const stored = release ? await getStoredFirmware(release) : null;
+      let body: ReadableStream<Uint8Array>;
+      if (stored) {
+        console.log(`[update] using local copy of ${latestFirmware.version}`);
+        body = stored.stream();
+      } else {
+        const response = await fetch(latestFirmware.firmwareUrl);
+        if (!response.ok || !response.body) throw new Error(`Download failed: ${response.status} ${response.statusText}`);
+        body = response.body;
+      }
 
-      // 2. Reboot
-      setStatus('rebooting');
+      // 2. Reboot. Listen first: the port can vanish before the command returns.
+      setPhase('rebooting');
+      const storedDrive = getStoredBootDrive();
+      const portGone = waitForSerialEvent('disconnect', BOOTSEL_TIMEOUT_MS);
+      const rebootPhase = startPhase('update', 'reboot to BOOTSEL');
       await rebootCallback();
-      setProgress(50);
 
-      // 3. Wait for the device to reboot into bootloader mode
-      setStatus('waiting_for_device');
+      // 3. Wait for the device to reboot into bootloader mode. It leaves as a
+      // serial port and comes back as the RPI-RP2 drive (USB Mass Storage).
+      setPhase('waiting_for_device');
+      rebootPhase.end((await portGone) ? 'port removed' : 'no disconnect event');
 
-      // Wait for the device to fully reboot into bootloader mode
-      // The RP2040 bootloader appears as USB Mass Storage (RPI-RP2 drive), not WebUSB
-      // We wait a fixed time to ensure the device has completed the reboot
-      await new Promise(resolve => setTimeout(resolve, 3000));
+      let drive = await storedDrive;
+      if (drive) {
+        const mountPhase = startPhase('update', 'RPI-RP2 mount');
+        const mounted = await waitForBootDrive(drive, true, DRIVE_MOUNT_TIMEOUT_MS);
+        mountPhase.end(mounted ? 'INFO_UF2.TXT found' : 'timed out');
+        if (!mounted) drive = null;
+      }
 
-      // 4. Flash (Save File via File System Access API)
-      setStatus('flashing');
+      // 4. Flash: write straight to the remembered drive, otherwise ask for it
+      // (File System Access API, Chromium)
+      setPhase('flashing');
 
-      // Check if File System Access API is supported (Chromium)
       if ('showSaveFilePicker' in window) {
-        // @ts-expect-error - showSaveFilePicker is not in standard types yet
-        const handle = await window.showSaveFilePicker({
-          suggestedName: latestFirmware.firmwareName,
-          types: [{
-            description: 'UF2 Firmware',
-            accept: { 'application/x-uf2': ['.uf2'] },
-          }],
-        });
-
-        // 5. Write to device
-        setStatus('writing');
-        const writable = await handle.createWritable();
-        await writable.write(blob);
-        await writable.close();
+        const { writable } = await openBootDriveFile(latestFirmware.firmwareName, drive);
+
+        // 5. Stream to the device; pipeTo closes the file on success
+        setPhase('writing');
+        const writePhase = startPhase('update', 'write');
+        await validated(body).pipeTo(writable);
+        writePhase.end(`${latestFirmware.size} bytes`);
 
         setProgress(100);
-        setStatus('complete');
+        setPhase('complete');
       } else {
-        // Fallback for Firefox / others: Manual download
-        setStatus('manual_action_required');
+        // Fallback for Firefox / others: Manual download (validated before it is offered)
+        const blob = await new Response(validated(body)).blob();
+        setPhase('manual_action_required');
         
         const url = window.URL.createObjectURL(blob);
         const a = document.createElement('a');
@@ -127,20 +234,28 @@ export function useFirmwareUpdate(currentVersion?: string) {
         document.body.removeChild(a);
         window.URL.revokeObjectURL(url);
       }
+      return true;
 
     } catch (err) {
       console.error('Update failed:', err);
       setError(err instanceof Error ? err.message : 'Update failed');
-      setStatus('error');
+      setPhase('error');
+      return false;
     }
-  }, [latestFirmware]);
+  }, [latestFirmware, manifest]);
 
   return {
-    isUpdateAvailable: status === 'available',
+    isUpdateAvailable,
     status,
     latestFirmware,
+    releases,
+    manifestOffline,
+    pinnedVersion,
+    setPinnedVersion,
+    selectVersion: setSelectedVersion,
     error,
     progress,
+    bytesWritten,
     checkUpdate,
     installUpdate
   };
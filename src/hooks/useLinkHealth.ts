@@ -0,0 +1,78 @@
+import { useEffect, useState, useSyncExternalStore } from "react";
+import {
+  HEARTBEAT_MS,
+  createLinkHealth,
+  getLinkLimits,
+  recordLineRate,
+  recordRtt,
+  resetLineRate,
+  subscribeLinkLimits,
+  summarizeLinkHealth,
+  type LinkHealthSummary,
+} from "@/lib/link-health";
+
+interface UseLinkHealthProps {
+  probeLatency: () => Promise<number | null | undefined>;
+  addLineListener: (listener: (line: string) => void) => () => void;
+  isReady: boolean;
+  isStreaming: boolean;
+  heartbeat: boolean;  // Only where the port is open (see DeviceSessionOptions)
+}
+
+const RATE_INTERVAL_MS = 1000;
+
+// Heartbeat and stream rate tracking for one session (see link-health)
+export function useLinkHealth({ probeLatency, addLineListener, isReady, isStreaming, heartbeat }: UseLinkHealthProps): LinkHealthSummary {
+  const [health] = useState(createLinkHealth);
+  const limits = useSyncExternalStore(subscribeLinkLimits, getLinkLimits);
+  const [summary, setSummary] = useState(() => summarizeLinkHealth(health, limits));
+
+  // Re-judged at once when the limits are edited
+  const [summaryLimits, setSummaryLimits] = useState(limits);
+  if (summaryLimits !== limits) {
+    setSummaryLimits(limits);
+    setSummary(summarizeLinkHealth(health, limits));
+  }
+
+  // Heartbeat while the drum is ready; skipped in background tabs
+  useEffect(() => {
+    if (!isReady || !heartbeat) return;
+    let cancelled = false;
+    const beat = async () => {
+      if (document.hidden) return;
+      const rtt = await probeLatency();
+      if (cancelled || rtt === undefined) return;
+      recordRtt(health, rtt);
+      setSummary(summarizeLinkHealth(health, getLinkLimits()));
+    };
+    const timer = setInterval(beat, HEARTBEAT_MS);
+    return () => {
+      cancelled = true;
+      clearInterval(timer);
+    };
+  }, [isReady, heartbeat, probeLatency, health]);
+
+  // Lines per second while streaming
+  useEffect(() => {
+    if (!isStreaming) return;
+    let lines = 0;
+    let windowStart = performance.now();
+    const removeListener = addLineListener(() => {
+      lines++;
+    });
+    const timer = setInterval(() => {
+      const now = performance.now();
+      recordLineRate(health, (lines * 1000) / (now - windowStart));
+      lines = 0;
+      windowStart = now;
+      setSummary(summarizeLinkHealth(health, getLinkLimits()));
+    }, RATE_INTERVAL_MS);
+    return () => {
+      removeListener();
+      clearInterval(timer);
+      resetLineRate(health);
+    };
+  }, [isStreaming, addLineListener, health]);
+
+  return summary;
+}
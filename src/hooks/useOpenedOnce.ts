@@ -0,0 +1,9 @@
+import { useState } from "react";
+
+// True from the first time `open` is true. Lazily loaded dialogs are mounted
+// once they are needed and then stay mounted for their close animation.
+export function useOpenedOnce(open: boolean): boolean {
+  const [opened, setOpened] = useState(open);
+  if (open && !opened) setOpened(true);
+  return opened || open;
+}
@@ -0,0 +1,137 @@
+import { useCallback, useEffect, useRef, useState } from "react";
+import type { DeviceCommand, SerialIO } from "@/types";
+import { PICO_VENDOR_ID } from "@/types";
+import type { UseWebSerialReturn } from "./useWebSerial";
+import { createLineRouter } from "@/lib/line-router";
+import type { SerialShare, SharedDeviceState, ShareMessage, ShareRequest } from "@/lib/serial-share";
+
+// Follower side of tab sharing: the same interface as useWebSerial, backed by
+// the leader tab. Lines arrive in batches over the share channel and are
+// routed locally; commands are answered once the leader has written them.
+
+const REQUEST_TIMEOUT_MS = 10000;
+
+interface PendingRequest {
+  resolve: () => void;
+  reject: (err: Error) => void;
+}
+
+export function useRemoteSerial(share: SerialShare, device: SharedDeviceState): UseWebSerialReturn {
+  const [lines] = useState(createLineRouter);
+  const [isReading, setIsReading] = useState(false);
+  const port = useRef<SerialPort | null>(null);  // The port lives in the leader tab
+  const [pending] = useState(() => new Map<number, PendingRequest>());
+  const nextIdRef = useRef(1);
+
+  useEffect(() => {
+    const onMessage = (event: MessageEvent<ShareMessage>) => {
+      const message = event.data;
+      if (message.type === "lines" && message.device === device.id) {
+        for (const line of message.lines) lines.push(line);
+      } else if (message.type === "done" && message.to === share.tabId) {
+        const request = pending.get(message.id);
+        if (!request) return;
+        pending.delete(message.id);
+        if (message.ok) request.resolve();
+        else request.reject(new Error(message.error ?? "Request failed"));
+      }
+    };
+    share.channel.addEventListener("message", onMessage);
+    return () => share.channel.removeEventListener("message", onMessage);
+  }, [share, device.id, lines, pending]);
+
+  // Lost along with the leader's connection
+  useEffect(() => {
+    if (device.status === "connected") return;
+    lines.cancelWaiters();
+    lines.clear();
+    pending.forEach((request) => request.reject(new Error("Not connected")));
+    pending.clear();
+  }, [device.status, lines, pending]);
+
+  const request = useCallback((body: ShareRequest): Promise<void> => {
+    const id = nextIdRef.current++;
+    return new Promise<void>((resolve, reject) => {
+      const timer = setTimeout(() => {
+        pending.delete(id);
+        reject(new Error("The tab connected to the drum did not answer"));
+      }, REQUEST_TIMEOUT_MS);
+      pending.set(id, {
+        resolve: () => {
+          clearTimeout(timer);
+          resolve();
+        },
+        reject: (err) => {
+          clearTimeout(timer);
+          reject(err);
+        },
+      });
+      share.channel.postMessage({ ...body, from: share.tabId, id, device: device.id } satisfies ShareMessage);
+    });
+  }, [share, device.id, pending]);
+
+  const sendCommand = useCallback(
+    (command: DeviceCommand, data?: string) => request({ type: "command", command, data }),
+    [request]
+  );
+
+  const sendBinary = useCallback((data: Uint8Array) => request({ type: "binary", data }), [request]);
+
+  // The leader holds the port for this tab until fn returns
+  const exclusive = useCallback(async <T,>(fn: (io: SerialIO) => Promise<T>): Promise<T> => {
+    await request({ type: "lease" });
+    try {
+      return await fn({ sendCommand, sendBinary, desiredSize: () => null, ready: () => Promise.resolve() });
+    } finally {
+      request({ type: "release" }).catch(console.warn);
+    }
+  }, [request, sendCommand, sendBinary]);
+
+  const connect = useCallback(() => request({ type: "connect" }).then(() => true, () => false), [request]);
+  const disconnect = useCallback(() => request({ type: "disconnect" }).catch(console.warn), [request]);
+
+  // The permission is per origin: let the leader pick the port up. It opens
+  // it itself, so the caller has nothing to connect.
+  const requestPort = useCallback(async (): Promise<SerialPort | null> => {
+    try {
+      await navigator.serial.requestPort({ filters: [{ usbVendorId: PICO_VENDOR_ID }] });
+      share.channel.postMessage({ type: "rescan", from: share.tabId } satisfies ShareMessage);
+    } catch (err) {
+      if (err instanceof Error && err.name !== "NotFoundError") console.error("Failed to request port:", err);
+    }
+    return null;
+  }, [share]);
+
+  const startReading = useCallback((onData: (line: string) => void) => {
+    lines.clear();
+    lines.onData = onData;
+    setIsReading(true);
+  }, [lines]);
+
+  const stopReading = useCallback(() => {
+    lines.onData = null;
+    setIsReading(false);
+  }, [lines]);
+
+  return {
+    status: device.status,
+    error: device.error,
+    isSupported: true,
+    port,
+    hasAuthorizedDevice: device.hasPort,
+    requestPort,
+    connect,
+    disconnect,
+    sendCommand,
+    sendBinary,
+    exclusive,
+    readLine: lines.readLine,
+    readUntilTimeout: lines.readUntilTimeout,
+    waitForLine: lines.waitForLine,
+    clearBuffer: lines.clear,
+    startReading,
+    stopReading,
+    isReading,
+    addLineListener: lines.listen,
+  };
+}
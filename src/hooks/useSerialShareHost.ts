@@ -0,0 +1,138 @@
+import { useEffect, useMemo } from "react";
+import type { DeviceCommand, SerialIO } from "@/types";
+import type { UseWebSerialReturn } from "./useWebSerial";
+import { createStreamArbiter } from "@/lib/stream-arbiter";
+import { LINE_BATCH_MS, type SerialShare, type ShareMessage } from "@/lib/serial-share";
+
+// Lease held by a follower for longer than this is given up (tab crashed)
+const LEASE_TIMEOUT_MS = 30000;
+
+interface Lease {
+  io: SerialIO;
+  release: () => void;
+}
+
+// Leader side of tab sharing for one device: relays received lines to the
+// followers and runs their requests through this tab's transport. Streaming
+// commands from every tab, this one included, go through one arbiter so a
+// tab stopping its monitor does not stop another tab's.
+export function useSerialShareHost(
+  share: SerialShare | null,
+  device: number,
+  relay: boolean,
+  serial: UseWebSerialReturn
+): UseWebSerialReturn {
+  const { sendCommand, sendBinary, exclusive, connect, disconnect, addLineListener, status } = serial;
+  const arbiter = useMemo(() => createStreamArbiter(sendCommand), [sendCommand]);
+
+  // The device forgot its streaming state
+  useEffect(() => {
+    if (status !== "connected") arbiter.reset();
+  }, [status, arbiter]);
+
+  // Received lines, batched per frame
+  useEffect(() => {
+    if (!share || !relay) return;
+    let pending: string[] = [];
+    let timer: ReturnType<typeof setTimeout> | null = null;
+
+    const flush = () => {
+      timer = null;
+      const lines = pending;
+      pending = [];
+      share.channel.postMessage({ type: "lines", device, lines } satisfies ShareMessage);
+    };
+    const unlisten = addLineListener((line) => {
+      pending.push(line);
+      if (timer === null) timer = setTimeout(flush, LINE_BATCH_MS);
+    });
+
+    return () => {
+      unlisten();
+      if (timer !== null) clearTimeout(timer);
+    };
+  }, [share, relay, device, addLineListener]);
+
+  // Follower requests
+  useEffect(() => {
+    if (!share) return;
+    const leases = new Map<string, Lease>();
+
+    const reply = (to: string, id: number, error?: unknown) => {
+      const message: ShareMessage = error === undefined
+        ? { type: "done", to, id, ok: true }
+        : { type: "done", to, id, ok: false, error: error instanceof Error ? error.message : String(error) };
+      share.channel.postMessage(message);
+    };
+
+    const acquire = (from: string) =>
+      new Promise<void>((granted) => {
+        exclusive((io) =>
+          new Promise<void>((release) => {
+            const timer = setTimeout(release, LEASE_TIMEOUT_MS);
+            leases.set(from, {
+              io,
+              release: () => {
+                clearTimeout(timer);
+                release();
+              },
+            });
+            granted();
+          })
+        ).catch(console.warn);
+      });
+
+    const releaseLease = (from: string) => {
+      leases.get(from)?.release();
+      leases.delete(from);
+    };
+
+    const handle = async (message: ShareMessage & { from: string; id: number }) => {
+      const lease = leases.get(message.from);
+      switch (message.type) {
+        case "command":
+          return lease
+            ? lease.io.sendCommand(message.command, message.data)
+            : arbiter.command(message.from, message.command, message.data);
+        case "binary":
+          return lease ? lease.io.sendBinary(message.data) : sendBinary(message.data);
+        case "connect":
+          if (!(await connect())) throw new Error("Could not connect");
+          return;
+        case "disconnect":
+          return disconnect();
+        case "lease":
+          return acquire(message.from);
+        case "release":
+          return releaseLease(message.from);
+      }
+    };
+
+    const onMessage = (event: MessageEvent<ShareMessage>) => {
+      const message = event.data;
+      if (message.type === "bye") {
+        releaseLease(message.from);
+        arbiter.release(message.from).catch(() => {});
+        return;
+      }
+      if (!("id" in message) || !("device" in message) || message.device !== device) return;
+      handle(message).then(
+        () => reply(message.from, message.id),
+        (err) => reply(message.from, message.id, err ?? "Failed")
+      );
+    };
+
+    share.channel.addEventListener("message", onMessage);
+    return () => {
+      share.channel.removeEventListener("message", onMessage);
+      leases.forEach((lease) => lease.release());
+    };
+  }, [share, device, arbiter, sendBinary, exclusive, connect, disconnect]);
+
+  const ownCommand = useMemo(
+    () => (share ? (command: DeviceCommand, data?: string) => arbiter.command(share.tabId, command, data) : sendCommand),
+    [share, arbiter, sendCommand]
+  );
+
+  return { ...serial, sendCommand: ownCommand };
+}
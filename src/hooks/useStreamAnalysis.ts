@@ -0,0 +1,52 @@
+import { useCallback, useEffect, useRef } from "react";
+import type {
+  StreamAnalysisJobs,
+  StreamAnalysisKind,
+  StreamAnalysisResponse,
+} from "@/workers/stream-analysis.worker";
+
+type Pending = { resolve: (result: never) => void; reject: (error: Error) => void };
+
+// Runs session analyses in a worker that is started on first use and ended
+// with the component. Frames are copied to the worker, so callers can keep
+// them to run again with other settings.
+export function useStreamAnalysis() {
+  const workerRef = useRef<Worker | null>(null);
+  const pendingRef = useRef(new Map<number, Pending>());
+  const requestIdRef = useRef(0);
+
+  useEffect(() => {
+    const pending = pendingRef.current;
+    return () => {
+      workerRef.current?.terminate();
+      workerRef.current = null;
+      pending.forEach(({ reject }) => reject(new Error("Analysis cancelled")));
+      pending.clear();
+    };
+  }, []);
+
+  return useCallback(<K extends StreamAnalysisKind>(
+    kind: K,
+    input: StreamAnalysisJobs[K]["input"],
+  ): Promise<StreamAnalysisJobs[K]["result"]> => {
+    if (!workerRef.current) {
+      const worker = new Worker(new URL("../workers/stream-analysis.worker.ts", import.meta.url), { type: "module" });
+      worker.onmessage = (event: MessageEvent<StreamAnalysisResponse>) => {
+        const response = event.data;
+        const pending = pendingRef.current.get(response.id);
+        if (!pending) return;
+        pendingRef.current.delete(response.id);
+        if (response.type === "result") pending.resolve(response.result as never);
+        else pending.reject(new Error(response.message));
+      };
+      workerRef.current = worker;
+    }
+
+    const worker = workerRef.current;
+    const id = ++requestIdRef.current;
+    return new Promise((resolve, reject) => {
+      pendingRef.current.set(id, { resolve, reject });
+      worker.postMessage({ id, kind, input });
+    });
+  }, []);
+}
@@ -1,34 +1,72 @@
 import { useState, useCallback, useRef, type RefObject, useEffect } from "react";
-import type { ConnectionStatus, DeviceCommand } from "@/types";
-import { PICO_VENDOR_ID, BAUD_RATE } from "@/types";
+import type { ConnectionStatus, DeviceCommand, SerialIO } from "@/types";
+import { PICO_VENDOR_ID, BAUD_RATE, DeviceCommand as DeviceCommandValues } from "@/types";
 import { encodeCommand } from "@/lib/serial-protocol";
+import { createSerialWriteQueue } from "@/lib/serial-write-queue";
+import { createLineRouter } from "@/lib/line-router";
+import { perfEnabled, recordIngest } from "@/lib/perf-metrics";
+import { traceRxEnabled, traceTxEnabled, traceRx, traceTx } from "@/lib/serial-trace";
+
+// Sending these twice in a row has the same effect as sending them once
+const COALESCED_COMMANDS = new Set<DeviceCommand>([
+  DeviceCommandValues.START_STREAMING,
+  DeviceCommandValues.STOP_STREAMING,
+  DeviceCommandValues.START_INPUT_STREAMING,
+  DeviceCommandValues.SAVE_TO_FLASH,
+]);
+
+function formatCommand(command: DeviceCommand, data?: string): string {
+  return data ? `${command}\n${data}\n` : `${command}\n`;
+}
+
+// Large chunks are parsed in slices so one busy port cannot hold up the read
+// loops of other connected devices or rendering
+const READ_SLICE_MS = 4;
+
+const yieldToEventLoop = () => new Promise<void>((resolve) => setTimeout(resolve, 0));
+
+// After the device is lost (unplugged, USB hub glitch) its port is reopened
+// with backoff. A connect event, which reassigns the port, retries at once.
+const RECONNECT_DELAYS_MS = [100, 250, 500, 1000, 2000, 4000];
+const RECONNECT_MAX_ATTEMPTS = 12;  // About 30 s
 
-interface UseWebSerialReturn {
+// One serial session's port, assigned by the device manager
+export interface SerialPortBinding {
+  id: number;                              // Session id, tags trace records
+  port: SerialPort | null;
+  attached: number;                        // Bumped when the port (re)appears
+  claim: (port: SerialPort) => boolean;    // False if another session owns it
+}
+
+export interface UseWebSerialReturn {
   status: ConnectionStatus;
   error: string | null;
   isSupported: boolean;
   port: RefObject<SerialPort | null>;
   hasAuthorizedDevice: boolean;
   requestPort: () => Promise<SerialPort | null>;
-  findAuthorizedPort: () => Promise<SerialPort | null>;
   connect: () => Promise<boolean>;
   disconnect: () => Promise<void>;
   sendCommand: (command: DeviceCommand, data?: string) => Promise<void>;
   sendBinary: (data: Uint8Array) => Promise<void>;
+  exclusive: <T>(fn: (io: SerialIO) => Promise<T>) => Promise<T>;
   readLine: () => Promise<string | null>;
   readUntilTimeout: (timeoutMs?: number) => Promise<string>;
+  waitForLine: (match: (line: string) => boolean, timeoutMs?: number) => Promise<string | null>;
   clearBuffer: () => void;
   startReading: (onData: (line: string) => void) => void;
   stopReading: () => void;
   isReading: boolean;
+  // Every received line, before it is routed (cross-tab sharing)
+  addLineListener: (listener: (line: string) => void) => () => void;
 }
 
-export function useWebSerial(): UseWebSerialReturn {
+export function useWebSerial(binding: SerialPortBinding): UseWebSerialReturn {
   const [status, setStatus] = useState<ConnectionStatus>("disconnected");
   const [error, setError] = useState<string | null>(null);
   const port = useRef<SerialPort | null>(null);
   const [isReading, setIsReading] = useState(false);
-  const [hasAuthorizedDevice, setHasAuthorizedDevice] = useState(false);
+  const hasAuthorizedDevice = binding.port !== null;
 
   // We use a ReadableStream reader that returns strings directly
   const readerRef = useRef<ReadableStreamDefaultReader<string> | null>(null);
@@ -38,8 +76,15 @@ export function useWebSerial(): UseWebSerialReturn {
   const decoderReadableStreamRef = useRef<ReadableStream<string> | null>(null);
   const inputDoneRef = useRef<Promise<void> | null>(null);
 
-  const lineQueueRef = useRef<string[]>([]);
-  const onDataCallbackRef = useRef<((line: string) => void) | null>(null);
+  // All writes are serialized through one queue
+  const [writeQueue] = useState(() =>
+    createSerialWriteQueue((data) => {
+      if (!writerRef.current) return Promise.reject(new Error("Not connected"));
+      return writerRef.current.write(data);
+    })
+  );
+
+  const [lines] = useState(createLineRouter);
   const loopRunningRef = useRef(false);
 
   const isSupported = typeof navigator !== "undefined" && "serial" in navigator;
@@ -47,65 +92,47 @@ export function useWebSerial(): UseWebSerialReturn {
   // Track if we're in the middle of a user-initiated disconnect
   const disconnectingRef = useRef(false);
 
-  // Ref to track if component is mounted (for cleanup)
-  const isMountedRef = useRef(true);
+  // True while port.open() is in progress
+  const connectingRef = useRef(false);
 
-  // Check for authorized ports on mount and set up event listeners
-  useEffect(() => {
-    isMountedRef.current = true;
-
-    if (!isSupported) return;
-
-    const checkAuthorizedPorts = async () => {
-      if (!isMountedRef.current) return;
-
-      try {
-        const ports = await navigator.serial.getPorts();
-        const authorized = ports.some(p => p.getInfo().usbVendorId === PICO_VENDOR_ID);
-        setHasAuthorizedDevice(authorized);
-
-        // Auto-connect if we found a port and aren't connected
-        if (authorized && !port.current && status === 'disconnected') {
-           const p = ports.find(p => p.getInfo().usbVendorId === PICO_VENDOR_ID);
-           if (p) {
-             port.current = p;
-             connect();
-           }
-        }
-      } catch (e) {
-        console.error("Failed to check ports:", e);
-      }
-    };
+  // Attempts since the device was lost; 0 when not reconnecting
+  const reconnectRef = useRef<{ attempt: number; timer: ReturnType<typeof setTimeout> | null }>({ attempt: 0, timer: null });
+  const connectRef = useRef<() => Promise<boolean>>(async () => false);
 
-    checkAuthorizedPorts();
-
-    const handleConnect = () => {
-       // When a device is connected, check if it's ours and try to connect
-       checkAuthorizedPorts();
-    };
-
-    const handleDisconnect = () => {
-       checkAuthorizedPorts();
-    };
-
-    navigator.serial.addEventListener('connect', handleConnect);
-    navigator.serial.addEventListener('disconnect', handleDisconnect);
+  const cancelReconnect = useCallback(() => {
+    const reconnect = reconnectRef.current;
+    if (reconnect.timer !== null) clearTimeout(reconnect.timer);
+    reconnect.timer = null;
+    reconnect.attempt = 0;
+  }, []);
 
-    return () => {
-      isMountedRef.current = false;
-      navigator.serial.removeEventListener('connect', handleConnect);
-      navigator.serial.removeEventListener('disconnect', handleDisconnect);
-    };
-  }, [isSupported]); // We intentionally leave 'connect' and 'status' out to avoid loops, as checkAuthorizedPorts handles the logic safely
+  const scheduleReconnect = useCallback(() => {
+    const reconnect = reconnectRef.current;
+    if (reconnect.timer !== null) return;
+    if (reconnect.attempt >= RECONNECT_MAX_ATTEMPTS) {
+      reconnect.attempt = 0;
+      setStatus("disconnected");
+      setError("Device disconnected");
+      return;
+    }
+    const delay = RECONNECT_DELAYS_MS[Math.min(reconnect.attempt, RECONNECT_DELAYS_MS.length - 1)];
+    reconnect.attempt++;
+    setStatus("reconnecting");
+    reconnect.timer = setTimeout(() => {
+      reconnect.timer = null;
+      connectRef.current();  // Schedules the next attempt if it fails
+    }, delay);
+  }, []);
 
   // Cleanup: disconnect when the hook unmounts
   useEffect(() => {
     return () => {
+      cancelReconnect();
       // Disconnect serial port on unmount to prevent orphaned connections
       if (port.current) {
         disconnectingRef.current = true;
         loopRunningRef.current = false;
-        onDataCallbackRef.current = null;
+        lines.onData = null;
 
         const cleanup = async () => {
           try {
@@ -151,43 +178,58 @@ export function useWebSerial(): UseWebSerialReturn {
           if (done) break;
 
           if (value) {
+            let sliceStart = performance.now();
+            let parseMs = 0;
+            let lineCount = 0;
             buffer += value;
             let newlineIndex;
             // Process lines
             while ((newlineIndex = buffer.indexOf("\n")) !== -1) {
+              const now = performance.now();
+              if (now - sliceStart > READ_SLICE_MS) {
+                parseMs += now - sliceStart;
+                await yieldToEventLoop();
+                if (!loopRunningRef.current) break;
+                sliceStart = performance.now();
+              }
               const line = buffer.slice(0, newlineIndex).trim();
               buffer = buffer.slice(newlineIndex + 1);
 
               if (line) {
-                if (new URLSearchParams(window.location.search).get("rx") === "true") {
-                  console.log(`[Serial RX] ${line}`);
-                }
-
-                if (onDataCallbackRef.current) {
-                  onDataCallbackRef.current(line);
-                } else {
-                  lineQueueRef.current.push(line);
-                  if (lineQueueRef.current.length > 1000) {
-                    lineQueueRef.current.shift();
-                  }
-                }
+                lineCount++;
+                if (traceRxEnabled) traceRx(binding.id, line);
+                lines.push(line);
               }
             }
+
+            if (perfEnabled) {
+              parseMs += performance.now() - sliceStart;
+              recordIngest(lineCount, value.length, parseMs, lines.queued);
+            }
           }
         } catch (err) {
-          // Device was unplugged or lost - trigger disconnect if not already disconnecting
+          // Device was unplugged or lost - reconnect if not already disconnecting
           if (!disconnectingRef.current) {
             console.error("Device lost:", err);
             loopRunningRef.current = false;
-            onDataCallbackRef.current = null;
+            lines.onData = null;
             setIsReading(false);
+            const inputDone = inputDoneRef.current;
+            const writer = writerRef.current;
             decoderReadableStreamRef.current = null;
             inputDoneRef.current = null;
             readerRef.current = null;
             writerRef.current = null;
-            lineQueueRef.current = [];
-            setStatus("disconnected");
-            setError("Device disconnected");
+            writeQueue.clear(new Error("Device disconnected"));
+            lines.cancelWaiters();
+            lines.clear();
+            setStatus("reconnecting");
+
+            // Close what is left of the port so it can be opened again
+            await inputDone?.catch(() => {});
+            writer?.releaseLock();
+            await port.current?.close().catch(() => {});
+            scheduleReconnect();
           }
           break;
         }
@@ -196,7 +238,7 @@ export function useWebSerial(): UseWebSerialReturn {
     };
 
     readLoop();
-  }, []);
+  }, [binding.id, writeQueue, lines, scheduleReconnect]);
 
   const requestPort = useCallback(async (): Promise<SerialPort | null> => {
     if (!isSupported) {
@@ -207,6 +249,8 @@ export function useWebSerial(): UseWebSerialReturn {
       const selectedPort = await navigator.serial.requestPort({
         filters: [{ usbVendorId: PICO_VENDOR_ID }],
       });
+      // Already open in another session: the manager switches to that one
+      if (!binding.claim(selectedPort)) return null;
       port.current = selectedPort;
       setError(null);
       return selectedPort;
@@ -214,35 +258,24 @@ export function useWebSerial(): UseWebSerialReturn {
       if (err instanceof Error && err.name !== "NotFoundError") setError(err.message);
       return null;
     }
-  }, [isSupported]);
-  
-  const findAuthorizedPort = useCallback(async (): Promise<SerialPort | null> => {
-    if (!isSupported) return null;
-    try {
-      const ports = await navigator.serial.getPorts();
-      const authorized = ports.find(p => {
-        const info = p.getInfo();
-        return info.usbVendorId === PICO_VENDOR_ID;
-      });
-      if (authorized) {
-        port.current = authorized;
-        return authorized;
-      }
-      return null;
-    } catch (err) {
-      console.error("Error finding authorized ports", err);
-      return null;
-    }
-  }, [isSupported]);
+  }, [isSupported, binding.claim]);
 
   const connect = useCallback(async (): Promise<boolean> => {
     if (!port.current) {
       setError("No port selected");
       return false;
     }
+    // Already open, or opening (a connect from another tab)
+    if (connectingRef.current) return false;
+    if (port.current.readable) return true;
+
+    const reconnect = reconnectRef.current;
+    if (reconnect.timer !== null) clearTimeout(reconnect.timer);
+    reconnect.timer = null;
 
+    connectingRef.current = true;
     try {
-      setStatus("connecting");
+      if (reconnect.attempt === 0) setStatus("connecting");
       setError(null);
       await port.current.open({ baudRate: BAUD_RATE });
 
@@ -258,6 +291,7 @@ export function useWebSerial(): UseWebSerialReturn {
         readerRef.current = textDecoder.readable.getReader();
         writerRef.current = port.current.writable.getWriter();
         
+        reconnect.attempt = 0;
         setStatus("connected");
         startReadLoop();
         return true;
@@ -265,17 +299,46 @@ export function useWebSerial(): UseWebSerialReturn {
         throw new Error("Port streams not available");
       }
     } catch (err) {
+      if (reconnect.attempt > 0) {
+        // The device may still be re-enumerating
+        scheduleReconnect();
+        return false;
+      }
       setError(err instanceof Error ? err.message : "Connection failed");
       setStatus("error");
       return false;
+    } finally {
+      connectingRef.current = false;
     }
-  }, [port, startReadLoop]);
+  }, [port, startReadLoop, scheduleReconnect]);
+
+  useEffect(() => {
+    connectRef.current = connect;
+  });
+
+  // The device manager owns port discovery and hands each session its port.
+  // Open it when it is first assigned or comes back after being unplugged;
+  // a port the user just picked is opened by the caller of requestPort.
+  useEffect(() => {
+    const bound = binding.port;
+    if (!bound || connectingRef.current || bound.readable) return;
+    port.current = bound;
+    connect();
+  }, [binding.port, binding.attached]); // connect is stable apart from startReadLoop
 
   const disconnect = useCallback(async (): Promise<void> => {
+    // Stopping a reconnect: the port is already closed
+    if (reconnectRef.current.attempt > 0) {
+      cancelReconnect();
+      setStatus("disconnected");
+      setError(null);
+      return;
+    }
+
     // Mark that we're intentionally disconnecting (prevents read loop from setting error)
     disconnectingRef.current = true;
     loopRunningRef.current = false;
-    onDataCallbackRef.current = null;
+    lines.onData = null;
     setIsReading(false);
 
     try {
@@ -308,60 +371,80 @@ export function useWebSerial(): UseWebSerialReturn {
     }
 
     decoderReadableStreamRef.current = null;
-    lineQueueRef.current = [];
+    writeQueue.clear(new Error("Not connected"));
+    lines.cancelWaiters();
+    lines.clear();
     disconnectingRef.current = false;
     setStatus("disconnected");
     setError(null);
-  }, [port]);
+  }, [port, writeQueue, lines, cancelReconnect]);
 
   const sendCommand = useCallback(async (command: DeviceCommand, data?: string): Promise<void> => {
       if (!writerRef.current) throw new Error("Not connected");
-      const cmdStr = data ? `${command}\n${data}\n` : `${command}\n`;
-      if (new URLSearchParams(window.location.search).get("tx") === "true") {
-        console.log(`[Serial TX] ${cmdStr.trim()}`);
-      }
-      await writerRef.current.write(encodeCommand(cmdStr));
-    }, []);
+      const cmdStr = formatCommand(command, data);
+      if (traceTxEnabled) traceTx(binding.id, cmdStr);
+      const coalesceKey = !data && COALESCED_COMMANDS.has(command) ? cmdStr : undefined;
+      await writeQueue.enqueue(encodeCommand(cmdStr), { priority: "control", coalesceKey });
+    }, [binding.id, writeQueue]);
 
   const sendBinary = useCallback(async (data: Uint8Array): Promise<void> => {
       if (!writerRef.current) throw new Error("Not connected");
-      await writerRef.current.write(data);
-  }, []);
-
-  const readLine = useCallback(async (): Promise<string | null> => {
-    if (lineQueueRef.current.length > 0) return lineQueueRef.current.shift() ?? null;
-    await new Promise((resolve) => setTimeout(resolve, 10));
-    return lineQueueRef.current.shift() ?? null;
-  }, []);
-
-  const clearBuffer = useCallback(() => {
-    lineQueueRef.current = [];
-  }, []);
-
-  const readUntilTimeout = useCallback(async (timeoutMs: number = 500): Promise<string> => {
-      const start = Date.now();
-      const lines: string[] = [];
-      // Do not clear queue here to avoid race conditions with fast responses
-      while (Date.now() - start < timeoutMs) {
-        if (lineQueueRef.current.length) lines.push(lineQueueRef.current.shift()!);
-        else await new Promise((r) => setTimeout(r, 10));
-      }
-      return lines.join("\n");
-    }, []);
+      if (traceTxEnabled) traceTx(binding.id, data);
+      await writeQueue.enqueue(data, { priority: "bulk" });
+  }, [binding.id, writeQueue]);
+
+  // Run fn with the port to itself: queued writes from elsewhere wait until it returns
+  const exclusive = useCallback(<T>(fn: (io: SerialIO) => Promise<T>): Promise<T> => {
+      return writeQueue.exclusive((write) =>
+        fn({
+          sendCommand: async (command, data) => {
+            const cmdStr = formatCommand(command, data);
+            if (traceTxEnabled) traceTx(binding.id, cmdStr);
+            await write(encodeCommand(cmdStr));
+          },
+          sendBinary: async (data) => {
+            if (traceTxEnabled) traceTx(binding.id, data);
+            await write(data);
+          },
+          desiredSize: () => writerRef.current?.desiredSize ?? null,
+          ready: () => writerRef.current?.ready ?? Promise.reject(new Error("Not connected")),
+        })
+      );
+  }, [binding.id, writeQueue]);
 
   const startReading = useCallback((onData: (line: string) => void): void => {
-      lineQueueRef.current = [];
-      onDataCallbackRef.current = onData;
+      lines.clear();
+      lines.onData = onData;
       setIsReading(true);
       if (!loopRunningRef.current && readerRef.current) startReadLoop();
-    }, [startReadLoop]);
+    }, [startReadLoop, lines]);
 
   const stopReading = useCallback((): void => {
-    onDataCallbackRef.current = null;
+    lines.onData = null;
     setIsReading(false);
-  }, []);
-
-    return { status, error, isSupported, port, hasAuthorizedDevice, requestPort, findAuthorizedPort, connect, disconnect, sendCommand, sendBinary, readLine, readUntilTimeout, clearBuffer, startReading, stopReading, isReading };
+  }, [lines]);
+
+    return {
+      status,
+      error,
+      isSupported,
+      port,
+      hasAuthorizedDevice,
+      requestPort,
+      connect,
+      disconnect,
+      sendCommand,
+      sendBinary,
+      exclusive,
+      readLine: lines.readLine,
+      readUntilTimeout: lines.readUntilTimeout,
+      waitForLine: lines.waitForLine,
+      clearBuffer: lines.clear,
+      startReading,
+      stopReading,
+      isReading,
+      addLineListener: lines.listen,
+    };
 
   }
 
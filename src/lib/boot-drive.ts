@@ -0,0 +1,106 @@
+import { idbGet, idbPut } from "@/lib/idb";
+
+// RPI-RP2 bootloader drive
+// The drive the user picked once is remembered (IndexedDB keeps the handle),
+// so later updates can see it mount by polling for INFO_UF2.TXT and write
+// the UF2 without another picker. Browsers without showDirectoryPicker, or
+// a drive the browser refuses to open, fall back to a save dialog.
+
+const HANDLE_KEY = "rpi-rp2";
+const INFO_FILE = "INFO_UF2.TXT";
+const POLL_INTERVAL_MS = 100;
+
+export const isBootDriveSupported = typeof window !== "undefined" && "showDirectoryPicker" in window;
+
+export async function isBootDriveMounted(drive: FileSystemDirectoryHandle): Promise<boolean> {
+  try {
+    await drive.getFileHandle(INFO_FILE);
+    return true;
+  } catch {
+    return false;
+  }
+}
+
+// The remembered drive if the browser still grants write access without a prompt
+export async function getStoredBootDrive(): Promise<FileSystemDirectoryHandle | null> {
+  if (!isBootDriveSupported) return null;
+  try {
+    const drive = await idbGet<FileSystemDirectoryHandle>("fileHandles", HANDLE_KEY);
+    if (!drive) return null;
+    return (await drive.queryPermission({ mode: "readwrite" })) === "granted" ? drive : null;
+  } catch (err) {
+    console.warn("Stored RPI-RP2 drive unavailable:", err);
+    return null;
+  }
+}
+
+// Needs a user gesture. Re-grants the remembered drive, otherwise asks the
+// user to select the drive and checks that it is one.
+export async function requestBootDrive(): Promise<FileSystemDirectoryHandle> {
+  const stored = await idbGet<FileSystemDirectoryHandle>("fileHandles", HANDLE_KEY).catch(() => undefined);
+  if (stored && (await stored.requestPermission({ mode: "readwrite" })) === "granted" && (await isBootDriveMounted(stored))) {
+    return stored;
+  }
+
+  const drive = await window.showDirectoryPicker!({ id: HANDLE_KEY, mode: "readwrite" });
+  if (!(await isBootDriveMounted(drive))) {
+    throw new Error(`The selected folder is not the RPI-RP2 drive (no ${INFO_FILE})`);
+  }
+  await idbPut("fileHandles", drive, HANDLE_KEY).catch((err) => console.warn("Could not remember RPI-RP2 drive:", err));
+  return drive;
+}
+
+// Polls until the drive is mounted (or unmounted); false on timeout
+export async function waitForBootDrive(
+  drive: FileSystemDirectoryHandle,
+  mounted: boolean,
+  timeoutMs: number
+): Promise<boolean> {
+  const deadline = performance.now() + timeoutMs;
+  while ((await isBootDriveMounted(drive)) !== mounted) {
+    if (performance.now() >= deadline) return false;
+    await new Promise((resolve) => setTimeout(resolve, POLL_INTERVAL_MS));
+  }
+  return true;
+}
+
+export async function createBootDriveWritable(
+  drive: FileSystemDirectoryHandle,
+  fileName: string
+): Promise<FileSystemWritableFileStream> {
+  const file = await drive.getFileHandle(fileName, { create: true });
+  return file.createWritable();
+}
+
+const UF2_PICKER_TYPES = [{
+  description: "UF2 Firmware",
+  accept: { "application/x-uf2": [".uf2"] },
+}];
+
+// Opens `fileName` for writing on the RPI-RP2 drive: the given (already
+// granted) drive, else the remembered or newly selected one, else a save
+// dialog. `drive` in the result is null when only the file is known.
+export async function openBootDriveFile(
+  fileName: string,
+  drive: FileSystemDirectoryHandle | null = null
+): Promise<{ writable: FileSystemWritableFileStream; drive: FileSystemDirectoryHandle | null }> {
+  if (drive) return { writable: await createBootDriveWritable(drive, fileName), drive };
+
+  if (isBootDriveSupported) {
+    try {
+      const picked = await requestBootDrive();
+      return { writable: await createBootDriveWritable(picked, fileName), drive: picked };
+    } catch (err) {
+      // Cancelled by the user, or not the drive: don't ask twice
+      if (err instanceof Error && (err.name === "AbortError" || err.message.includes(INFO_FILE))) throw err;
+      console.warn("Drive access refused, falling back to a save dialog:", err);
+    }
+  }
+
+  // @ts-expect-error - showSaveFilePicker is not in standard types yet
+  const handle: FileSystemFileHandle = await window.showSaveFilePicker({
+    suggestedName: fileName,
+    types: UF2_PICKER_TYPES,
+  });
+  return { writable: await handle.createWritable(), drive: null };
+}
@@ -0,0 +1,49 @@
+import { idbDelete, idbGet, idbGetAll, idbPut } from "@/lib/idb";
+
+// Boot screen gallery
+// Converted bitmaps are stored by SHA-256 of the BMP bytes. The device
+// session keeps the hash it last wrote, so re-provisioning the same drum with
+// the same logo can skip the flash write (the bitmap lives in a single, non
+// wear-levelled flash location).
+
+export interface GalleryBootScreen {
+  hash: string;
+  name: string;
+  bmp: Uint8Array;
+  createdAt: number;
+  lastUsedAt: number;
+}
+
+export const GALLERY_MAX_ITEMS = 48;
+
+export async function hashBitmap(bmp: Uint8Array): Promise<string> {
+  const digest = await crypto.subtle.digest("SHA-256", bmp as Uint8Array<ArrayBuffer>);
+  return Array.from(new Uint8Array(digest), (b) => b.toString(16).padStart(2, "0")).join("");
+}
+
+// Newest first
+export async function listGallery(): Promise<GalleryBootScreen[]> {
+  const items = await idbGetAll<GalleryBootScreen>("bootScreens");
+  return items.sort((a, b) => b.lastUsedAt - a.lastUsedAt);
+}
+
+// Adds the bitmap (or refreshes lastUsedAt) and trims the least recently used
+export async function saveToGallery(bmp: Uint8Array, name: string): Promise<GalleryBootScreen> {
+  const hash = await hashBitmap(bmp);
+  const now = Date.now();
+  const existing = await idbGet<GalleryBootScreen>("bootScreens", hash);
+  const item: GalleryBootScreen = existing
+    ? { ...existing, lastUsedAt: now }
+    : { hash, name, bmp: bmp.slice(), createdAt: now, lastUsedAt: now };
+  await idbPut("bootScreens", item);
+
+  const items = await listGallery();
+  for (const old of items.slice(GALLERY_MAX_ITEMS)) {
+    await idbDelete("bootScreens", old.hash);
+  }
+  return item;
+}
+
+export function deleteFromGallery(hash: string): Promise<void> {
+  return idbDelete("bootScreens", hash);
+}
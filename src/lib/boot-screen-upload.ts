@@ -0,0 +1,79 @@
+import type { SerialIO } from "@/types";
+import { DeviceCommand } from "@/types";
+import { getBmpFileSize, parseBitmapSaved } from "@/lib/serial-protocol";
+
+// Boot screen upload (command 3000)
+// Waits for BITMAP_UPLOAD_READY, streams the BMP paced by the port's write
+// backpressure and finishes as soon as BITMAP_SAVED:<n> arrives.
+
+export type WaitForLine = (match: (line: string) => boolean, timeoutMs?: number) => Promise<string | null>;
+
+// What DeviceContext.uploadBootScreen did: "skipped" means this session
+// already wrote this exact bitmap to the drum
+export type BootScreenUploadOutcome = "uploaded" | "skipped" | "failed";
+
+export interface BootScreenUploadResult {
+  ok: boolean;
+  error?: string;
+  savedBytes?: number;
+  durationMs: number;
+}
+
+const READY_TIMEOUT_MS = 1000;
+const SAVE_TIMEOUT_MS = 5000;    // Flash write takes ~1-2 s
+const MIN_CHUNK_SIZE = 64;       // USB CDC packet size
+const MAX_CHUNK_SIZE = 1024;
+
+const isUploadResponse = (prefix: string) => (line: string) =>
+  line.startsWith(prefix) || line.startsWith("BITMAP_ERROR");
+
+export async function uploadBootScreenData(
+  io: SerialIO,
+  waitForLine: WaitForLine,
+  data: Uint8Array
+): Promise<BootScreenUploadResult> {
+  const start = performance.now();
+  const fail = (error: string): BootScreenUploadResult => ({ ok: false, error, durationMs: performance.now() - start });
+
+  const expectedSize = getBmpFileSize(data);
+  if (expectedSize === null) return fail("Not a BMP file");
+  if (expectedSize !== data.length) return fail(`BMP header says ${expectedSize} bytes, got ${data.length}`);
+
+  // 1. Enter upload mode
+  await io.sendCommand(DeviceCommand.BOOT_SCREEN_START);
+  const ready = await waitForLine(isUploadResponse("BITMAP_UPLOAD_READY"), READY_TIMEOUT_MS);
+  if (!ready) return fail("Device did not enter upload mode");
+  if (ready.startsWith("BITMAP_ERROR")) return fail(ready);
+
+  // 2. Stream the image. Chunks grow while the port keeps accepting data
+  // and shrink when it pushes back, never exceeding what it can take.
+  let chunkSize = MIN_CHUNK_SIZE;
+  const writes: Promise<void>[] = [];
+  for (let offset = 0; offset < data.length; ) {
+    const desired = io.desiredSize();
+    if (desired !== null && desired <= 0) {
+      await io.ready();
+      chunkSize = Math.max(MIN_CHUNK_SIZE, chunkSize / 2);
+    } else {
+      chunkSize = Math.min(MAX_CHUNK_SIZE, chunkSize * 2);
+    }
+
+    const room = io.desiredSize() ?? chunkSize;
+    const size = Math.min(chunkSize, Math.max(MIN_CHUNK_SIZE, room));
+    writes.push(io.sendBinary(data.subarray(offset, offset + size)));
+    offset += size;
+  }
+  await Promise.all(writes);
+
+  // 3. The device saves as soon as it has the number of bytes in the header
+  const response = await waitForLine(isUploadResponse("BITMAP_SAVED"), SAVE_TIMEOUT_MS);
+  if (!response) return fail("Timed out waiting for the device to save");
+
+  const savedBytes = parseBitmapSaved(response);
+  if (savedBytes === null) return fail(response);
+  if (savedBytes !== expectedSize) {
+    return { ...fail(`Device saved ${savedBytes} bytes, expected ${expectedSize}`), savedBytes };
+  }
+
+  return { ok: true, savedBytes, durationMs: performance.now() - start };
+}
@@ -0,0 +1,76 @@
+import type { DeviceConfig } from "@/types";
+import { idbGet, idbPut } from "@/lib/idb";
+
+// Cached device settings
+// The last settings read from a drum are shown as soon as it connects, while
+// the live read runs in the background. Records are keyed by device key
+// (USB vendor:product), which drums of the same model share, so a drum can
+// open with another one's settings until the live read replaces them.
+
+export interface CachedConfig {
+  settings: [number, number][];
+  version?: string;
+  readAt: number;
+}
+
+// Where the settings in the editor came from: nothing yet, the cache (live
+// read still running) or the device
+export type ConfigSource = "none" | "cache" | "device";
+
+export interface ConfigConflict {
+  cached: DeviceConfig;   // What the edits were made on
+  device: DeviceConfig;
+  fields: string[];       // Paths where the two differ
+}
+
+export async function getCachedConfig(deviceKey: string): Promise<CachedConfig | null> {
+  const cached = await idbGet<CachedConfig>("deviceConfigs", deviceKey);
+  return cached?.settings ? cached : null;
+}
+
+export async function cacheConfig(deviceKey: string, settings: Map<number, number>, version?: string): Promise<void> {
+  const entry: CachedConfig = { settings: [...settings], version, readAt: Date.now() };
+  await idbPut("deviceConfigs", entry, deviceKey);
+}
+
+// Leaf values of a config by dotted path ("pads.kaLeft.light", "timing.donDebounce")
+function flattenConfig(config: DeviceConfig): Map<string, unknown> {
+  const fields = new Map<string, unknown>();
+  const walk = (value: unknown, path: string) => {
+    if (value !== null && typeof value === "object") {
+      for (const [key, child] of Object.entries(value)) walk(child, path ? `${path}.${key}` : key);
+    } else {
+      fields.set(path, value);
+    }
+  };
+  walk(config, "");
+  fields.delete("firmwareVersion");  // Not a setting
+  return fields;
+}
+
+// Paths of the settings that differ between two configs
+export function changedConfigFields(a: DeviceConfig, b: DeviceConfig): string[] {
+  const left = flattenConfig(a);
+  const right = flattenConfig(b);
+  const paths = new Set([...left.keys(), ...right.keys()]);
+  return [...paths].filter((path) => left.get(path) !== right.get(path));
+}
+
+// `base` with the values at `paths` taken from `from`
+export function mergeConfigFields(base: DeviceConfig, from: DeviceConfig, paths: string[]): DeviceConfig {
+  const merged = structuredClone(base);
+  for (const path of paths) {
+    const keys = path.split(".");
+    let target = merged as unknown as Record<string, unknown>;
+    let source = from as unknown as Record<string, unknown>;
+    for (const key of keys.slice(0, -1)) {
+      source = source?.[key] as Record<string, unknown>;
+      if (!source) break;
+      target[key] ??= {};
+      target = target[key] as Record<string, unknown>;
+    }
+    const last = keys[keys.length - 1];
+    if (source && last in source) target[last] = source[last];
+  }
+  return merged;
+}
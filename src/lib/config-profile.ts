@@ -0,0 +1,98 @@
+import type { DeviceConfig } from "@/types";
+import { PAD_NAMES, SETTING_INDICES } from "@/types";
+import { configToSettings, settingsToConfig } from "@/lib/serial-protocol";
+import { THRESHOLD_MIN, THRESHOLD_MAX, TIMING_MIN, TIMING_MAX } from "@/lib/default-config";
+
+// Config profiles for rolling one setup out to many drums
+// A profile is the JSON written by exportConfig. Applying it to a device
+// keeps whatever the profile doesn't cover (key mappings missing from an
+// older export, keys only newer firmware has), writes only what differs,
+// saves once and verifies the read-back against the profile and the schema.
+
+export type ConfigProfile = Pick<DeviceConfig, "pads" | "doubleInputMode" | "timing"> &
+  Partial<Pick<DeviceConfig, "keyMappings" | "adcChannels">>;
+
+export interface ProfileApplyResult {
+  ok: boolean;
+  changed: number;        // Keys written
+  mismatched: number[];   // Keys that read back with another value
+  invalid: string[];      // Read-back values outside the schema
+  error?: string;
+  durationMs: number;
+}
+
+// Valid range of each setting key
+const SETTING_RANGES = new Map<number, [number, number]>();
+for (const pad of PAD_NAMES) {
+  SETTING_RANGES.set(SETTING_INDICES.lightThreshold[pad], [THRESHOLD_MIN, THRESHOLD_MAX]);
+  SETTING_RANGES.set(SETTING_INDICES.heavyThreshold[pad], [THRESHOLD_MIN, THRESHOLD_MAX]);
+  SETTING_RANGES.set(SETTING_INDICES.cutoffThreshold[pad], [THRESHOLD_MIN, THRESHOLD_MAX]);
+  SETTING_RANGES.set(SETTING_INDICES.adcChannel[pad], [0, 7]);
+}
+for (const key of [
+  SETTING_INDICES.donDebounce,
+  SETTING_INDICES.kaDebounce,
+  SETTING_INDICES.crosstalkDebounce,
+  SETTING_INDICES.individualDebounce,
+  SETTING_INDICES.keyHoldTime,
+]) {
+  SETTING_RANGES.set(key, [TIMING_MIN, TIMING_MAX]);
+}
+SETTING_RANGES.set(SETTING_INDICES.doubleInputMode, [0, 1]);
+for (const group of Object.values(SETTING_INDICES.keyMapping)) {
+  for (const key of Object.values(group)) SETTING_RANGES.set(key, [0, 255]);  // HID usage ids
+}
+
+// Problems with settings values, empty when all known keys are in range
+export function validateSettings(settings: Map<number, number>): string[] {
+  const problems: string[] = [];
+  for (const [key, value] of settings) {
+    const range = SETTING_RANGES.get(key);
+    if (!range) continue;  // Newer firmware keys are not checked
+    if (!Number.isInteger(value) || value < range[0] || value > range[1]) {
+      problems.push(`${key}:${value} outside ${range[0]}-${range[1]}`);
+    }
+  }
+  return problems;
+}
+
+// Throws with a readable message when the file is not a usable profile
+export function parseConfigProfile(text: string): ConfigProfile {
+  let data: Partial<ConfigProfile>;
+  try {
+    data = JSON.parse(text);
+  } catch {
+    throw new Error("Profile is not valid JSON");
+  }
+  const { pads, timing } = data ?? {};
+  if (!pads || !timing || PAD_NAMES.some((pad) => !pads[pad])) {
+    throw new Error("Profile is missing pad thresholds or timing");
+  }
+
+  const profile: ConfigProfile = {
+    pads,
+    doubleInputMode: data.doubleInputMode ?? false,
+    timing,
+    keyMappings: data.keyMappings,
+    adcChannels: data.adcChannels,
+  };
+  const problems = validateSettings(configToSettings(profile));
+  if (problems.length > 0) throw new Error(`Profile has invalid values: ${problems.join(", ")}`);
+  return profile;
+}
+
+// The device's settings with the profile applied, limited to the keys the
+// device reports
+export function profileToSettings(profile: ConfigProfile, current: Map<number, number>): Map<number, number> {
+  const base = settingsToConfig(current);
+  const merged = configToSettings({
+    ...base,
+    ...profile,
+    keyMappings: profile.keyMappings ?? base.keyMappings,
+    adcChannels: profile.adcChannels ?? base.adcChannels,
+  });
+
+  const desired = new Map<number, number>();
+  for (const [key, value] of current) desired.set(key, merged.get(key) ?? value);
+  return desired;
+}
@@ -0,0 +1,101 @@
+import { idbDelete, idbGet, idbGetAll, idbPut } from "@/lib/idb";
+import { compareVersions } from "@/lib/utils";
+
+// Device settings carried across a firmware update
+// The raw key:value settings are stored before the device reboots into
+// BOOTSEL. When it comes back they are migrated to the key set the new
+// firmware reports, and only keys that differ are written and saved.
+// Same-model drums share a device key, so a snapshot is only restored
+// without asking by the session that took it, which holds its id.
+
+export interface ConfigSnapshot {
+  id: string;
+  deviceKey: string;
+  firmwareVersion?: string;
+  settings: [number, number][];
+  takenAt: number;
+  restoredAt?: number;
+}
+
+// A snapshot older than this is no longer restored or offered
+const MAX_PENDING_AGE_MS = 30 * 60 * 1000;
+
+// Key renumbering between firmware versions: settings taken on firmware
+// older than `before` move from the old key to the new one. Empty until the
+// firmware changes its layout.
+const KEY_MIGRATIONS: { before: string; keys: Record<number, number> }[] = [];
+
+// Taken in this page: each belongs to the session that took it
+const takenHere = new Set<string>();
+
+const isPending = (snapshot: ConfigSnapshot) =>
+  !snapshot.restoredAt && Date.now() - snapshot.takenAt <= MAX_PENDING_AGE_MS;
+
+// Resolves the snapshot id the taking session restores it by
+export async function saveConfigSnapshot(
+  deviceKey: string,
+  settings: Map<number, number>,
+  firmwareVersion?: string
+): Promise<string> {
+  const snapshot: ConfigSnapshot = {
+    id: crypto.randomUUID(),
+    deviceKey,
+    firmwareVersion,
+    settings: [...settings],
+    takenAt: Date.now(),
+  };
+  for (const old of await idbGetAll<ConfigSnapshot>("configSnapshots")) {
+    if (old.id && !isPending(old)) await idbDelete("configSnapshots", old.id);
+  }
+  await idbPut("configSnapshots", snapshot, snapshot.id);
+  takenHere.add(snapshot.id);
+  return snapshot.id;
+}
+
+export async function getPendingConfigSnapshot(id: string): Promise<ConfigSnapshot | null> {
+  const snapshot = await idbGet<ConfigSnapshot>("configSnapshots", id);
+  return snapshot && isPending(snapshot) ? snapshot : null;
+}
+
+// Pending snapshots of this model that no session here took (the update
+// started before a page reload), newest first. They may come from another
+// drum of the same model, so they are only restored on request.
+export async function listOrphanedConfigSnapshots(deviceKey: string): Promise<ConfigSnapshot[]> {
+  const snapshots = await idbGetAll<ConfigSnapshot>("configSnapshots");
+  return snapshots
+    .filter((s) => s.deviceKey === deviceKey && !takenHere.has(s.id) && isPending(s))
+    .sort((a, b) => b.takenAt - a.takenAt);
+}
+
+// The record stays until the next snapshot prunes it, but is no longer pending
+export async function markConfigSnapshotRestored(id: string): Promise<void> {
+  const snapshot = await idbGet<ConfigSnapshot>("configSnapshots", id);
+  if (snapshot) await idbPut("configSnapshots", { ...snapshot, restoredAt: Date.now() }, id);
+}
+
+// Snapshot values mapped onto the keys the running firmware reports. Keys
+// the new firmware added keep their (default) value; removed keys are dropped.
+export function migrateSettings(snapshot: ConfigSnapshot, current: Map<number, number>): Map<number, number> {
+  let settings = new Map(snapshot.settings);
+  for (const migration of KEY_MIGRATIONS) {
+    if (snapshot.firmwareVersion && compareVersions(snapshot.firmwareVersion, migration.before) >= 0) continue;
+    const moved = new Map<number, number>();
+    for (const [key, value] of settings) moved.set(migration.keys[key] ?? key, value);
+    settings = moved;
+  }
+
+  const migrated = new Map<number, number>();
+  for (const key of current.keys()) {
+    migrated.set(key, settings.get(key) ?? current.get(key)!);
+  }
+  return migrated;
+}
+
+// Entries of `desired` that `current` doesn't match
+export function diffSettings(desired: Map<number, number>, current: Map<number, number>): Map<number, number> {
+  const diff = new Map<number, number>();
+  for (const [key, value] of desired) {
+    if (current.get(key) !== value) diff.set(key, value);
+  }
+  return diff;
+}
@@ -0,0 +1,218 @@
+import type { PadName } from "@/types";
+import { PAD_NAMES } from "@/types";
+import { suggestLightThreshold } from "@/lib/noise-stats";
+
+// Crosstalk between pads
+// Each time a pad crosses its light threshold, the next CROSSTALK_WINDOW_MS
+// are examined. The strongest pad in the first ONSET_MS is taken as the hit
+// and the responses of the other three as bleed from it. The window ends
+// early at a separate hit soon after: another pad crossing with a good part
+// of the hit's strength, or the hit pad clearly topping its own decay
+// (a peak-hold envelope, as in retrigger.ts). Over a session this gives the
+// bleed ratio for every pair, how long after the hit the bleed arrives, and
+// which crosstalk debounce or light thresholds would reject it.
+// Like the firmware, a delta at the threshold counts as crossing it; a flat
+// sample never does, even with a threshold of 0.
+// One pass over the frames, so an hour of stream takes well under a second.
+
+export const CROSSTALK_WINDOW_MS = 100;
+export const LAG_BIN_MS = 5;
+const ONSET_MS = 5;
+const RELEASE_MS = 20;
+const NEW_HIT_FACTOR = 2;
+
+// A response this large relative to the hit is a second hit (both dons on a
+// big note, or another pad soon after), not bleed
+const SIMULTANEOUS_RATIO = 0.6;
+
+export interface CrosstalkInput {
+  frames: Uint16Array;      // Raw ADC, kaLeft, donLeft, donRight, kaRight per sample
+  sampleIntervalMs: number;
+  light: Record<PadName, number>;
+}
+
+// Bleed from one pad into another
+export interface CrosstalkCell {
+  count: number;
+  medianRatio: number;       // Bleed peak / hit peak
+  p95Ratio: number;
+  p95LagMs: number;          // Hit crossing to bleed peak
+  triggered: number;         // Bleed that crossed the light threshold
+}
+
+export interface CrosstalkResult {
+  samples: number;
+  sampleIntervalMs: number;
+  hits: Record<PadName, number>;
+  secondHits: number;        // Responses left out as simultaneous hits
+  // [hit][bleed], null on the diagonal
+  matrix: Record<PadName, Record<PadName, CrosstalkCell | null>>;
+  lagHistogram: number[];    // Bleed peak lag, LAG_BIN_MS bins up to the window
+  bleedP99: Record<PadName, number>;           // Bleed delta arriving at each pad
+  suggestedLight: Record<PadName, number | null>;  // Rejects the bleed without the debounce
+  // Longest time after a hit that bleed stays above a light threshold (p99);
+  // 0 when no bleed crossed one
+  recommendedDebounceMs: number;
+  earlyBleed: number;        // Bleed that crossed before the hit: no debounce can reject it
+  elapsedMs: number;
+}
+
+function quantile(sorted: ArrayLike<number>, q: number): number {
+  if (sorted.length === 0) return 0;
+  return sorted[Math.min(sorted.length - 1, Math.floor(q * sorted.length))];
+}
+
+const sortedCopy = (values: number[]) => Float64Array.from(values).sort();
+
+export function analyzeCrosstalk({ frames, sampleIntervalMs, light }: CrosstalkInput): CrosstalkResult {
+  const started = performance.now();
+  const samples = Math.floor(frames.length / 4);
+  const window = Math.max(1, Math.round(CROSSTALK_WINDOW_MS / sampleIntervalMs));
+  const onset = Math.max(1, Math.round(ONSET_MS / sampleIntervalMs));
+  const release = Math.exp(-sampleIntervalMs / RELEASE_MS);
+  const lights = PAD_NAMES.map((pad) => light[pad]);
+
+  const hits = [0, 0, 0, 0];
+  const ratios: number[][] = Array.from({ length: 16 }, () => []);
+  const lags: number[][] = Array.from({ length: 16 }, () => []);
+  const triggered = new Array<number>(16).fill(0);
+  const bleedPeaks: number[][] = [[], [], [], []];
+  const triggerLags: number[] = [];
+  const lagHistogram = new Array<number>(Math.ceil(CROSSTALK_WINDOW_MS / LAG_BIN_MS)).fill(0);
+  let secondHits = 0;
+  let earlyBleed = 0;
+
+  const peak = [0, 0, 0, 0];
+  const peakAt = [0, 0, 0, 0];
+  const firstCross = [0, 0, 0, 0];
+  const lastCross = [0, 0, 0, 0];
+
+  const delta = (t: number, p: number) => {
+    const rise = frames[t * 4 + p] - frames[(t - 1) * 4 + p];
+    return rise > 0 ? rise : 0;
+  };
+  const crosses = (d: number, p: number) => d > 0 && d >= lights[p];
+
+  let t = 1;
+  while (t < samples) {
+    if (!crosses(delta(t, 0), 0) && !crosses(delta(t, 1), 1) &&
+        !crosses(delta(t, 2), 2) && !crosses(delta(t, 3), 3)) {
+      t++;
+      continue;
+    }
+
+    // The strongest pad that crossed at the onset is the hit
+    const onsetEnd = Math.min(samples, t + onset);
+    let source = -1;
+    let sourceOnsetPeak = 0;
+    for (let p = 0; p < 4; p++) {
+      for (let i = t; i < onsetEnd; i++) {
+        const d = delta(i, p);
+        if (crosses(d, p) && d > sourceOnsetPeak) {
+          source = p;
+          sourceOnsetPeak = d;
+        }
+      }
+    }
+    if (source < 0) {
+      t++;
+      continue;
+    }
+
+    for (let p = 0; p < 4; p++) {
+      peak[p] = 0;
+      peakAt[p] = t;
+      firstCross[p] = -1;
+      lastCross[p] = -1;
+    }
+    let end = Math.min(samples, t + window);
+    let envelope = 0;
+    scan: for (let i = t; i < end; i++) {
+      for (let p = 0; p < 4; p++) {
+        const d = delta(i, p);
+        if (i >= onsetEnd && crosses(d, p) &&
+            (p === source ? d > envelope * NEW_HIT_FACTOR : d >= peak[source] * SIMULTANEOUS_RATIO)) {
+          end = i;  // Separate hit: analysed in its own window
+          break scan;
+        }
+        if (d > peak[p]) {
+          peak[p] = d;
+          peakAt[p] = i;
+        }
+        if (crosses(d, p)) {
+          if (firstCross[p] < 0) firstCross[p] = i;
+          lastCross[p] = i;
+        }
+      }
+      const d = delta(i, source);
+      envelope = d > envelope * release ? d : envelope * release;
+    }
+
+    hits[source]++;
+
+    for (let p = 0; p < 4; p++) {
+      if (p === source) continue;
+      const ratio = peak[p] / peak[source];
+      if (ratio >= SIMULTANEOUS_RATIO && firstCross[p] >= 0 && firstCross[p] < onsetEnd) {
+        secondHits++;
+        continue;
+      }
+      const cell = source * 4 + p;
+      const lagMs = (peakAt[p] - firstCross[source]) * sampleIntervalMs;
+      ratios[cell].push(ratio);
+      lags[cell].push(lagMs);
+      bleedPeaks[p].push(peak[p]);
+      if (peak[p] > 0) {
+        lagHistogram[Math.min(lagHistogram.length - 1, Math.max(0, Math.floor(lagMs / LAG_BIN_MS)))]++;
+      }
+      if (lastCross[p] >= 0) {
+        triggered[cell]++;
+        if (firstCross[p] < firstCross[source]) earlyBleed++;
+        else triggerLags.push((lastCross[p] - firstCross[source] + 1) * sampleIntervalMs);
+      }
+    }
+
+    t = end;
+  }
+
+  const matrix = {} as Record<PadName, Record<PadName, CrosstalkCell | null>>;
+  PAD_NAMES.forEach((source, s) => {
+    matrix[source] = {} as Record<PadName, CrosstalkCell | null>;
+    PAD_NAMES.forEach((target, p) => {
+      if (s === p) {
+        matrix[source][target] = null;
+        return;
+      }
+      const cell = s * 4 + p;
+      const sortedRatios = sortedCopy(ratios[cell]);
+      matrix[source][target] = {
+        count: sortedRatios.length,
+        medianRatio: quantile(sortedRatios, 0.5),
+        p95Ratio: quantile(sortedRatios, 0.95),
+        p95LagMs: quantile(sortedCopy(lags[cell]), 0.95),
+        triggered: triggered[cell],
+      };
+    });
+  });
+
+  const bleedP99 = {} as Record<PadName, number>;
+  const suggestedLight = {} as Record<PadName, number | null>;
+  PAD_NAMES.forEach((pad, p) => {
+    bleedP99[pad] = quantile(sortedCopy(bleedPeaks[p]), 0.99);
+    suggestedLight[pad] = bleedPeaks[p].length > 0 ? suggestLightThreshold(bleedP99[pad]) : null;
+  });
+
+  return {
+    samples,
+    sampleIntervalMs,
+    hits: { kaLeft: hits[0], donLeft: hits[1], donRight: hits[2], kaRight: hits[3] },
+    secondHits,
+    matrix,
+    lagHistogram,
+    bleedP99,
+    suggestedLight,
+    recommendedDebounceMs: Math.ceil(quantile(sortedCopy(triggerLags), 0.99)),
+    earlyBleed,
+    elapsedMs: performance.now() - started,
+  };
+}
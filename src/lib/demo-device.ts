@@ -0,0 +1,105 @@
+import type { PadName } from "@/types";
+import { PAD_NAMES, SETTING_INDICES } from "@/types";
+import { createDeviceEmulator, type SignalSource } from "@/lib/device-emulator";
+import { EmulatedSerial, EmulatedSerialPort, installEmulatedSerial } from "@/lib/emulated-serial";
+import { createSignalGenerator, type SignalGenerator } from "@/lib/signal-generator";
+import { createSessionPlayer, parseSessionText } from "@/lib/session-player";
+import { browserKeyToHid, hidToBrowserCode } from "@/lib/hid-keycodes";
+
+// Offline demo device (?demo=true)
+// Backs navigator.serial with the firmware emulator so the whole configurator
+// runs without a controller. Trigger output is delivered the way the real drum
+// does it: as keyboard events for the P1 key mapping.
+
+export interface DemoDeviceOptions {
+  sessionUrl?: string;   // Recorded raw stream to replay instead of generated hits
+  streamRate?: number;
+  hitRate?: number;      // Generated hits per second
+}
+
+export interface DemoDevice {
+  port: EmulatedSerialPort;
+  stop: () => void;
+}
+
+const DEMO_STREAM_RATE = 100;  // Like the hardware (SERIAL_CONFIG.md)
+const DEMO_HIT_RATE = 2.5;
+
+async function loadSignal(
+  options: DemoDeviceOptions,
+  streamRate: number
+): Promise<{ source: SignalSource; generator: SignalGenerator | null }> {
+  if (options.sessionUrl) {
+    try {
+      const response = await fetch(options.sessionUrl);
+      if (!response.ok) throw new Error(`${response.status} ${response.statusText}`);
+      const frames = parseSessionText(await response.text());
+      if (frames.length > 0) return { source: createSessionPlayer(frames), generator: null };
+      console.warn("Demo session contains no raw stream frames, using generated signal");
+    } catch (err) {
+      console.warn("Failed to load demo session, using generated signal:", err);
+    }
+  }
+  const generator = createSignalGenerator({
+    seed: Date.now() & 0xffff,
+    sampleRate: streamRate,
+    hitRate: options.hitRate ?? DEMO_HIT_RATE,
+  });
+  return { source: generator, generator };
+}
+
+export async function startDemoDevice(options: DemoDeviceOptions = {}): Promise<DemoDevice> {
+  const streamRate = options.streamRate ?? DEMO_STREAM_RATE;
+  const { source, generator } = await loadSignal(options, streamRate);
+
+  const emulator = createDeviceEmulator({ streamRate, signal: source });
+  const port = new EmulatedSerialPort(emulator, { latencyMs: 2, bootselReturnMs: 4000 });
+  const serial = new EmulatedSerial();
+  serial.addPort(port);
+  const uninstall = installEmulatedSerial(serial);
+
+  const padForHid = (hid: number): PadName | null =>
+    PAD_NAMES.find((pad) => emulator.settings.get(SETTING_INDICES.keyMapping.drumP1[pad]) === hid) ?? null;
+
+  // Physical keys held by the user, so synthetic releases don't cancel them
+  const heldPads = new Set<PadName>();
+
+  emulator.onTrigger = (pad, pressed) => {
+    if (heldPads.has(pad)) return;
+    const hid = emulator.settings.get(SETTING_INDICES.keyMapping.drumP1[pad]) ?? 0;
+    const code = hid ? hidToBrowserCode(hid) : null;
+    if (!code) return;
+    window.dispatchEvent(new KeyboardEvent(pressed ? "keydown" : "keyup", { code }));
+  };
+
+  // Playing the P1 keys hits the emulated drum (generated signal only)
+  const handleKeyDown = (event: KeyboardEvent) => {
+    if (!event.isTrusted || event.repeat || !generator) return;
+    const hid = browserKeyToHid(event);
+    const pad = hid !== null ? padForHid(hid) : null;
+    if (!pad) return;
+    heldPads.add(pad);
+    generator.hit(pad);
+  };
+
+  const handleKeyUp = (event: KeyboardEvent) => {
+    if (!event.isTrusted) return;
+    const hid = browserKeyToHid(event);
+    const pad = hid !== null ? padForHid(hid) : null;
+    if (pad) heldPads.delete(pad);
+  };
+
+  window.addEventListener("keydown", handleKeyDown);
+  window.addEventListener("keyup", handleKeyUp);
+
+  return {
+    port,
+    stop: () => {
+      window.removeEventListener("keydown", handleKeyDown);
+      window.removeEventListener("keyup", handleKeyUp);
+      emulator.onTrigger = null;
+      port.unplug();
+      uninstall();
+    },
+  };
+}
@@ -0,0 +1,393 @@
+import type { PadName } from "@/types";
+import { DeviceCommand, PAD_NAMES, SETTING_INDICES } from "@/types";
+import { configToSettingsString, encodeRawStreamLine, parseSettingsResponse } from "@/lib/serial-protocol";
+import { DEFAULT_DEVICE_CONFIG } from "@/lib/default-config";
+import { createSignalGenerator } from "@/lib/signal-generator";
+
+// ITAIKO firmware emulator
+// Implements the text protocol from SERIAL_CONFIG.md on top of a byte interface:
+// the host side calls receive() with raw bytes, replies and stream data come out
+// through onOutput(). Transport concerns (latency, throughput, port lifecycle)
+// live in emulated-serial.ts.
+
+// Anything that can produce raw ADC frames (signal generator, recorded session)
+export interface SignalSource {
+  nextFrame: () => Record<PadName, number>;
+}
+
+export interface DeviceEmulatorOptions {
+  firmwareVersion?: string;
+  settings?: Map<number, number>;   // Initial flash contents (defaults to DEFAULT_DEVICE_CONFIG)
+  signal?: SignalSource;            // Defaults to an idle signal generator
+  streamRate?: number;              // Stream samples per second (~100Hz on hardware)
+  settingsSaveDelayMs?: number;     // Flash write time for command 1001
+  bitmapSaveDelayMs?: number;       // Flash write time after a bitmap upload
+  rxBufferSize?: number;            // Bytes buffered while the device is busy, excess is dropped
+}
+
+export interface DeviceEmulator {
+  readonly settings: Map<number, number>;
+  readonly flashSettings: Map<number, number>;
+  readonly bitmap: Uint8Array | null;
+  readonly droppedBytes: number;
+  // Host -> device bytes
+  receive: (data: Uint8Array) => void;
+  // Device -> host bytes
+  onOutput: ((data: Uint8Array) => void) | null;
+  // Fired on command 1004, the device leaves CDC mode
+  onReboot: (() => void) | null;
+  // Fired on every trigger edge (the HID key press the firmware would send)
+  onTrigger: ((pad: PadName, pressed: boolean) => void) | null;
+  setSignal: (signal: SignalSource) => void;
+  // Power-on state (streaming off, RAM settings reloaded from flash), starts the sample clock
+  powerOn: () => void;
+  // Stops the sample clock, e.g. while the device sits in BOOTSEL
+  powerOff: () => void;
+}
+
+export const BITMAP_MAX_SIZE = 1280;
+
+const SETTING_COUNT = 46;
+const DEFAULT_FIRMWARE_VERSION = "1.7.0";
+const MAX_CATCHUP_MS = 1000;
+
+type ParserMode = "command" | "write" | "bitmap";
+
+export function defaultEmulatorSettings(): Map<number, number> {
+  return parseSettingsResponse(configToSettingsString(DEFAULT_DEVICE_CONFIG).replace(/ /g, "\n")).settings;
+}
+
+export function createDeviceEmulator(options: DeviceEmulatorOptions = {}): DeviceEmulator {
+  const firmwareVersion = options.firmwareVersion ?? DEFAULT_FIRMWARE_VERSION;
+  const streamRate = options.streamRate ?? 100;
+  const settingsSaveDelayMs = options.settingsSaveDelayMs ?? 30;
+  const bitmapSaveDelayMs = options.bitmapSaveDelayMs ?? 1500;
+  const rxBufferSize = options.rxBufferSize ?? 4096;
+
+  const encoder = new TextEncoder();
+  const flashSettings = new Map(options.settings ?? defaultEmulatorSettings());
+  let settings = new Map(flashSettings);
+  let bitmap: Uint8Array | null = null;
+  let signal: SignalSource = options.signal ?? createSignalGenerator({ sampleRate: streamRate });
+
+  // Parser state
+  let mode: ParserMode = "command";
+  let lineBuffer = "";
+  let bitmapBuffer: Uint8Array | null = null;
+  let bitmapReceived = 0;
+  let bitmapExpected = 0;
+
+  // Busy state (flash writes stall the main loop, input is buffered)
+  let busy = false;
+  let pending: Uint8Array[] = [];
+  let pendingBytes = 0;
+  let droppedBytes = 0;
+
+  // Streaming state. The sample clock runs whenever the device is powered so
+  // triggers (HID output) work without streaming, like on hardware.
+  let rawStreaming = false;
+  let inputStreaming = false;
+  let clockTimer: ReturnType<typeof setInterval> | null = null;
+  let clockStart = 0;
+  let samplesSent = 0;
+
+  // Trigger model state (per pad, in sample time)
+  const previousRaw: Record<PadName, number> = { kaLeft: 0, donLeft: 0, donRight: 0, kaRight: 0 };
+  const lastHit: Record<PadName, number> = { kaLeft: -Infinity, donLeft: -Infinity, donRight: -Infinity, kaRight: -Infinity };
+  const releaseAt: Record<PadName, number> = { kaLeft: -Infinity, donLeft: -Infinity, donRight: -Infinity, kaRight: -Infinity };
+  let lastDonHit = -Infinity;
+  let lastKaHit = -Infinity;
+
+  const emulator: DeviceEmulator = {
+    get settings() {
+      return settings;
+    },
+    flashSettings,
+    get bitmap() {
+      return bitmap;
+    },
+    get droppedBytes() {
+      return droppedBytes;
+    },
+    receive: (data) => receive(data),
+    onOutput: null,
+    onReboot: null,
+    onTrigger: null,
+    setSignal: (next) => {
+      signal = next;
+    },
+    powerOn: () => {
+      reset();
+      startClock();
+    },
+    powerOff: () => stopClock(),
+  };
+
+  const emit = (text: string) => {
+    emulator.onOutput?.(encoder.encode(text));
+  };
+
+  const emitLine = (line: string) => emit(`${line}\n`);
+
+  // --- Trigger model ---------------------------------------------------------
+
+  const msToSamples = (ms: number) => (ms * streamRate) / 1000;
+
+  const updateTriggers = (frame: Record<PadName, number>, sample: number): number => {
+    let mask = 0;
+    const donDebounce = msToSamples(settings.get(SETTING_INDICES.donDebounce) ?? 30);
+    const kaDebounce = msToSamples(settings.get(SETTING_INDICES.kaDebounce) ?? 30);
+    const crosstalkDebounce = msToSamples(settings.get(SETTING_INDICES.crosstalkDebounce) ?? 30);
+    const individualDebounce = msToSamples(settings.get(SETTING_INDICES.individualDebounce) ?? 19);
+    const keyHold = msToSamples(settings.get(SETTING_INDICES.keyHoldTime) ?? 25);
+
+    PAD_NAMES.forEach((pad, bit) => {
+      const raw = frame[pad];
+      const delta = Math.max(0, raw - previousRaw[pad]);
+      previousRaw[pad] = raw;
+
+      const isDon = pad === "donLeft" || pad === "donRight";
+      const threshold = settings.get(SETTING_INDICES.lightThreshold[pad]) ?? 800;
+      const cutoff = settings.get(SETTING_INDICES.cutoffThreshold[pad]) ?? 4095;
+
+      const wasPressed = sample < releaseAt[pad];
+      const lockedOut =
+        sample - lastHit[pad] < individualDebounce ||
+        (isDon ? sample - lastDonHit < donDebounce : sample - lastKaHit < kaDebounce) ||
+        (!isDon && sample - lastDonHit < crosstalkDebounce);
+
+      if (delta >= threshold && raw < cutoff && !lockedOut) {
+        lastHit[pad] = sample;
+        releaseAt[pad] = sample + Math.max(1, keyHold);
+        if (isDon) lastDonHit = sample;
+        else lastKaHit = sample;
+      }
+
+      const pressed = sample < releaseAt[pad];
+      if (pressed) mask |= 1 << bit;
+      if (pressed !== wasPressed) emulator.onTrigger?.(pad, pressed);
+    });
+
+    return mask;
+  };
+
+  // --- Streaming -------------------------------------------------------------
+
+  const clockTick = () => {
+    const due = Math.floor(((performance.now() - clockStart) * streamRate) / 1000);
+    const maxBatch = Math.ceil((streamRate * MAX_CATCHUP_MS) / 1000);
+    if (due - samplesSent > maxBatch) samplesSent = due - maxBatch;
+    if (busy) return;
+
+    let out = "";
+    for (; samplesSent < due; samplesSent++) {
+      const frame = signal.nextFrame();
+      const mask = updateTriggers(frame, samplesSent);
+      if (rawStreaming) out += `${encodeRawStreamLine(frame)}\n`;
+      if (inputStreaming) out += `${mask.toString(16).toUpperCase()}\n`;
+    }
+    if (out) emit(out);
+  };
+
+  const startClock = () => {
+    if (clockTimer) return;
+    clockStart = performance.now();
+    samplesSent = 0;
+    clockTimer = setInterval(clockTick, 10);
+  };
+
+  const stopClock = () => {
+    if (clockTimer) clearInterval(clockTimer);
+    clockTimer = null;
+  };
+
+  // --- Busy handling (flash writes) -------------------------------------------
+
+  const runBusy = (durationMs: number, done: () => void) => {
+    busy = true;
+    setTimeout(() => {
+      busy = false;
+      done();
+      const queued = pending;
+      pending = [];
+      pendingBytes = 0;
+      queued.forEach((chunk) => receive(chunk));
+    }, durationMs);
+  };
+
+  // --- Commands ----------------------------------------------------------------
+
+  const readSettings = () => {
+    let out = `Version:${firmwareVersion}\n`;
+    for (let key = 0; key < SETTING_COUNT; key++) {
+      out += `${key}:${settings.get(key) ?? 0}\n`;
+    }
+    emit(out);
+  };
+
+  const applyWrite = (line: string) => {
+    let applied = 0;
+    for (const pair of line.trim().split(/\s+/)) {
+      const match = pair.match(/^(\d+):(\d+)$/);
+      if (!match) continue;
+      const key = parseInt(match[1], 10);
+      if (key >= SETTING_COUNT) continue;
+      settings.set(key, parseInt(match[2], 10));
+      applied++;
+    }
+    // Write mode exits after at least one value
+    if (applied > 0) mode = "command";
+  };
+
+  const handleCommand = (line: string) => {
+    const command = parseInt(line, 10);
+    switch (command) {
+      case DeviceCommand.READ_SETTINGS:
+        readSettings();
+        break;
+      case DeviceCommand.SAVE_TO_FLASH:
+        runBusy(settingsSaveDelayMs, () => {
+          settings.forEach((value, key) => flashSettings.set(key, value));
+          emitLine("Settings saved");
+        });
+        break;
+      case DeviceCommand.WRITE_MODE:
+        mode = "write";
+        break;
+      case 1003: // Reload from flash
+        settings = new Map(flashSettings);
+        emitLine("Settings reloaded");
+        break;
+      case DeviceCommand.REBOOT_TO_BOOTSEL:
+        stopClock();
+        emulator.onReboot?.();
+        break;
+      case DeviceCommand.START_STREAMING:
+        rawStreaming = true;
+        break;
+      case DeviceCommand.START_INPUT_STREAMING:
+        inputStreaming = true;
+        break;
+      case DeviceCommand.STOP_STREAMING:
+        rawStreaming = false;
+        inputStreaming = false;
+        break;
+      case DeviceCommand.BOOT_SCREEN_START:
+        mode = "bitmap";
+        bitmapBuffer = new Uint8Array(BITMAP_MAX_SIZE);
+        bitmapReceived = 0;
+        bitmapExpected = 0;
+        emitLine("BITMAP_UPLOAD_READY");
+        break;
+      case DeviceCommand.BOOT_SCREEN_CLEAR:
+        runBusy(settingsSaveDelayMs, () => {
+          bitmap = null;
+          emitLine("BITMAP_CLEARED");
+        });
+        break;
+      default:
+        if (!isNaN(command)) emitLine(`Unknown command: ${command}`);
+        break;
+    }
+  };
+
+  const handleLine = (line: string) => {
+    const trimmed = line.trim();
+    if (!trimmed) return;
+    if (mode === "write") applyWrite(trimmed);
+    else handleCommand(trimmed);
+  };
+
+  // Binary upload: the BMP header tells us how many bytes to expect.
+  // Returns the number of bytes consumed from `data` starting at `offset`.
+  const receiveBitmap = (data: Uint8Array, offset: number): number => {
+    const buffer = bitmapBuffer!;
+    let i = offset;
+
+    while (i < data.length && (bitmapExpected === 0 || bitmapReceived < bitmapExpected)) {
+      if (bitmapReceived >= BITMAP_MAX_SIZE) break;
+      buffer[bitmapReceived++] = data[i++];
+
+      if (bitmapExpected === 0 && bitmapReceived === 6) {
+        const size = buffer[2] | (buffer[3] << 8) | (buffer[4] << 16) | (buffer[5] << 24);
+        if (buffer[0] !== 0x42 || buffer[1] !== 0x4d) {
+          mode = "command";
+          emitLine("BITMAP_ERROR:Invalid header");
+          return i - offset;
+        }
+        if (size <= 0 || size > BITMAP_MAX_SIZE) {
+          mode = "command";
+          emitLine(`BITMAP_ERROR:Invalid size ${size}`);
+          return i - offset;
+        }
+        bitmapExpected = size;
+      }
+    }
+
+    if (bitmapExpected > 0 && bitmapReceived >= bitmapExpected) {
+      const saved = buffer.slice(0, bitmapReceived);
+      const size = bitmapReceived;
+      mode = "command";
+      bitmapBuffer = null;
+      runBusy(bitmapSaveDelayMs, () => {
+        bitmap = saved;
+        emitLine(`BITMAP_SAVED:${size}`);
+      });
+    }
+
+    return i - offset;
+  };
+
+  const receive = (data: Uint8Array) => {
+    if (busy) {
+      const room = rxBufferSize - pendingBytes;
+      if (room <= 0) {
+        droppedBytes += data.length;
+        return;
+      }
+      const accepted = data.length > room ? data.subarray(0, room) : data;
+      droppedBytes += data.length - accepted.length;
+      pending.push(accepted.slice());
+      pendingBytes += accepted.length;
+      return;
+    }
+
+    let i = 0;
+    while (i < data.length) {
+      if (busy) {
+        receive(data.subarray(i));
+        return;
+      }
+      if (mode === "bitmap") {
+        i += receiveBitmap(data, i);
+        continue;
+      }
+      const byte = data[i++];
+      if (byte === 0x0a) {
+        const line = lineBuffer;
+        lineBuffer = "";
+        handleLine(line);
+      } else if (byte !== 0x0d) {
+        lineBuffer += String.fromCharCode(byte);
+      }
+    }
+  };
+
+  const reset = () => {
+    rawStreaming = false;
+    inputStreaming = false;
+    mode = "command";
+    lineBuffer = "";
+    bitmapBuffer = null;
+    settings = new Map(flashSettings);
+    PAD_NAMES.forEach((pad) => {
+      previousRaw[pad] = 0;
+      lastHit[pad] = -Infinity;
+      releaseAt[pad] = -Infinity;
+    });
+    lastDonHit = -Infinity;
+    lastKaHit = -Infinity;
+  };
+
+  return emulator;
+}
@@ -0,0 +1,33 @@
+import type { DeviceConfig } from "@/types";
+
+// Device identity
+// Web Serial only exposes the USB vendor/product id, not the serial number,
+// so every ITAIKO drum of the same model has the same device key. A record
+// keyed by it may belong to any drum of that model; whatever must only apply
+// to the drum it came from stays with the device session instead.
+
+export function getDeviceKey(port: SerialPort | null): string | null {
+  if (!port) return null;
+  const { usbVendorId, usbProductId } = port.getInfo();
+  if (usbVendorId === undefined) return null;
+  const hex = (v: number | undefined) => (v ?? 0).toString(16).padStart(4, "0");
+  return `${hex(usbVendorId)}:${hex(usbProductId)}`;
+}
+
+// FNV-1a over the device settings (32-bit hex)
+export function getConfigFingerprint(config: DeviceConfig): string {
+  const text = JSON.stringify([
+    config.firmwareVersion ?? "",
+    config.pads,
+    config.doubleInputMode,
+    config.timing,
+    config.keyMappings ?? null,
+    config.adcChannels ?? null,
+  ]);
+  let hash = 0x811c9dc5;
+  for (let i = 0; i < text.length; i++) {
+    hash ^= text.charCodeAt(i);
+    hash = Math.imul(hash, 0x01000193);
+  }
+  return (hash >>> 0).toString(16).padStart(8, "0");
+}
@@ -0,0 +1,60 @@
+import { PICO_VENDOR_ID } from "@/types";
+
+// Device readiness for the update and recovery flows
+// Instead of sleeping for a fixed time, each phase waits for the event that
+// means the device is ready: the serial port going away when it enters
+// BOOTSEL, coming back after flashing, or the RPI-RP2 drive mounting (see
+// boot-drive.ts). Timeouts are upper bounds only.
+
+const isPico = (port: SerialPort) => port.getInfo().usbVendorId === PICO_VENDOR_ID;
+
+// Resolves with the port on the next navigator.serial connect/disconnect
+// event for the device, or null on timeout. Call it before triggering the
+// change so the event cannot be missed.
+export function waitForSerialEvent(
+  type: "connect" | "disconnect",
+  timeoutMs: number,
+  signal?: AbortSignal
+): Promise<SerialPort | null> {
+  if (typeof navigator === "undefined" || !("serial" in navigator)) return Promise.resolve(null);
+
+  return new Promise((resolve) => {
+    const done = (port: SerialPort | null) => {
+      clearTimeout(timer);
+      navigator.serial.removeEventListener(type, onEvent);
+      signal?.removeEventListener("abort", onAbort);
+      resolve(port);
+    };
+    const onAbort = () => done(null);
+    const onEvent = (event: Event) => {
+      const port = event.target as SerialPort;
+      if (isPico(port)) done(port);
+    };
+    const timer = setTimeout(() => done(null), timeoutMs);
+    navigator.serial.addEventListener(type, onEvent);
+    signal?.addEventListener("abort", onAbort);
+  });
+}
+
+// An authorized device that is already present, else the next one to connect
+export async function waitForSerialDevice(timeoutMs: number): Promise<SerialPort | null> {
+  if (typeof navigator === "undefined" || !("serial" in navigator)) return null;
+  const cancel = new AbortController();
+  const next = waitForSerialEvent("connect", timeoutMs, cancel.signal);
+  const present = (await navigator.serial.getPorts()).find(isPico);
+  if (!present) return next;
+  cancel.abort();
+  return present;
+}
+
+// Logs how long a phase really took: "[update] bootsel: 412 ms"
+export function startPhase(flow: string, phase: string): { end: (outcome?: string) => number } {
+  const start = performance.now();
+  return {
+    end: (outcome) => {
+      const ms = Math.round(performance.now() - start);
+      console.log(`[${flow}] ${phase}: ${ms} ms${outcome ? ` (${outcome})` : ""}`);
+      return ms;
+    },
+  };
+}
@@ -0,0 +1,221 @@
+// Boot screen conversion: 128x64 RGBA -> 1-bit monochrome BMP
+// Pure functions shared by the conversion worker. Bit 1 = lit OLED pixel.
+
+export const BOOT_SCREEN_WIDTH = 128;
+export const BOOT_SCREEN_HEIGHT = 64;
+
+export type DitherMethod = "floyd-steinberg" | "atkinson" | "bayer" | "threshold";
+
+export const DITHER_METHODS: { value: DitherMethod; label: string }[] = [
+  { value: "floyd-steinberg", label: "Floyd–Steinberg" },
+  { value: "atkinson", label: "Atkinson" },
+  { value: "bayer", label: "Bayer (ordered)" },
+  { value: "threshold", label: "Threshold" },
+];
+
+export interface DitherOptions {
+  method: DitherMethod;
+  brightness: number;  // -100 to 100
+  contrast: number;    // -100 to 100
+  threshold: number;   // 0 to 255, cut-off for threshold/bayer and error diffusion
+  invert: boolean;
+}
+
+export const DEFAULT_DITHER_OPTIONS: DitherOptions = {
+  method: "floyd-steinberg",
+  brightness: 0,
+  contrast: 0,
+  threshold: 128,
+  invert: false,
+};
+
+// 8x8 Bayer matrix (0-63)
+const BAYER_8 = new Uint8Array([
+   0, 32,  8, 40,  2, 34, 10, 42,
+  48, 16, 56, 24, 50, 18, 58, 26,
+  12, 44,  4, 36, 14, 46,  6, 38,
+  60, 28, 52, 20, 62, 30, 54, 22,
+   3, 35, 11, 43,  1, 33,  9, 41,
+  51, 19, 59, 27, 49, 17, 57, 25,
+  15, 47,  7, 39, 13, 45,  5, 37,
+  63, 31, 55, 23, 61, 29, 53, 21,
+]);
+
+// Luminance (Rec. 601) with brightness/contrast applied, 0-255
+export function toLuminance(rgba: Uint8ClampedArray, options: DitherOptions, out?: Float32Array): Float32Array {
+  const pixels = rgba.length / 4;
+  const lum = out ?? new Float32Array(pixels);
+  const c = options.contrast * 2.55;
+  const contrastFactor = (259 * (c + 255)) / (255 * (259 - c));
+  const brightness = options.brightness * 2.55;
+
+  for (let i = 0, p = 0; p < pixels; i += 4, p++) {
+    // Transparent areas are white like the old converter
+    const alpha = rgba[i + 3] / 255;
+    const y = (0.299 * rgba[i] + 0.587 * rgba[i + 1] + 0.114 * rgba[i + 2]) * alpha + 255 * (1 - alpha);
+    const v = (y - 128) * contrastFactor + 128 + brightness;
+    lum[p] = v < 0 ? 0 : v > 255 ? 255 : v;
+  }
+  return lum;
+}
+
+// Error diffusion over a serpentine scan. `lum` is modified in place.
+function diffuse(lum: Float32Array, width: number, height: number, threshold: number, out: Uint8Array, atkinson: boolean): void {
+  for (let y = 0; y < height; y++) {
+    const reverse = (y & 1) === 1;
+    const dir = reverse ? -1 : 1;
+    for (let n = 0; n < width; n++) {
+      const x = reverse ? width - 1 - n : n;
+      const idx = y * width + x;
+      const old = lum[idx];
+      const bit = old >= threshold ? 1 : 0;
+      out[idx] = bit;
+      const err = old - (bit ? 255 : 0);
+
+      const xf = x + dir;
+      const xb = x - dir;
+      const hasF = xf >= 0 && xf < width;
+      const hasB = xb >= 0 && xb < width;
+      const below = idx + width;
+
+      if (atkinson) {
+        // 6/8 of the error, spread to six neighbours
+        const e = err / 8;
+        if (hasF) lum[idx + dir] += e;
+        if (xf + dir >= 0 && xf + dir < width) lum[idx + 2 * dir] += e;
+        if (y + 1 < height) {
+          if (hasB) lum[below - dir] += e;
+          lum[below] += e;
+          if (hasF) lum[below + dir] += e;
+        }
+        if (y + 2 < height) lum[below + width] += e;
+      } else {
+        if (hasF) lum[idx + dir] += (err * 7) / 16;
+        if (y + 1 < height) {
+          if (hasB) lum[below - dir] += (err * 3) / 16;
+          lum[below] += (err * 5) / 16;
+          if (hasF) lum[below + dir] += err / 16;
+        }
+      }
+    }
+  }
+}
+
+// One byte (0/1) per pixel, row-major top to bottom
+export function ditherLuminance(lum: Float32Array, width: number, height: number, options: DitherOptions, out?: Uint8Array): Uint8Array {
+  const bits = out ?? new Uint8Array(width * height);
+  const { method, threshold } = options;
+
+  if (method === "floyd-steinberg" || method === "atkinson") {
+    diffuse(lum, width, height, threshold, bits, method === "atkinson");
+  } else if (method === "bayer") {
+    // Matrix centred on the threshold
+    const offset = threshold - 128;
+    for (let y = 0; y < height; y++) {
+      for (let x = 0; x < width; x++) {
+        const idx = y * width + x;
+        const t = ((BAYER_8[(y & 7) * 8 + (x & 7)] + 0.5) / 64) * 255 + offset;
+        bits[idx] = lum[idx] >= t ? 1 : 0;
+      }
+    }
+  } else {
+    for (let i = 0; i < lum.length; i++) bits[i] = lum[i] >= threshold ? 1 : 0;
+  }
+
+  if (options.invert) {
+    for (let i = 0; i < bits.length; i++) bits[i] ^= 1;
+  }
+  return bits;
+}
+
+// 1-bit BMP with a black/white palette. Rows are bottom-up and padded to
+// 4 bytes; bits are packed a whole byte at a time.
+export function encodeMonochromeBmp(bits: Uint8Array, width: number, height: number): Uint8Array {
+  const rowSize = Math.ceil(width / 32) * 4;
+  const pixelArraySize = rowSize * height;
+  const fileHeaderSize = 14;
+  const infoHeaderSize = 40;
+  const colorTableSize = 8; // 2 colors * 4 bytes
+  const pixelDataStart = fileHeaderSize + infoHeaderSize + colorTableSize;
+  const fileSize = pixelDataStart + pixelArraySize;
+
+  const bmp = new Uint8Array(fileSize);
+  const view = new DataView(bmp.buffer);
+
+  // --- Bitmap File Header ---
+  view.setUint16(0, 0x4d42, true); // "BM"
+  view.setUint32(2, fileSize, true);
+  view.setUint32(10, pixelDataStart, true);
+
+  // --- Bitmap Info Header (BITMAPINFOHEADER) ---
+  view.setUint32(14, infoHeaderSize, true);
+  view.setInt32(18, width, true);
+  view.setInt32(22, height, true); // Positive = bottom-up
+  view.setUint16(26, 1, true); // Planes
+  view.setUint16(28, 1, true); // Bits per pixel
+  view.setUint32(30, 0, true); // BI_RGB
+  view.setUint32(34, pixelArraySize, true);
+  view.setUint32(46, 2, true); // Colors used
+  view.setUint32(50, 2, true); // Important colors
+
+  // --- Color Table: 0 = black (off), 1 = white (lit) ---
+  view.setUint32(54, 0x00000000, true);
+  view.setUint32(58, 0x00ffffff, true);
+
+  // --- Pixel Data ---
+  for (let row = 0; row < height; row++) {
+    const src = (height - 1 - row) * width;
+    let dst = pixelDataStart + row * rowSize;
+    for (let x = 0; x < width; x += 8) {
+      let byte = 0;
+      for (let b = 0; b < 8; b++) {
+        byte = (byte << 1) | (x + b < width ? bits[src + x + b] : 0);
+      }
+      bmp[dst++] = byte;
+    }
+  }
+
+  return bmp;
+}
+
+// Preview pixels as they will look on the OLED
+export function renderBits(bits: Uint8Array, out?: Uint8ClampedArray): Uint8ClampedArray {
+  const rgba = out ?? new Uint8ClampedArray(bits.length * 4);
+  for (let i = 0, o = 0; i < bits.length; i++, o += 4) {
+    const v = bits[i] ? 255 : 0;
+    rgba[o] = v;
+    rgba[o + 1] = v;
+    rgba[o + 2] = v;
+    rgba[o + 3] = 255;
+  }
+  return rgba;
+}
+
+// Inverse of encodeMonochromeBmp for stored bitmaps (gallery thumbnails).
+// Returns null for anything other than a 1-bit BMP.
+export function decodeMonochromeBmp(bmp: Uint8Array): { bits: Uint8Array; width: number; height: number } | null {
+  if (bmp.length < 62 || bmp[0] !== 0x42 || bmp[1] !== 0x4d) return null;
+  const view = new DataView(bmp.buffer, bmp.byteOffset, bmp.byteLength);
+  const pixelDataStart = view.getUint32(10, true);
+  const width = view.getInt32(18, true);
+  const rawHeight = view.getInt32(22, true);
+  if (view.getUint16(28, true) !== 1 || width <= 0 || rawHeight === 0) return null;
+
+  const height = Math.abs(rawHeight);
+  const rowSize = Math.ceil(width / 32) * 4;
+  if (pixelDataStart + rowSize * height > bmp.length) return null;
+
+  // Palette index 1 may be black in BMPs from other tools
+  const paletteOne = 14 + view.getUint32(14, true) + 4;
+  const litIndex = view.getUint32(paletteOne, true) & 0xffffff ? 1 : 0;
+  const bits = new Uint8Array(width * height);
+  for (let row = 0; row < height; row++) {
+    const y = rawHeight > 0 ? height - 1 - row : row;
+    const src = pixelDataStart + row * rowSize;
+    for (let x = 0; x < width; x++) {
+      const bit = (bmp[src + (x >> 3)] >> (7 - (x & 7))) & 1;
+      bits[y * width + x] = bit === litIndex ? 1 : 0;
+    }
+  }
+  return { bits, width, height };
+}
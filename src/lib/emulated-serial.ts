@@ -0,0 +1,253 @@
+import { PICO_VENDOR_ID } from "@/types";
+import type { DeviceEmulator } from "@/lib/device-emulator";
+
+// Web Serial shim for the device emulator
+// EmulatedSerialPort behaves like a real SerialPort (open/close, readable/writable,
+// connect/disconnect events) so useWebSerial can run against it unchanged.
+// The link between host and device can be slowed down to reproduce slow USB
+// hubs and overload conditions.
+
+export interface EmulatedLinkOptions {
+  latencyMs?: number;        // One-way delay for every transfer
+  jitterMs?: number;         // Random extra delay (0 - jitterMs)
+  bytesPerSecond?: number;   // Throughput cap in both directions (Infinity = unlimited)
+  writeBufferSize?: number;  // Host write queue high-water mark (bytes), drives writer.desiredSize
+  txBufferSize?: number;     // Device transmit buffer (bytes), overflow is dropped
+  bootselReturnMs?: number;  // Re-enumerate as CDC this long after a BOOTSEL reboot (undefined = stay gone)
+}
+
+export interface EmulatedPortStats {
+  bytesToDevice: number;
+  bytesToHost: number;
+  droppedToHost: number;
+}
+
+function deviceLostError(): DOMException {
+  return new DOMException("The device has been lost.", "NetworkError");
+}
+
+export class EmulatedSerialPort extends EventTarget implements SerialPort {
+  readonly emulator: DeviceEmulator;
+  readonly stats: EmulatedPortStats = { bytesToDevice: 0, bytesToHost: 0, droppedToHost: 0 };
+  connected = true;
+
+  private link: Required<Omit<EmulatedLinkOptions, "bootselReturnMs">> & { bootselReturnMs?: number };
+  private usbProductId: number;
+  private readableStream: ReadableStream<Uint8Array> | null = null;
+  private writableStream: WritableStream<Uint8Array> | null = null;
+  private readController: ReadableStreamDefaultController<Uint8Array> | null = null;
+  private hostReadyAt = 0;     // When the device -> host pipe is free again
+  private deviceReadyAt = 0;   // When the host -> device pipe is free again
+  private inFlightToHost = 0;
+  private timers = new Set<ReturnType<typeof setTimeout>>();
+  // Writes still leaving the host; they fail like a real port's on unplug
+  private pendingWrites = new Set<(error: DOMException) => void>();
+
+  onRemoved: ((port: EmulatedSerialPort) => void) | null = null;
+  onAdded: ((port: EmulatedSerialPort) => void) | null = null;
+
+  constructor(emulator: DeviceEmulator, link: EmulatedLinkOptions = {}, usbProductId = 0x0001) {
+    super();
+    this.emulator = emulator;
+    this.usbProductId = usbProductId;
+    this.link = {
+      latencyMs: link.latencyMs ?? 1,
+      jitterMs: link.jitterMs ?? 0,
+      bytesPerSecond: link.bytesPerSecond ?? Infinity,
+      writeBufferSize: link.writeBufferSize ?? 255,
+      txBufferSize: link.txBufferSize ?? 64 * 1024,
+      bootselReturnMs: link.bootselReturnMs,
+    };
+    emulator.onOutput = (data) => this.deliverToHost(data);
+    emulator.onReboot = () => this.handleReboot();
+    emulator.powerOn();
+  }
+
+  get readable(): ReadableStream<Uint8Array> | null {
+    return this.readableStream;
+  }
+
+  get writable(): WritableStream<Uint8Array> | null {
+    return this.writableStream;
+  }
+
+  getInfo(): SerialPortInfo {
+    return { usbVendorId: PICO_VENDOR_ID, usbProductId: this.usbProductId };
+  }
+
+  setLink(link: EmulatedLinkOptions): void {
+    Object.assign(this.link, link);
+  }
+
+  async open(_options: SerialOptions): Promise<void> {
+    if (!this.connected) throw new DOMException("The device has been lost.", "NetworkError");
+    if (this.readableStream) throw new DOMException("The port is already open.", "InvalidStateError");
+
+    this.readableStream = new ReadableStream<Uint8Array>({
+      start: (controller) => {
+        this.readController = controller;
+      },
+      cancel: () => {
+        this.readController = null;
+      },
+    });
+
+    this.writableStream = new WritableStream<Uint8Array>(
+      {
+        write: (chunk) => this.transmitToDevice(chunk),
+      },
+      new ByteLengthQueuingStrategy({ highWaterMark: this.link.writeBufferSize })
+    );
+  }
+
+  async close(): Promise<void> {
+    if (!this.readableStream) throw new DOMException("The port is already closed.", "InvalidStateError");
+    if (this.readableStream.locked || this.writableStream?.locked) {
+      throw new TypeError("Cannot close a port with locked streams.");
+    }
+    this.readController = null;
+    this.readableStream = null;
+    this.writableStream = null;
+  }
+
+  // Simulate pulling the cable (or plugging it back in)
+  unplug(): void {
+    if (!this.connected) return;
+    this.connected = false;
+    this.emulator.powerOff();
+    this.failStreams();
+    this.dispatchEvent(new Event("disconnect"));
+    this.onRemoved?.(this);
+  }
+
+  plug(): void {
+    if (this.connected) return;
+    this.connected = true;
+    this.emulator.powerOn();
+    this.dispatchEvent(new Event("connect"));
+    this.onAdded?.(this);
+  }
+
+  private failStreams(): void {
+    this.timers.forEach((t) => clearTimeout(t));
+    this.timers.clear();
+    this.pendingWrites.forEach((reject) => reject(deviceLostError()));
+    this.pendingWrites.clear();
+    this.inFlightToHost = 0;
+    try {
+      this.readController?.error(deviceLostError());
+    } catch {
+      // Stream already closed
+    }
+    this.readController = null;
+    this.readableStream = null;
+    this.writableStream = null;
+  }
+
+  private handleReboot(): void {
+    // Let the reboot command finish on the host side before the port vanishes
+    this.schedule(() => {
+      this.unplug();
+      if (this.link.bootselReturnMs !== undefined) {
+        this.schedule(() => this.plug(), this.link.bootselReturnMs);
+      }
+    }, this.link.latencyMs);
+  }
+
+  private schedule(fn: () => void, delayMs: number): void {
+    const timer = setTimeout(() => {
+      this.timers.delete(timer);
+      fn();
+    }, Math.max(0, delayMs));
+    this.timers.add(timer);
+  }
+
+  private transferDelay(bytes: number, readyAt: number): { start: number; end: number } {
+    const now = performance.now();
+    const start = Math.max(now, readyAt);
+    const duration = Number.isFinite(this.link.bytesPerSecond) ? (bytes / this.link.bytesPerSecond) * 1000 : 0;
+    return { start, end: start + duration };
+  }
+
+  private jitter(): number {
+    return this.link.jitterMs > 0 ? Math.random() * this.link.jitterMs : 0;
+  }
+
+  // Host -> device. Resolves once the bytes left the host, which is what
+  // backs writer.ready / desiredSize on a real port.
+  private transmitToDevice(chunk: Uint8Array): Promise<void> {
+    if (!this.connected) return Promise.reject(deviceLostError());
+    const data = chunk.slice();
+    const { end } = this.transferDelay(data.length, this.deviceReadyAt);
+    this.deviceReadyAt = end;
+    this.stats.bytesToDevice += data.length;
+
+    const sentIn = end - performance.now();
+    this.schedule(() => this.emulator.receive(data), sentIn + this.link.latencyMs + this.jitter());
+    return new Promise((resolve, reject) => {
+      this.pendingWrites.add(reject);
+      this.schedule(() => {
+        this.pendingWrites.delete(reject);
+        resolve();
+      }, sentIn);
+    });
+  }
+
+  // Device -> host, dropped when the device transmit buffer is full
+  private deliverToHost(data: Uint8Array): void {
+    if (!this.readController) return; // Port closed: output goes nowhere
+    if (this.inFlightToHost + data.length > this.link.txBufferSize) {
+      this.stats.droppedToHost += data.length;
+      return;
+    }
+    this.inFlightToHost += data.length;
+
+    const { end } = this.transferDelay(data.length, this.hostReadyAt);
+    this.hostReadyAt = end;
+
+    this.schedule(() => {
+      this.inFlightToHost -= data.length;
+      if (!this.readController) return;
+      this.stats.bytesToHost += data.length;
+      this.readController.enqueue(data);
+    }, end - performance.now() + this.link.latencyMs + this.jitter());
+  }
+}
+
+// navigator.serial replacement holding emulated ports
+export class EmulatedSerial extends EventTarget implements Serial {
+  private ports: EmulatedSerialPort[] = [];
+
+  addPort(port: EmulatedSerialPort): void {
+    this.ports.push(port);
+    port.onAdded = (p) => this.forward("connect", p);
+    port.onRemoved = (p) => this.forward("disconnect", p);
+  }
+
+  async requestPort(_options?: SerialPortRequestOptions): Promise<SerialPort> {
+    const port = this.ports.find((p) => p.connected);
+    if (!port) throw new DOMException("No port selected by the user.", "NotFoundError");
+    return port;
+  }
+
+  async getPorts(): Promise<SerialPort[]> {
+    return this.ports.filter((p) => p.connected);
+  }
+
+  // Real ports bubble connect/disconnect to navigator.serial with the port as target
+  private forward(type: "connect" | "disconnect", port: EmulatedSerialPort): void {
+    const event = new Event(type);
+    Object.defineProperty(event, "target", { value: port });
+    this.dispatchEvent(event);
+  }
+}
+
+// Replace navigator.serial, returns a function restoring the original
+export function installEmulatedSerial(serial: EmulatedSerial): () => void {
+  const original = Object.getOwnPropertyDescriptor(navigator, "serial");
+  Object.defineProperty(navigator, "serial", { value: serial, configurable: true });
+  return () => {
+    if (original) Object.defineProperty(navigator, "serial", original);
+    else delete (navigator as { serial?: Serial }).serial;
+  };
+}
@@ -0,0 +1,72 @@
+import { compareVersions } from "@/lib/utils";
+
+// Firmware release manifest (public/firmware/manifest.json)
+// Lists every release the app can install, newest first. minVersion and
+// maxVersion bound the firmware a release can be installed over with the
+// device settings intact. The last manifest seen is kept so updates and
+// rollbacks still work offline.
+
+export interface FirmwareRelease {
+  version: string;
+  file: string;          // Relative to /firmware/
+  size: number;
+  sha256: string;
+  minVersion?: string;   // Oldest installed firmware it can replace
+  maxVersion?: string;   // Newest installed firmware it can replace (rollbacks)
+  date?: string;
+  notes?: string;
+}
+
+export interface FirmwareManifest {
+  latest: string;
+  releases: FirmwareRelease[];
+}
+
+export const FIRMWARE_MANIFEST_URL = "/firmware/manifest.json";
+const CACHE_KEY = "itaiko-firmware-manifest";
+
+export function getReleaseUrl(release: FirmwareRelease): string {
+  return `/firmware/${release.file}`;
+}
+
+function isValidManifest(value: unknown): value is FirmwareManifest {
+  const manifest = value as FirmwareManifest;
+  return (
+    typeof manifest?.latest === "string" &&
+    Array.isArray(manifest.releases) &&
+    manifest.releases.every(
+      (r) => typeof r.version === "string" && typeof r.file === "string" && typeof r.size === "number" && /^[0-9a-f]{64}$/i.test(r.sha256)
+    )
+  );
+}
+
+// Network first; the cached copy only when offline or the fetch fails
+export async function loadFirmwareManifest(): Promise<{ manifest: FirmwareManifest; offline: boolean }> {
+  try {
+    const response = await fetch(FIRMWARE_MANIFEST_URL, { cache: "no-cache" });
+    if (!response.ok) throw new Error(`Failed to fetch firmware manifest (${response.status})`);
+    const manifest: unknown = await response.json();
+    if (!isValidManifest(manifest)) throw new Error("Invalid firmware manifest");
+    manifest.releases.sort((a, b) => compareVersions(b.version, a.version));
+    localStorage.setItem(CACHE_KEY, JSON.stringify(manifest));
+    return { manifest, offline: false };
+  } catch (err) {
+    const cached = localStorage.getItem(CACHE_KEY);
+    const manifest: unknown = cached ? JSON.parse(cached) : null;
+    if (!isValidManifest(manifest)) throw err;
+    console.warn("Using cached firmware manifest:", err);
+    return { manifest, offline: true };
+  }
+}
+
+export function findRelease(manifest: FirmwareManifest, version: string): FirmwareRelease | null {
+  return manifest.releases.find((r) => compareVersions(r.version, version) === 0) ?? null;
+}
+
+// Whether `release` can be installed over `installedVersion`
+export function isReleaseCompatible(release: FirmwareRelease, installedVersion: string | undefined): boolean {
+  if (!installedVersion) return true;
+  if (release.minVersion && compareVersions(installedVersion, release.minVersion) < 0) return false;
+  if (release.maxVersion && compareVersions(installedVersion, release.maxVersion) > 0) return false;
+  return true;
+}
@@ -0,0 +1,118 @@
+import { createUf2ValidationStream } from "@/lib/uf2";
+import { getReleaseUrl, type FirmwareRelease } from "@/lib/firmware-manifest";
+
+// Local firmware copies in the Origin Private File System
+// Files are stored as firmware/<sha256>.uf2. The service worker fills the
+// cache in the background (public/firmware-sw.js, same layout); without a
+// service worker (dev server) the page does it itself. An update then starts
+// from the local copy and needs no network.
+
+const DIRECTORY = "firmware";
+const PRECACHE_MESSAGE = "ITAIKO_FIRMWARE_PRECACHE";
+// Leaves room for the downloads; a stale service worker never answers
+const PRECACHE_TIMEOUT_MS = 60000;
+
+export const isFirmwareStoreSupported =
+  typeof navigator !== "undefined" && typeof navigator.storage?.getDirectory === "function";
+
+export interface PrecacheResult {
+  stored: string[];  // sha256 of every release now available offline
+  failed: { sha256: string; error: string }[];
+}
+
+async function getDirectory(): Promise<FileSystemDirectoryHandle> {
+  const root = await navigator.storage.getDirectory();
+  return root.getDirectoryHandle(DIRECTORY, { create: true });
+}
+
+const fileName = (release: FirmwareRelease) => `${release.sha256.toLowerCase()}.uf2`;
+
+// The stored image, or null if it is missing or incomplete
+export async function getStoredFirmware(release: FirmwareRelease): Promise<File | null> {
+  if (!isFirmwareStoreSupported) return null;
+  try {
+    const file = await (await (await getDirectory()).getFileHandle(fileName(release))).getFile();
+    return file.size === release.size ? file : null;
+  } catch {
+    return null;
+  }
+}
+
+export async function listStoredFirmware(): Promise<Set<string>> {
+  const hashes = new Set<string>();
+  if (!isFirmwareStoreSupported) return hashes;
+  try {
+    // keys() is missing from lib.dom's FileSystemDirectoryHandle
+    const directory = (await getDirectory()) as FileSystemDirectoryHandle & { keys(): AsyncIterable<string> };
+    for await (const name of directory.keys()) {
+      if (name.endsWith(".uf2")) hashes.add(name.slice(0, -4));
+    }
+  } catch (err) {
+    console.warn("Firmware store unavailable:", err);
+  }
+  return hashes;
+}
+
+// Downloads and verifies one release. createWritable() only replaces the
+// file when the stream completes, so a failed download leaves nothing behind.
+async function storeFirmware(release: FirmwareRelease): Promise<void> {
+  const response = await fetch(getReleaseUrl(release), { cache: "no-cache" });
+  if (!response.ok || !response.body) throw new Error(`Download failed: ${response.status}`);
+  const handle = await (await getDirectory()).getFileHandle(fileName(release), { create: true });
+  await response.body
+    .pipeThrough(createUf2ValidationStream({ expectedSize: release.size, expectedSha256: release.sha256 }))
+    .pipeTo(await handle.createWritable());
+}
+
+async function precacheInPage(releases: FirmwareRelease[]): Promise<PrecacheResult> {
+  const result: PrecacheResult = { stored: [], failed: [] };
+  const keep = new Set(releases.map(fileName));
+  const directory = await getDirectory();
+
+  for (const release of releases) {
+    try {
+      if (!(await getStoredFirmware(release))) await storeFirmware(release);
+      result.stored.push(release.sha256.toLowerCase());
+    } catch (err) {
+      await directory.removeEntry(fileName(release)).catch(() => {});
+      result.failed.push({ sha256: release.sha256, error: err instanceof Error ? err.message : String(err) });
+    }
+  }
+
+  for (const hash of await listStoredFirmware()) {
+    if (!keep.has(`${hash}.uf2`)) await directory.removeEntry(`${hash}.uf2`).catch(() => {});
+  }
+  return result;
+}
+
+// Makes exactly `releases` available offline (others are removed)
+export async function precacheFirmware(releases: FirmwareRelease[]): Promise<PrecacheResult> {
+  if (!isFirmwareStoreSupported) return { stored: [], failed: [] };
+
+  const worker = navigator.serviceWorker?.controller;
+  if (!worker) return precacheInPage(releases);
+
+  const reply = await new Promise<PrecacheResult | null>((resolve) => {
+    const channel = new MessageChannel();
+    const timer = setTimeout(() => {
+      channel.port1.close();
+      resolve(null);
+    }, PRECACHE_TIMEOUT_MS);
+    channel.port1.onmessage = (event: MessageEvent<PrecacheResult>) => {
+      clearTimeout(timer);
+      channel.port1.close();
+      resolve(event.data);
+    };
+    worker.postMessage(
+      {
+        type: PRECACHE_MESSAGE,
+        releases: releases.map((r) => ({ url: getReleaseUrl(r), sha256: r.sha256.toLowerCase(), size: r.size })),
+      },
+      [channel.port2]
+    );
+  });
+  if (reply) return reply;
+
+  console.warn("Service worker did not answer the firmware precache, storing in the page");
+  return precacheInPage(releases);
+}
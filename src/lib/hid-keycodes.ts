@@ -255,3 +255,13 @@ export function hidToKeyName(hid: number): string {
 export function browserKeyToHid(event: KeyboardEvent): number | null {
   return BROWSER_KEY_TO_HID[event.code] ?? null;
 }
+
+/**
+ * Convert HID keycode to a browser KeyboardEvent.code (first match)
+ */
+export function hidToBrowserCode(hid: number): string | null {
+  for (const code in BROWSER_KEY_TO_HID) {
+    if (BROWSER_KEY_TO_HID[code] === hid) return code;
+  }
+  return null;
+}
@@ -0,0 +1,99 @@
+// Minimal promise wrapper around the app's IndexedDB database
+// Stores are created in upgrade(); bump DB_VERSION and add a step there when
+// adding one.
+
+const DB_NAME = "itaiko";
+const DB_VERSION = 5;
+
+export type StoreName =
+  | "bootScreens"        // Converted boot screen bitmaps, keyed by content hash
+  | "fileHandles"        // Persisted File System Access handles (RPI-RP2 drive)
+  | "configSnapshots"    // Settings taken before a firmware update, keyed by snapshot id
+  | "deviceConfigs";     // Last settings read per device key
+
+let dbPromise: Promise<IDBDatabase> | null = null;
+
+function upgrade(db: IDBDatabase, oldVersion: number): void {
+  if (oldVersion < 1) {
+    db.createObjectStore("bootScreens", { keyPath: "hash" });
+    db.createObjectStore("deviceBootScreens");
+  }
+  if (oldVersion < 2) {
+    db.createObjectStore("fileHandles");
+  }
+  if (oldVersion < 3) {
+    db.createObjectStore("configSnapshots");
+  }
+  if (oldVersion < 4) {
+    db.createObjectStore("deviceConfigs");
+  }
+  if (oldVersion < 5) {
+    // Boot screen upload memory moved into the device session
+    db.deleteObjectStore("deviceBootScreens");
+  }
+}
+
+export function openDatabase(): Promise<IDBDatabase> {
+  if (dbPromise) return dbPromise;
+
+  dbPromise = new Promise<IDBDatabase>((resolve, reject) => {
+    const request = indexedDB.open(DB_NAME, DB_VERSION);
+    request.onupgradeneeded = (event) => upgrade(request.result, event.oldVersion);
+    request.onsuccess = () => {
+      const db = request.result;
+      // Another tab upgraded the schema: let it proceed, reopen on next use
+      db.onversionchange = () => {
+        db.close();
+        dbPromise = null;
+      };
+      resolve(db);
+    };
+    request.onerror = () => reject(request.error);
+    request.onblocked = () => console.warn("IndexedDB upgrade blocked by another tab");
+  });
+  dbPromise.catch(() => {
+    dbPromise = null;
+  });
+  return dbPromise;
+}
+
+function promisify<T>(request: IDBRequest<T>): Promise<T> {
+  return new Promise((resolve, reject) => {
+    request.onsuccess = () => resolve(request.result);
+    request.onerror = () => reject(request.error);
+  });
+}
+
+async function withStore<T>(
+  store: StoreName,
+  mode: IDBTransactionMode,
+  fn: (objectStore: IDBObjectStore) => IDBRequest<T>
+): Promise<T> {
+  const db = await openDatabase();
+  const tx = db.transaction(store, mode);
+  const result = await promisify(fn(tx.objectStore(store)));
+  if (mode === "readwrite") {
+    await new Promise<void>((resolve, reject) => {
+      tx.oncomplete = () => resolve();
+      tx.onerror = () => reject(tx.error);
+      tx.onabort = () => reject(tx.error);
+    });
+  }
+  return result;
+}
+
+export function idbGet<T>(store: StoreName, key: IDBValidKey): Promise<T | undefined> {
+  return withStore(store, "readonly", (s) => s.get(key) as IDBRequest<T | undefined>);
+}
+
+export function idbGetAll<T>(store: StoreName): Promise<T[]> {
+  return withStore(store, "readonly", (s) => s.getAll() as IDBRequest<T[]>);
+}
+
+export async function idbPut<T>(store: StoreName, value: T, key?: IDBValidKey): Promise<void> {
+  await withStore(store, "readwrite", (s) => s.put(value, key));
+}
+
+export async function idbDelete(store: StoreName, key: IDBValidKey): Promise<void> {
+  await withStore(store, "readwrite", (s) => s.delete(key));
+}
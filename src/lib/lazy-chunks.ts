@@ -0,0 +1,49 @@
+import { lazy, type ComponentType, type LazyExoticComponent } from "react";
+import { loadHelpContent } from "@/components/ui/help-modal";
+
+// Code-split parts of the configurator
+// Heavy features load on first use. The loaders are shared by the lazy
+// components and prefetchChunks(), so once a drum is ready the chunks are
+// fetched while the browser is idle and are already there when opened.
+
+export const chunkLoaders = {
+  liveMonitor: () => import("@/components/monitor/LiveMonitorTab"),   // + webgl-plot
+  keyMapping: () => import("@/components/configuration/InteractiveKeyMapping"),
+  bootScreenEditor: () => import("@/components/configuration/BootScreenEditor"),
+  firmwareUpdateModal: () => import("@/components/connection/FirmwareUpdateModal"),
+  recoveryModal: () => import("@/components/connection/EmergencyRecoveryModal"),
+  lottie: () => import("@lottiefiles/dotlottie-react"),
+  helpContent: loadHelpContent,
+};
+
+// React.lazy for a named export
+export function lazyNamed<M extends Record<K, ComponentType<never>>, K extends keyof M>(
+  load: () => Promise<M>,
+  name: K
+): LazyExoticComponent<M[K]> {
+  return lazy(() => load().then((module) => ({ default: module[name] })));
+}
+
+const IDLE_TIMEOUT_MS = 5000;
+
+const whenIdle = (fn: () => void) =>
+  typeof requestIdleCallback === "function"
+    ? requestIdleCallback(fn, { timeout: IDLE_TIMEOUT_MS })
+    : setTimeout(fn, 200);  // Safari
+
+let prefetchStarted = false;
+
+// Fetches every chunk, one per idle period. Runs once per page load.
+export function prefetchChunks(): void {
+  if (prefetchStarted) return;
+  prefetchStarted = true;
+  const queue = Object.values(chunkLoaders);
+  const next = () => {
+    const load = queue.shift();
+    if (!load) return;
+    whenIdle(() => {
+      load().catch(() => {}).finally(next);
+    });
+  };
+  next();
+}
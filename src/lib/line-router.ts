@@ -0,0 +1,128 @@
+// Routing of received serial lines
+// Each line goes to the first waitForLine() waiter it matches, else to the
+// streaming callback, else into a bounded queue read by readUntilTimeout().
+// Listeners see every line before it is routed (cross-tab sharing).
+
+interface LineWaiter {
+  match: (line: string) => boolean;
+  resolve: (line: string | null) => void;
+}
+
+const MAX_QUEUED_LINES = 1000;
+
+export interface LineRouter {
+  push: (line: string) => void;
+  onData: ((line: string) => void) | null;
+  listen: (listener: (line: string) => void) => () => void;
+  readLine: () => Promise<string | null>;
+  readUntilTimeout: (timeoutMs?: number) => Promise<string>;
+  waitForLine: (match: (line: string) => boolean, timeoutMs?: number) => Promise<string | null>;
+  clear: () => void;
+  // Resolve every pending waitForLine with null (port closed or lost)
+  cancelWaiters: () => void;
+  readonly queued: number;
+}
+
+export function createLineRouter(): LineRouter {
+  let queue: string[] = [];
+  const waiters: LineWaiter[] = [];
+  const listeners = new Set<(line: string) => void>();
+
+  const router: LineRouter = {
+    onData: null,
+
+    push(line) {
+      if (listeners.size > 0) listeners.forEach((listener) => listener(line));
+
+      const index = waiters.length > 0 ? waiters.findIndex((w) => w.match(line)) : -1;
+      if (index !== -1) {
+        // Consumed by waitForLine
+        waiters.splice(index, 1)[0].resolve(line);
+      } else if (router.onData) {
+        router.onData(line);
+      } else {
+        queue.push(line);
+        if (queue.length > MAX_QUEUED_LINES) queue.shift();
+      }
+    },
+
+    listen(listener) {
+      listeners.add(listener);
+      return () => listeners.delete(listener);
+    },
+
+    async readLine() {
+      if (queue.length > 0) return queue.shift() ?? null;
+      await new Promise((resolve) => setTimeout(resolve, 10));
+      return queue.shift() ?? null;
+    },
+
+    async readUntilTimeout(timeoutMs = 500) {
+      const start = Date.now();
+      const lines: string[] = [];
+      // Do not clear queue here to avoid race conditions with fast responses
+      while (Date.now() - start < timeoutMs) {
+        if (queue.length) lines.push(queue.shift()!);
+        else await new Promise((r) => setTimeout(r, 10));
+      }
+      return lines.join("\n");
+    },
+
+    // Resolves with the first line matching `match` (already queued or arriving
+    // within timeoutMs), or null on timeout. The line is not passed on elsewhere.
+    waitForLine(match, timeoutMs = 1000) {
+      const queued = queue.findIndex(match);
+      if (queued !== -1) return Promise.resolve(queue.splice(queued, 1)[0]);
+
+      return new Promise((resolve) => {
+        const waiter: LineWaiter = {
+          match,
+          resolve: (line) => {
+            clearTimeout(timer);
+            resolve(line);
+          },
+        };
+        const timer = setTimeout(() => {
+          const index = waiters.indexOf(waiter);
+          if (index !== -1) waiters.splice(index, 1);
+          resolve(null);
+        }, timeoutMs);
+        waiters.push(waiter);
+      });
+    },
+
+    clear() {
+      queue = [];
+    },
+
+    cancelWaiters() {
+      waiters.splice(0).forEach((w) => w.resolve(null));
+    },
+
+    get queued() {
+      return queue.length;
+    },
+  };
+
+  return router;
+}
+
+// Collects the lines of a multi-line response (those matching `match`). The
+// response is complete once no further line arrived for quietMs after the
+// first one; timeoutMs bounds the whole read.
+export async function collectLines(
+  waitForLine: LineRouter["waitForLine"],
+  match: (line: string) => boolean,
+  { timeoutMs, quietMs }: { timeoutMs: number; quietMs: number }
+): Promise<string[]> {
+  const deadline = Date.now() + timeoutMs;
+  const lines: string[] = [];
+  for (;;) {
+    const remaining = deadline - Date.now();
+    if (remaining <= 0) break;
+    const line = await waitForLine(match, lines.length > 0 ? Math.min(quietMs, remaining) : remaining);
+    if (line === null) break;
+    lines.push(line);
+  }
+  return lines;
+}
@@ -0,0 +1,180 @@
+// Serial link health
+// A low-rate heartbeat (a settings read whose response is dropped) measures
+// the round trip to the drum; while streaming, the received lines per second
+// show whether the stream arrives steadily. Both are kept in fixed rings, so
+// the summary always covers the last few minutes. Slow hubs show up as high
+// latency or jitter, flaky cables as unanswered heartbeats or an uneven rate.
+
+export interface LinkLimits {
+  rttMs: number;              // 95th percentile round trip
+  jitterMs: number;           // Mean change between consecutive round trips
+  lineRateVariation: number;  // Std dev / mean of the per-second line rate
+}
+
+export const DEFAULT_LINK_LIMITS: LinkLimits = { rttMs: 50, jitterMs: 20, lineRateVariation: 0.15 };
+
+export const HEARTBEAT_MS = 5000;
+export const HEARTBEAT_TIMEOUT_MS = 1000;
+// A heartbeat whose write waited longer than this behind other commands is
+// not counted: the drum may still be busy with them
+export const HEARTBEAT_MAX_WRITE_MS = 100;
+
+const RTT_WINDOW = 60;        // Heartbeats, 5 minutes
+const RATE_WINDOW = 30;       // One-second line counts
+const MIN_RTT_SAMPLES = 5;
+const MIN_RATE_SAMPLES = 5;
+const MAX_TIMEOUTS = 2;       // Unanswered heartbeats in the window
+
+// Upper bounds of the histogram bins in ms; the last bin is open
+export const RTT_BIN_EDGES_MS = [2, 5, 10, 20, 50, 100, 200, 500];
+
+export interface LinkHealth {
+  rtts: Float64Array;   // NaN for an unanswered heartbeat
+  rttHead: number;
+  rttCount: number;
+  rates: Float64Array;
+  rateHead: number;
+  rateCount: number;
+}
+
+export interface LinkHealthSummary {
+  samples: number;
+  p50Ms: number | null;
+  p95Ms: number | null;
+  jitterMs: number | null;
+  timeouts: number;
+  histogram: number[];  // Per RTT_BIN_EDGES_MS bin, plus the open one
+  lineRate: number | null;
+  lineRateVariation: number | null;
+  degraded: boolean;
+  reasons: string[];
+}
+
+export function createLinkHealth(): LinkHealth {
+  return {
+    rtts: new Float64Array(RTT_WINDOW),
+    rttHead: 0,
+    rttCount: 0,
+    rates: new Float64Array(RATE_WINDOW),
+    rateHead: 0,
+    rateCount: 0,
+  };
+}
+
+// null for a heartbeat that got no answer
+export function recordRtt(health: LinkHealth, rttMs: number | null): void {
+  health.rtts[health.rttHead] = rttMs ?? NaN;
+  health.rttHead = (health.rttHead + 1) % RTT_WINDOW;
+  health.rttCount = Math.min(health.rttCount + 1, RTT_WINDOW);
+}
+
+export function recordLineRate(health: LinkHealth, linesPerSecond: number): void {
+  health.rates[health.rateHead] = linesPerSecond;
+  health.rateHead = (health.rateHead + 1) % RATE_WINDOW;
+  health.rateCount = Math.min(health.rateCount + 1, RATE_WINDOW);
+}
+
+// Streaming stopped: the next rates are not comparable
+export function resetLineRate(health: LinkHealth): void {
+  health.rateHead = 0;
+  health.rateCount = 0;
+}
+
+// Oldest first
+function ringValues(ring: Float64Array, head: number, count: number): number[] {
+  const values: number[] = [];
+  for (let i = 0; i < count; i++) values.push(ring[(head - count + i + ring.length) % ring.length]);
+  return values;
+}
+
+function percentile(sorted: number[], p: number): number {
+  return sorted[Math.min(sorted.length - 1, Math.floor(p * sorted.length))];
+}
+
+export function summarizeLinkHealth(health: LinkHealth, limits: LinkLimits): LinkHealthSummary {
+  const rtts = ringValues(health.rtts, health.rttHead, health.rttCount);
+  const answered = rtts.filter((rtt) => !Number.isNaN(rtt));
+  const timeouts = rtts.length - answered.length;
+
+  const histogram = new Array<number>(RTT_BIN_EDGES_MS.length + 1).fill(0);
+  for (const rtt of answered) {
+    const bin = RTT_BIN_EDGES_MS.findIndex((edge) => rtt < edge);
+    histogram[bin === -1 ? RTT_BIN_EDGES_MS.length : bin]++;
+  }
+
+  const sorted = [...answered].sort((a, b) => a - b);
+  const p50Ms = sorted.length > 0 ? percentile(sorted, 0.5) : null;
+  const p95Ms = sorted.length > 0 ? percentile(sorted, 0.95) : null;
+  let jitterMs: number | null = null;
+  if (answered.length > 1) {
+    let sum = 0;
+    for (let i = 1; i < answered.length; i++) sum += Math.abs(answered[i] - answered[i - 1]);
+    jitterMs = sum / (answered.length - 1);
+  }
+
+  const rates = ringValues(health.rates, health.rateHead, health.rateCount);
+  let lineRate: number | null = null;
+  let lineRateVariation: number | null = null;
+  if (rates.length > 0) {
+    lineRate = rates.reduce((sum, rate) => sum + rate, 0) / rates.length;
+    const variance = rates.reduce((sum, rate) => sum + (rate - lineRate!) ** 2, 0) / rates.length;
+    lineRateVariation = lineRate > 0 ? Math.sqrt(variance) / lineRate : 0;
+  }
+
+  const reasons: string[] = [];
+  if (answered.length >= MIN_RTT_SAMPLES) {
+    if (p95Ms! > limits.rttMs) reasons.push(`Round trip ${Math.round(p95Ms!)} ms (p95)`);
+    if (jitterMs! > limits.jitterMs) reasons.push(`Jitter ${Math.round(jitterMs!)} ms`);
+  }
+  if (timeouts >= MAX_TIMEOUTS) reasons.push(`${timeouts} heartbeats unanswered`);
+  if (rates.length >= MIN_RATE_SAMPLES && lineRateVariation! > limits.lineRateVariation) {
+    reasons.push(`Stream rate varies ${Math.round(lineRateVariation! * 100)}%`);
+  }
+
+  return {
+    samples: rtts.length,
+    p50Ms,
+    p95Ms,
+    jitterMs,
+    timeouts,
+    histogram,
+    lineRate,
+    lineRateVariation,
+    degraded: reasons.length > 0,
+    reasons,
+  };
+}
+
+// The limits apply to every drum and are kept across visits
+
+const LIMITS_STORAGE_KEY = "itaiko-link-limits";
+
+let limits: LinkLimits = loadLinkLimits();
+const limitListeners = new Set<() => void>();
+
+function loadLinkLimits(): LinkLimits {
+  try {
+    const stored = localStorage.getItem(LIMITS_STORAGE_KEY);
+    if (stored) return { ...DEFAULT_LINK_LIMITS, ...(JSON.parse(stored) as Partial<LinkLimits>) };
+  } catch {
+    // Storage unavailable or corrupt: defaults
+  }
+  return DEFAULT_LINK_LIMITS;
+}
+
+export const getLinkLimits = (): LinkLimits => limits;
+
+export function setLinkLimits(next: LinkLimits): void {
+  limits = next;
+  try {
+    localStorage.setItem(LIMITS_STORAGE_KEY, JSON.stringify(next));
+  } catch {
+    // Kept for this page only
+  }
+  limitListeners.forEach((listener) => listener());
+}
+
+export function subscribeLinkLimits(listener: () => void): () => void {
+  limitListeners.add(listener);
+  return () => limitListeners.delete(listener);
+}
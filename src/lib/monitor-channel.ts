@@ -0,0 +1,87 @@
+import type { PadBuffer, PadBuffers, PadName, PadThresholds } from "@/types";
+import { PAD_NAMES } from "@/types";
+
+// Pop-out monitor window
+// The configurator opens /monitor?session=<id> with noopener, so the window is
+// a browsing context of its own (the browser may give it its own renderer)
+// and has no reference back. Both pages join the session at a SharedWorker
+// relay (workers/monitor-relay.worker.ts), which hands each of them one end
+// of a new MessageChannel whenever the window (re)loads. New delta samples are
+// sent in batches as a transferred Float32Array (pad-major: PAD_NAMES.length
+// runs of `count` samples), so nothing is copied on the way and the window
+// keeps its own ring buffers.
+
+export const MONITOR_PATH = "monitor";
+export const MONITOR_RELAY = "itaiko-monitor-relay";  // SharedWorker name
+export const MONITOR_PORT = "itaiko-monitor-port";    // Relay -> both pages, carries the port
+
+export const MONITOR_BATCH_MS = 16;
+
+export type MonitorRole = "feed" | "window";
+
+// Page -> relay
+export type MonitorRelayMessage =
+  | { type: "join"; session: string; role: MonitorRole }
+  | { type: "leave"; session: string };
+
+// Feed -> window
+export type MonitorMessage =
+  | { type: "reset"; capacity: number; title: string }    // New device or buffer size
+  | { type: "samples"; count: number; data: Float32Array }
+  | { type: "thresholds"; thresholds: Record<PadName, PadThresholds>; showHeavy: boolean }
+  | { type: "focus" }                                      // Pop-out pressed while open
+  | { type: "close" };                                     // Closed from the configurator
+
+// Window -> feed
+export type MonitorWindowMessage = { type: "hidden" };     // Closing or reloading
+
+// Read position of the sender in each pad's ring buffer
+export interface SampleCursor {
+  buffer: PadBuffer | null;  // Resizing replaces the buffers
+  heads: Record<PadName, number>;
+}
+
+export function createSampleCursor(): SampleCursor {
+  return { buffer: null, heads: { kaLeft: 0, donLeft: 0, donRight: 0, kaRight: 0 } };
+}
+
+// Copies the samples written since the last call, or returns null if there
+// are none. A cursor that doesn't know the buffers yet starts at their head.
+export function takeNewSamples(cursor: SampleCursor, buffers: PadBuffers): { count: number; data: Float32Array } | null {
+  const reference = buffers[PAD_NAMES[0]];
+  if (cursor.buffer !== reference) {
+    cursor.buffer = reference;
+    PAD_NAMES.forEach((pad) => (cursor.heads[pad] = buffers[pad].head));
+    return null;
+  }
+
+  const count = (reference.head - cursor.heads[PAD_NAMES[0]] + reference.capacity) % reference.capacity;
+  if (count === 0) return null;
+
+  const data = new Float32Array(count * PAD_NAMES.length);
+  PAD_NAMES.forEach((pad, p) => {
+    const { delta, capacity } = buffers[pad];
+    let read = cursor.heads[pad];
+    const offset = p * count;
+    for (let i = 0; i < count; i++) {
+      data[offset + i] = delta[read];
+      read = read + 1 === capacity ? 0 : read + 1;
+    }
+    cursor.heads[pad] = read;
+  });
+  return { count, data };
+}
+
+// Appends a batch from takeNewSamples to the receiver's buffers
+export function writeSamples(buffers: PadBuffers, count: number, data: Float32Array): void {
+  PAD_NAMES.forEach((pad, p) => {
+    const buffer = buffers[pad];
+    const offset = p * count;
+    // Older samples than the buffer holds would be overwritten anyway
+    const start = Math.max(0, count - buffer.capacity);
+    for (let i = start; i < count; i++) {
+      buffer.delta[buffer.head] = data[offset + i];
+      buffer.head = (buffer.head + 1) % buffer.capacity;
+    }
+  });
+}
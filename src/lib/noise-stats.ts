@@ -0,0 +1,190 @@
+import type { PadName, PadBuffers } from "@/types";
+import { PAD_NAMES } from "@/types";
+import { THRESHOLD_MAX } from "@/lib/default-config";
+
+// Per-pad noise floor
+// Fed by the stream ingest with every raw sample while the drum is idle:
+// running mean/variance of delta (Welford), a histogram with one bin per ADC
+// count for exact p99/p999, and the peak. O(1) per sample, fixed memory.
+//
+// Activity is judged against the pads' own signal, not the configured
+// thresholds (a light threshold set too low is what this is meant to find):
+// a delta more than ONSET_SIGMAS standard deviations (and at least
+// ONSET_MIN_MARGIN counts) above the pad's running mean is an onset. A
+// trigger in the input stream counts as one too. An onset on any pad leaves
+// that sample and the next HIT_HOLDOFF_SAMPLES out on every pad, since a hit
+// rings into its neighbours. Gaussian noise essentially never reaches six
+// sigma, so the gate cuts hits, not the tail the p999 is taken from.
+//
+// The gate keeps its own exponentially weighted mean/variance, updated with
+// every sample clipped to the gate: it settles from nothing within a few
+// seconds (recording starts once it stops firing) and a hit barely moves it.
+
+export const NOISE_HISTOGRAM_BINS = THRESHOLD_MAX + 1;
+const HIT_HOLDOFF_SAMPLES = 100;  // About 1 s at the ~100 Hz stream rate
+const ONSET_SIGMAS = 6;
+const ONSET_MIN_MARGIN = 20;       // Counts; also the gate before it has settled
+const GATE_WEIGHT = 1 / 256;       // Of each sample in the gate's running stats
+
+// Enough idle samples for a p999 to mean something (about 50 s of stream)
+export const MIN_NOISE_SAMPLES = 5000;
+
+// Suggested light threshold: p999 plus 25%, and at least this many counts above it
+const SUGGEST_MARGIN_FACTOR = 1.25;
+const SUGGEST_MARGIN_MIN = 10;
+
+interface PadNoise {
+  count: number;
+  mean: number;
+  m2: number;
+  peak: number;
+  histogram: Uint32Array;
+  gateMean: number;
+  gateVariance: number;
+}
+
+export interface NoiseStats {
+  pads: Record<PadName, PadNoise>;
+  holdoff: number;  // Samples still left out after the last onset
+}
+
+export interface PadNoiseSummary {
+  samples: number;
+  mean: number;
+  stdDev: number;
+  p99: number;
+  p999: number;
+  peak: number;
+  suggestedLight: number | null;  // null until MIN_NOISE_SAMPLES
+}
+
+const createPadNoise = (): PadNoise => ({
+  count: 0,
+  mean: 0,
+  m2: 0,
+  peak: 0,
+  histogram: new Uint32Array(NOISE_HISTOGRAM_BINS),
+  gateMean: 0,
+  gateVariance: 0,
+});
+
+export function createNoiseStats(): NoiseStats {
+  return {
+    pads: {
+      kaLeft: createPadNoise(),
+      donLeft: createPadNoise(),
+      donRight: createPadNoise(),
+      kaRight: createPadNoise(),
+    },
+    holdoff: 0,
+  };
+}
+
+export function resetNoiseStats(stats: NoiseStats): void {
+  PAD_NAMES.forEach((pad) => {
+    const noise = stats.pads[pad];
+    noise.count = 0;
+    noise.mean = 0;
+    noise.m2 = 0;
+    noise.peak = 0;
+    noise.histogram.fill(0);
+    // The gate keeps its level, so collecting starts again at once
+  });
+  stats.holdoff = 0;
+}
+
+// The input stream reported a trigger. Its line follows the raw line of the
+// same sample, so the hold starts with the next one.
+export function holdOffNoise(stats: NoiseStats): void {
+  stats.holdoff = HIT_HOLDOFF_SAMPLES;
+}
+
+const latestDelta = (buffers: PadBuffers, pad: PadName): number => {
+  const buffer = buffers[pad];
+  return buffer.delta[(buffer.head - 1 + buffer.capacity) % buffer.capacity];
+};
+
+// The sample just written to `buffers` (one per pad, before head)
+export function recordNoiseSample(stats: NoiseStats, buffers: PadBuffers): void {
+  const kaLeft = latestDelta(buffers, "kaLeft");
+  const donLeft = latestDelta(buffers, "donLeft");
+  const donRight = latestDelta(buffers, "donRight");
+  const kaRight = latestDelta(buffers, "kaRight");
+  const { pads } = stats;
+
+  // No short-circuit: every pad's gate sees every sample
+  const onsets =
+    Number(gateSample(pads.kaLeft, kaLeft)) +
+    Number(gateSample(pads.donLeft, donLeft)) +
+    Number(gateSample(pads.donRight, donRight)) +
+    Number(gateSample(pads.kaRight, kaRight));
+  if (onsets > 0) {
+    stats.holdoff = HIT_HOLDOFF_SAMPLES;
+    return;
+  }
+  if (stats.holdoff > 0) {
+    stats.holdoff--;
+    return;
+  }
+  addSample(pads.kaLeft, kaLeft);
+  addSample(pads.donLeft, donLeft);
+  addSample(pads.donRight, donRight);
+  addSample(pads.kaRight, kaRight);
+}
+
+// True for an onset: more than max(ONSET_SIGMAS * stdDev, ONSET_MIN_MARGIN)
+// above the gate's mean
+function gateSample(noise: PadNoise, value: number): boolean {
+  const limit = noise.gateMean + Math.max(ONSET_SIGMAS * Math.sqrt(noise.gateVariance), ONSET_MIN_MARGIN);
+  const clipped = Math.min(value, limit);
+  const diff = clipped - noise.gateMean;
+  noise.gateMean += GATE_WEIGHT * diff;
+  noise.gateVariance = (1 - GATE_WEIGHT) * (noise.gateVariance + GATE_WEIGHT * diff * diff);
+  return value > limit;
+}
+
+function addSample(noise: PadNoise, value: number): void {
+  noise.count++;
+  const diff = value - noise.mean;
+  noise.mean += diff / noise.count;
+  noise.m2 += diff * (value - noise.mean);
+  if (value > noise.peak) noise.peak = value;
+  noise.histogram[Math.min(NOISE_HISTOGRAM_BINS - 1, Math.max(0, Math.floor(value)))]++;
+}
+
+// Smallest value with at least q of the samples at or below it
+function histogramQuantile(histogram: Uint32Array, count: number, q: number): number {
+  const target = Math.ceil(q * count);
+  let seen = 0;
+  for (let bin = 0; bin < histogram.length; bin++) {
+    seen += histogram[bin];
+    if (seen >= target) return bin;
+  }
+  return histogram.length - 1;
+}
+
+export function suggestLightThreshold(p999: number): number {
+  const suggested = Math.max(Math.ceil(p999 * SUGGEST_MARGIN_FACTOR), p999 + SUGGEST_MARGIN_MIN);
+  return Math.min(THRESHOLD_MAX, suggested);
+}
+
+export function summarizeNoise(stats: NoiseStats): Record<PadName, PadNoiseSummary> {
+  const summarize = (noise: PadNoise): PadNoiseSummary => {
+    const p999 = noise.count > 0 ? histogramQuantile(noise.histogram, noise.count, 0.999) : 0;
+    return {
+      samples: noise.count,
+      mean: noise.mean,
+      stdDev: noise.count > 1 ? Math.sqrt(noise.m2 / (noise.count - 1)) : 0,
+      p99: noise.count > 0 ? histogramQuantile(noise.histogram, noise.count, 0.99) : 0,
+      p999,
+      peak: noise.peak,
+      suggestedLight: noise.count >= MIN_NOISE_SAMPLES ? suggestLightThreshold(p999) : null,
+    };
+  };
+  return {
+    kaLeft: summarize(stats.pads.kaLeft),
+    donLeft: summarize(stats.pads.donLeft),
+    donRight: summarize(stats.pads.donRight),
+    kaRight: summarize(stats.pads.kaRight),
+  };
+}
@@ -0,0 +1,93 @@
+import type { PadBuffer, PadBuffers } from "@/types";
+
+// Zero-allocation circular buffers backing the live graphs
+
+export function createPadBuffer(capacity: number): PadBuffer {
+  return {
+    raw: new Float32Array(capacity),
+    delta: new Float32Array(capacity),
+    head: 0,
+    count: capacity,
+    capacity,
+  };
+}
+
+export function createPadBuffers(capacity: number): PadBuffers {
+  return {
+    kaLeft: createPadBuffer(capacity),
+    donLeft: createPadBuffer(capacity),
+    donRight: createPadBuffer(capacity),
+    kaRight: createPadBuffer(capacity),
+  };
+}
+
+export function resizePadBuffer(buffer: PadBuffer, newCapacity: number): PadBuffer {
+  const newBuffer = createPadBuffer(newCapacity);
+  const copyCount = Math.min(buffer.capacity, newCapacity);
+  const startRead = buffer.head;
+
+  for (let i = 0; i < copyCount; i++) {
+    const readIdx = (startRead + buffer.capacity - copyCount + i) % buffer.capacity;
+    newBuffer.raw[i] = buffer.raw[readIdx];
+    newBuffer.delta[i] = buffer.delta[readIdx];
+  }
+
+  newBuffer.head = copyCount % newCapacity;
+  newBuffer.count = newCapacity;
+  return newBuffer;
+}
+
+// Helper to read from circular buffer at logical index
+export function readFromCircularBuffer(
+  buffer: Float32Array,
+  head: number,
+  count: number,
+  capacity: number,
+  logicalIndex: number
+): number {
+  if (logicalIndex < 0 || logicalIndex >= count) return 0;
+  // Convert logical index (0 = oldest) to physical index
+  const startIdx = (head - count + capacity) % capacity;
+  const physicalIdx = (startIdx + logicalIndex) % capacity;
+  return buffer[physicalIdx];
+}
+
+// Downsample the logical range [start, end) of a circular buffer into out.length
+// points, keeping the MAX of every bucket so short peaks stay visible.
+// A bucket holding a gap sample (NaN, see markStreamGap) comes out as NaN.
+// Zero allocation: writes into the caller's array.
+export function downsamplePeak(
+  data: Float32Array,
+  head: number,
+  count: number,
+  capacity: number,
+  start: number,
+  end: number,
+  out: Float32Array
+): void {
+  const points = out.length;
+  const step = (end - start) / points;
+
+  for (let i = 0; i < points; i++) {
+    // Calculate the range of data indices this pixel covers
+    const iStart = Math.floor(start + i * step);
+    const iEnd = Math.floor(start + (i + 1) * step);
+
+    // If the window falls within a single integer index (oversampling/zoomed in)
+    if (iStart === iEnd) {
+      out[i] = readFromCircularBuffer(data, head, count, capacity, iStart);
+      continue;
+    }
+
+    // Downsample by MAX (peak detection) across the range
+    let maxV = 0;
+    let gap = false;
+    const loopEnd = Math.min(iEnd, end);
+    for (let j = iStart; j < loopEnd; j++) {
+      const v = readFromCircularBuffer(data, head, count, capacity, j);
+      if (v > maxV) maxV = v;
+      else if (v !== v) gap = true;  // NaN
+    }
+    out[i] = gap ? NaN : maxV;
+  }
+}
@@ -0,0 +1,233 @@
+import type { PadName } from "@/types";
+import { PAD_NAMES } from "@/types";
+
+// Live monitor performance metrics
+// Hot paths add into plain counters (guarded by perfEnabled, so they cost a
+// single branch while the HUD is closed). Once per second the counters are
+// folded into a fixed-size ring of samples; nothing allocates per line or frame.
+
+export interface PerfSample {
+  time: number;           // End of the interval (ms since page load)
+  linesPerSec: number;
+  bytesPerSec: number;
+  batches: number;        // Chunks handed over by the serial reader
+  parseMsAvg: number;     // Line splitting + stream ingest per chunk
+  parseMsMax: number;
+  queueDepth: number;     // Max unconsumed lines in the serial line queue
+  fps: number;
+  droppedFrames: number;  // Animation frames missed against the display refresh
+  renderMs: Record<PadName, number>;  // Average CPU time per frame to build and submit a graph
+  longTasks: number;
+  longTaskMs: number;
+  heapMB: number | null;  // Chromium only
+}
+
+export interface PerfReport {
+  createdAt: string;
+  userAgent: string;
+  sampleIntervalMs: number;
+  context: Record<string, unknown>;
+  samples: PerfSample[];
+}
+
+export const PERF_SAMPLE_INTERVAL_MS = 1000;
+export const PERF_SAMPLE_CAPACITY = 300;  // 5 minutes
+
+// Sample layout in the ring
+const F_TIME = 0;
+const F_LINES = 1;
+const F_BYTES = 2;
+const F_BATCHES = 3;
+const F_PARSE_AVG = 4;
+const F_PARSE_MAX = 5;
+const F_QUEUE = 6;
+const F_FPS = 7;
+const F_DROPPED = 8;
+const F_LONG_TASKS = 9;
+const F_LONG_TASK_MS = 10;
+const F_HEAP = 11;
+const F_RENDER = 12;  // One field per pad
+const FIELD_COUNT = F_RENDER + PAD_NAMES.length;
+
+const ring = new Float64Array(PERF_SAMPLE_CAPACITY * FIELD_COUNT);
+let ringHead = 0;
+let ringCount = 0;
+
+// Current interval
+let lines = 0;
+let bytes = 0;
+let batches = 0;
+let parseMs = 0;
+let parseMaxMs = 0;
+let queueDepth = 0;
+let frames = 0;
+let droppedFrames = 0;
+let longTasks = 0;
+let longTaskMs = 0;
+const renderMs = new Float64Array(PAD_NAMES.length);
+const renderFrames = new Uint32Array(PAD_NAMES.length);
+
+export let perfEnabled = false;
+
+let sampleTimer: ReturnType<typeof setInterval> | null = null;
+let frameId = 0;
+let lastFrameTime = 0;
+let frameIntervalMs = 1000 / 60;
+let longTaskObserver: PerformanceObserver | null = null;
+const listeners = new Set<() => void>();
+
+// Called by the serial reader once per received chunk
+export function recordIngest(lineCount: number, byteCount: number, elapsedMs: number, queued: number): void {
+  lines += lineCount;
+  bytes += byteCount;
+  batches++;
+  parseMs += elapsedMs;
+  if (elapsedMs > parseMaxMs) parseMaxMs = elapsedMs;
+  if (queued > queueDepth) queueDepth = queued;
+}
+
+// Called by each graph after submitting a frame (padIndex = PAD_NAMES index)
+export function recordRender(padIndex: number, elapsedMs: number): void {
+  renderMs[padIndex] += elapsedMs;
+  renderFrames[padIndex]++;
+}
+
+function trackFrame(now: number): void {
+  if (lastFrameTime > 0) {
+    const interval = now - lastFrameTime;
+    // Track the display refresh from fast frames so 120/144 Hz screens aren't misjudged
+    if (interval < frameIntervalMs * 1.5) frameIntervalMs += (interval - frameIntervalMs) * 0.05;
+    const missed = Math.round(interval / frameIntervalMs) - 1;
+    if (missed > 0) droppedFrames += missed;
+  }
+  lastFrameTime = now;
+  frames++;
+  frameId = requestAnimationFrame(trackFrame);
+}
+
+function heapUsedMB(): number {
+  const memory = (performance as Performance & { memory?: { usedJSHeapSize: number } }).memory;
+  return memory ? memory.usedJSHeapSize / (1024 * 1024) : NaN;
+}
+
+function takeSample(): void {
+  const o = ringHead * FIELD_COUNT;
+  const seconds = PERF_SAMPLE_INTERVAL_MS / 1000;
+
+  ring[o + F_TIME] = performance.now();
+  ring[o + F_LINES] = lines / seconds;
+  ring[o + F_BYTES] = bytes / seconds;
+  ring[o + F_BATCHES] = batches;
+  ring[o + F_PARSE_AVG] = batches > 0 ? parseMs / batches : 0;
+  ring[o + F_PARSE_MAX] = parseMaxMs;
+  ring[o + F_QUEUE] = queueDepth;
+  ring[o + F_FPS] = frames / seconds;
+  ring[o + F_DROPPED] = droppedFrames;
+  ring[o + F_LONG_TASKS] = longTasks;
+  ring[o + F_LONG_TASK_MS] = longTaskMs;
+  ring[o + F_HEAP] = heapUsedMB();
+  for (let i = 0; i < PAD_NAMES.length; i++) {
+    ring[o + F_RENDER + i] = renderFrames[i] > 0 ? renderMs[i] / renderFrames[i] : 0;
+  }
+
+  ringHead = (ringHead + 1) % PERF_SAMPLE_CAPACITY;
+  ringCount = Math.min(ringCount + 1, PERF_SAMPLE_CAPACITY);
+
+  lines = bytes = batches = 0;
+  parseMs = parseMaxMs = queueDepth = 0;
+  frames = droppedFrames = longTasks = longTaskMs = 0;
+  renderMs.fill(0);
+  renderFrames.fill(0);
+
+  listeners.forEach((listener) => listener());
+}
+
+export function startPerfSampling(): void {
+  if (perfEnabled) return;
+  perfEnabled = true;
+  lastFrameTime = 0;
+  frameId = requestAnimationFrame(trackFrame);
+  sampleTimer = setInterval(takeSample, PERF_SAMPLE_INTERVAL_MS);
+
+  if (typeof PerformanceObserver !== "undefined" && PerformanceObserver.supportedEntryTypes?.includes("longtask")) {
+    longTaskObserver = new PerformanceObserver((list) => {
+      for (const entry of list.getEntries()) {
+        longTasks++;
+        longTaskMs += entry.duration;
+      }
+    });
+    longTaskObserver.observe({ type: "longtask" });
+  }
+}
+
+// Samples are kept so they can still be exported after the HUD is closed
+export function stopPerfSampling(): void {
+  if (!perfEnabled) return;
+  perfEnabled = false;
+  cancelAnimationFrame(frameId);
+  if (sampleTimer) clearInterval(sampleTimer);
+  sampleTimer = null;
+  longTaskObserver?.disconnect();
+  longTaskObserver = null;
+}
+
+export function clearPerfSamples(): void {
+  ringHead = 0;
+  ringCount = 0;
+  listeners.forEach((listener) => listener());
+}
+
+export function subscribePerfSamples(listener: () => void): () => void {
+  listeners.add(listener);
+  return () => listeners.delete(listener);
+}
+
+function readSample(index: number): PerfSample {
+  const o = index * FIELD_COUNT;
+  const render = {} as Record<PadName, number>;
+  PAD_NAMES.forEach((pad, i) => {
+    render[pad] = ring[o + F_RENDER + i];
+  });
+  const heap = ring[o + F_HEAP];
+
+  return {
+    time: ring[o + F_TIME],
+    linesPerSec: ring[o + F_LINES],
+    bytesPerSec: ring[o + F_BYTES],
+    batches: ring[o + F_BATCHES],
+    parseMsAvg: ring[o + F_PARSE_AVG],
+    parseMsMax: ring[o + F_PARSE_MAX],
+    queueDepth: ring[o + F_QUEUE],
+    fps: ring[o + F_FPS],
+    droppedFrames: ring[o + F_DROPPED],
+    renderMs: render,
+    longTasks: ring[o + F_LONG_TASKS],
+    longTaskMs: ring[o + F_LONG_TASK_MS],
+    heapMB: Number.isNaN(heap) ? null : heap,
+  };
+}
+
+// Oldest first
+export function getPerfSamples(): PerfSample[] {
+  const samples: PerfSample[] = [];
+  const start = (ringHead - ringCount + PERF_SAMPLE_CAPACITY) % PERF_SAMPLE_CAPACITY;
+  for (let i = 0; i < ringCount; i++) {
+    samples.push(readSample((start + i) % PERF_SAMPLE_CAPACITY));
+  }
+  return samples;
+}
+
+export function getLatestPerfSample(): PerfSample | null {
+  if (ringCount === 0) return null;
+  return readSample((ringHead - 1 + PERF_SAMPLE_CAPACITY) % PERF_SAMPLE_CAPACITY);
+}
+
+export function createPerfReport(context: Record<string, unknown> = {}): PerfReport {
+  return {
+    createdAt: new Date().toISOString(),
+    userAgent: navigator.userAgent,
+    sampleIntervalMs: PERF_SAMPLE_INTERVAL_MS,
+    context,
+    samples: getPerfSamples(),
+  };
+}
@@ -0,0 +1,133 @@
+import type { PadName } from "@/types";
+import { PAD_NAMES } from "@/types";
+
+// Same-pad retriggers
+// Every rising crossing of a pad's light threshold is either a new hit or the
+// hit's own decay ringing back over the threshold. The decay is followed with
+// a peak-hold envelope of the delta that falls off over RELEASE_MS: a crossing
+// that clearly tops the envelope is a new hit, one that stays under it within
+// the window of the last hit is a retrigger. The first ring cycles can rise
+// faster than the attack, so crossings closer than MIN_HIT_GAP_MS to the hit
+// are always retriggers; nobody plays one pad that fast.
+// The individual debounce counts from the triggering crossing, so the time
+// from there to the latest retrigger is the debounce that removes them all.
+// With the input stream in the session, retriggers the firmware actually
+// turned into key presses are counted as ghost notes.
+
+export const DEFAULT_RETRIGGER_WINDOW_MS = 100;
+export const RETRIGGER_BIN_MS = 5;
+const RELEASE_MS = 20;
+const MIN_HIT_GAP_MS = 10;
+const NEW_HIT_FACTOR = 2;
+
+export interface RetriggerInput {
+  frames: Uint16Array;             // Raw ADC, kaLeft, donLeft, donRight, kaRight per sample
+  inputMasks: Uint8Array | null;   // Input stream mask per sample, when recorded
+  sampleIntervalMs: number;
+  light: Record<PadName, number>;
+  windowMs: number;
+}
+
+export interface PadRetriggers {
+  hits: number;
+  retriggers: number;
+  histogram: number[];             // Retrigger intervals, RETRIGGER_BIN_MS bins up to the window
+  maxIntervalMs: number | null;
+  debounceMs: number | null;       // Removes every retrigger on this pad
+  fastestHitMs: number | null;     // Shortest gap between two distinct hits
+  ghostNotes: number | null;       // Retriggers sent as key presses; null without input stream
+}
+
+export interface RetriggerResult {
+  samples: number;
+  sampleIntervalMs: number;
+  windowMs: number;
+  pads: Record<PadName, PadRetriggers>;
+  // The individual debounce applies to all pads; 0 when nothing retriggered
+  recommendedDebounceMs: number;
+  lostHits: number;                // Distinct hits closer together than that
+  elapsedMs: number;
+}
+
+export function analyzeRetriggers({ frames, inputMasks, sampleIntervalMs, light, windowMs }: RetriggerInput): RetriggerResult {
+  const started = performance.now();
+  const samples = Math.floor(frames.length / 4);
+  const release = Math.exp(-sampleIntervalMs / RELEASE_MS);
+  const bins = Math.ceil(windowMs / RETRIGGER_BIN_MS);
+  const hitGaps: number[] = [];
+
+  const scanPad = (p: number): PadRetriggers => {
+    const threshold = light[PAD_NAMES[p]];
+    const bit = 1 << p;
+    const histogram = new Array<number>(bins).fill(0);
+    let hits = 0;
+    let retriggers = 0;
+    let ghostNotes = 0;
+    let maxInterval = -1;
+    let fastestHit = Infinity;
+    let lastHit = -Infinity;
+    let envelope = 0;
+    let above = false;
+
+    for (let t = 1; t < samples; t++) {
+      const rise = frames[t * 4 + p] - frames[(t - 1) * 4 + p];
+      const d = rise > 0 ? rise : 0;
+      const crossing = d >= threshold && !above;
+      above = d >= threshold;
+
+      if (crossing) {
+        const interval = (t - lastHit) * sampleIntervalMs;
+        const newHit = interval >= MIN_HIT_GAP_MS && (d > envelope * NEW_HIT_FACTOR || interval > windowMs);
+        if (newHit) {
+          hits++;
+          if (interval < fastestHit) fastestHit = interval;
+          if (interval <= windowMs) hitGaps.push(interval);
+          lastHit = t;
+        } else {
+          retriggers++;
+          histogram[Math.min(bins - 1, Math.floor(interval / RETRIGGER_BIN_MS))]++;
+          if (interval > maxInterval) maxInterval = interval;
+          // A key press starting here or on the next sample
+          if (inputMasks) {
+            for (let i = t; i <= t + 1 && i < samples; i++) {
+              if ((inputMasks[i] & bit) && !(inputMasks[i - 1] & bit)) {
+                ghostNotes++;
+                break;
+              }
+            }
+          }
+        }
+      }
+
+      envelope = d > envelope * release ? d : envelope * release;
+    }
+
+    return {
+      hits,
+      retriggers,
+      histogram,
+      maxIntervalMs: maxInterval < 0 ? null : maxInterval,
+      // The firmware locks out while less than the debounce has passed
+      debounceMs: maxInterval < 0 ? null : Math.ceil(maxInterval + sampleIntervalMs),
+      fastestHitMs: Number.isFinite(fastestHit) ? fastestHit : null,
+      ghostNotes: inputMasks ? ghostNotes : null,
+    };
+  };
+
+  const pads = {} as Record<PadName, PadRetriggers>;
+  PAD_NAMES.forEach((pad, p) => {
+    pads[pad] = scanPad(p);
+  });
+
+  const recommendedDebounceMs = Math.max(0, ...PAD_NAMES.map((pad) => pads[pad].debounceMs ?? 0));
+
+  return {
+    samples,
+    sampleIntervalMs,
+    windowMs,
+    pads,
+    recommendedDebounceMs,
+    lostHits: hitGaps.filter((gap) => gap < recommendedDebounceMs).length,
+    elapsedMs: performance.now() - started,
+  };
+}
@@ -21,6 +21,13 @@ export function parseRawStreamLine(line: string): Record<PadName, number> | null
   return { kaLeft, donLeft, donRight, kaRight };
 }
 
+// Encode raw ADC values into a stream line (inverse of parseRawStreamLine)
+// Values are clamped to 16 bits, output is uppercase like the firmware
+export function encodeRawStreamLine(values: Record<PadName, number>): string {
+  const hex = (v: number) => (Math.max(0, Math.min(0xffff, Math.round(v))) | 0x10000).toString(16).slice(1);
+  return (hex(values.kaLeft) + hex(values.donLeft) + hex(values.donRight) + hex(values.kaRight)).toUpperCase();
+}
+
 // Parse input stream line (1 char hex)
 // Format: X (bitmask)
 export function parseInputStreamLine(line: string): Record<PadName, boolean> | null {
@@ -38,6 +45,9 @@ export function parseInputStreamLine(line: string): Record<PadName, boolean> | n
   };
 }
 
+// A line of the settings response (command 1000)
+export const isSettingsLine = (line: string): boolean => /^\d+:\d+/.test(line) || line.startsWith("Version:");
+
 // Parse settings response from device
 // Format: key:value lines (0:800, 1:800, etc.)
 // Also extracts version if present (Version:x.x.x)
@@ -141,85 +151,91 @@ export function settingsToConfig(
   return config;
 }
 
-// Convert DeviceConfig to settings string for writing
-// Format: 0:800 1:800 2:800 ... (space-separated key:value pairs)
-export function configToSettingsString(config: DeviceConfig): string {
-  const pairs: string[] = [];
+// Convert DeviceConfig to the settings map the firmware stores
+export function configToSettings(config: DeviceConfig): Map<number, number> {
+  const settings = new Map<number, number>();
 
   // Light thresholds (0-3)
   PAD_NAMES.forEach((pad) => {
     const index = SETTING_INDICES.lightThreshold[pad];
-    pairs.push(`${index}:${config.pads[pad].light}`);
+    settings.set(index, config.pads[pad].light);
   });
 
   // Timing (4-8)
-  pairs.push(`${SETTING_INDICES.donDebounce}:${config.timing.donDebounce}`);
-  pairs.push(`${SETTING_INDICES.kaDebounce}:${config.timing.kaDebounce}`);
-  pairs.push(`${SETTING_INDICES.crosstalkDebounce}:${config.timing.crosstalkDebounce}`);
-  pairs.push(`${SETTING_INDICES.individualDebounce}:${config.timing.individualDebounce}`);
-  pairs.push(`${SETTING_INDICES.keyHoldTime}:${config.timing.keyHoldTime}`);
+  settings.set(SETTING_INDICES.donDebounce, config.timing.donDebounce);
+  settings.set(SETTING_INDICES.kaDebounce, config.timing.kaDebounce);
+  settings.set(SETTING_INDICES.crosstalkDebounce, config.timing.crosstalkDebounce);
+  settings.set(SETTING_INDICES.individualDebounce, config.timing.individualDebounce);
+  settings.set(SETTING_INDICES.keyHoldTime, config.timing.keyHoldTime);
 
   // Double mode (9)
-  pairs.push(`${SETTING_INDICES.doubleInputMode}:${config.doubleInputMode ? 1 : 0}`);
+  settings.set(SETTING_INDICES.doubleInputMode, config.doubleInputMode ? 1 : 0);
 
   // Heavy thresholds (10-13)
   PAD_NAMES.forEach((pad) => {
     const index = SETTING_INDICES.heavyThreshold[pad];
-    pairs.push(`${index}:${config.pads[pad].heavy}`);
+    settings.set(index, config.pads[pad].heavy);
   });
 
   // Cutoff thresholds (14-17)
   PAD_NAMES.forEach((pad) => {
     const index = SETTING_INDICES.cutoffThreshold[pad];
-    pairs.push(`${index}:${config.pads[pad].cutoff}`);
+    settings.set(index, config.pads[pad].cutoff);
   });
 
   // Key mappings (18-41) - only if present
   if (config.keyMappings) {
     const km = config.keyMappings;
-    pairs.push(`${SETTING_INDICES.keyMapping.drumP1.kaLeft}:${km.drumP1.kaLeft}`);
-    pairs.push(`${SETTING_INDICES.keyMapping.drumP1.donLeft}:${km.drumP1.donLeft}`);
-    pairs.push(`${SETTING_INDICES.keyMapping.drumP1.donRight}:${km.drumP1.donRight}`);
-    pairs.push(`${SETTING_INDICES.keyMapping.drumP1.kaRight}:${km.drumP1.kaRight}`);
-    pairs.push(`${SETTING_INDICES.keyMapping.drumP2.kaLeft}:${km.drumP2.kaLeft}`);
-    pairs.push(`${SETTING_INDICES.keyMapping.drumP2.donLeft}:${km.drumP2.donLeft}`);
-    pairs.push(`${SETTING_INDICES.keyMapping.drumP2.donRight}:${km.drumP2.donRight}`);
-    pairs.push(`${SETTING_INDICES.keyMapping.drumP2.kaRight}:${km.drumP2.kaRight}`);
-    pairs.push(`${SETTING_INDICES.keyMapping.controller.up}:${km.controller.up}`);
-    pairs.push(`${SETTING_INDICES.keyMapping.controller.down}:${km.controller.down}`);
-    pairs.push(`${SETTING_INDICES.keyMapping.controller.left}:${km.controller.left}`);
-    pairs.push(`${SETTING_INDICES.keyMapping.controller.right}:${km.controller.right}`);
-    pairs.push(`${SETTING_INDICES.keyMapping.controller.north}:${km.controller.north}`);
-    pairs.push(`${SETTING_INDICES.keyMapping.controller.east}:${km.controller.east}`);
-    pairs.push(`${SETTING_INDICES.keyMapping.controller.south}:${km.controller.south}`);
-    pairs.push(`${SETTING_INDICES.keyMapping.controller.west}:${km.controller.west}`);
-    pairs.push(`${SETTING_INDICES.keyMapping.controller.l}:${km.controller.l}`);
-    pairs.push(`${SETTING_INDICES.keyMapping.controller.r}:${km.controller.r}`);
-    pairs.push(`${SETTING_INDICES.keyMapping.controller.start}:${km.controller.start}`);
-    pairs.push(`${SETTING_INDICES.keyMapping.controller.select}:${km.controller.select}`);
-    pairs.push(`${SETTING_INDICES.keyMapping.controller.home}:${km.controller.home}`);
-    pairs.push(`${SETTING_INDICES.keyMapping.controller.share}:${km.controller.share}`);
-    pairs.push(`${SETTING_INDICES.keyMapping.controller.l3}:${km.controller.l3}`);
-    pairs.push(`${SETTING_INDICES.keyMapping.controller.r3}:${km.controller.r3}`);
+    settings.set(SETTING_INDICES.keyMapping.drumP1.kaLeft, km.drumP1.kaLeft);
+    settings.set(SETTING_INDICES.keyMapping.drumP1.donLeft, km.drumP1.donLeft);
+    settings.set(SETTING_INDICES.keyMapping.drumP1.donRight, km.drumP1.donRight);
+    settings.set(SETTING_INDICES.keyMapping.drumP1.kaRight, km.drumP1.kaRight);
+    settings.set(SETTING_INDICES.keyMapping.drumP2.kaLeft, km.drumP2.kaLeft);
+    settings.set(SETTING_INDICES.keyMapping.drumP2.donLeft, km.drumP2.donLeft);
+    settings.set(SETTING_INDICES.keyMapping.drumP2.donRight, km.drumP2.donRight);
+    settings.set(SETTING_INDICES.keyMapping.drumP2.kaRight, km.drumP2.kaRight);
+    settings.set(SETTING_INDICES.keyMapping.controller.up, km.controller.up);
+    settings.set(SETTING_INDICES.keyMapping.controller.down, km.controller.down);
+    settings.set(SETTING_INDICES.keyMapping.controller.left, km.controller.left);
+    settings.set(SETTING_INDICES.keyMapping.controller.right, km.controller.right);
+    settings.set(SETTING_INDICES.keyMapping.controller.north, km.controller.north);
+    settings.set(SETTING_INDICES.keyMapping.controller.east, km.controller.east);
+    settings.set(SETTING_INDICES.keyMapping.controller.south, km.controller.south);
+    settings.set(SETTING_INDICES.keyMapping.controller.west, km.controller.west);
+    settings.set(SETTING_INDICES.keyMapping.controller.l, km.controller.l);
+    settings.set(SETTING_INDICES.keyMapping.controller.r, km.controller.r);
+    settings.set(SETTING_INDICES.keyMapping.controller.start, km.controller.start);
+    settings.set(SETTING_INDICES.keyMapping.controller.select, km.controller.select);
+    settings.set(SETTING_INDICES.keyMapping.controller.home, km.controller.home);
+    settings.set(SETTING_INDICES.keyMapping.controller.share, km.controller.share);
+    settings.set(SETTING_INDICES.keyMapping.controller.l3, km.controller.l3);
+    settings.set(SETTING_INDICES.keyMapping.controller.r3, km.controller.r3);
   }
 
   // ADC channels (42-45) - only if present
   if (config.adcChannels) {
     const adc = config.adcChannels;
-    pairs.push(`${SETTING_INDICES.adcChannel.donLeft}:${adc.donLeft}`);
-    pairs.push(`${SETTING_INDICES.adcChannel.kaLeft}:${adc.kaLeft}`);
-    pairs.push(`${SETTING_INDICES.adcChannel.donRight}:${adc.donRight}`);
-    pairs.push(`${SETTING_INDICES.adcChannel.kaRight}:${adc.kaRight}`);
+    settings.set(SETTING_INDICES.adcChannel.donLeft, adc.donLeft);
+    settings.set(SETTING_INDICES.adcChannel.kaLeft, adc.kaLeft);
+    settings.set(SETTING_INDICES.adcChannel.donRight, adc.donRight);
+    settings.set(SETTING_INDICES.adcChannel.kaRight, adc.kaRight);
   }
 
-  // Sort by index
-  pairs.sort((a, b) => {
-    const indexA = parseInt(a.split(":")[0], 10);
-    const indexB = parseInt(b.split(":")[0], 10);
-    return indexA - indexB;
-  });
+  return settings;
+}
 
-  return pairs.join(" ");
+// Settings string for write mode (1002)
+// Format: 0:800 1:800 2:800 ... (space-separated key:value pairs, by key)
+export function formatSettings(settings: Map<number, number>): string {
+  return [...settings]
+    .sort(([a], [b]) => a - b)
+    .map(([key, value]) => `${key}:${value}`)
+    .join(" ");
+}
+
+// Convert DeviceConfig to settings string for writing
+export function configToSettingsString(config: DeviceConfig): string {
+  return formatSettings(configToSettings(config));
 }
 
 // Build command string
@@ -239,3 +255,16 @@ export function encodeCommand(command: string): Uint8Array {
 export function decodeResponse(data: Uint8Array): string {
   return new TextDecoder().decode(data);
 }
+
+// File size from a BMP header (bytes 2-5, little endian), null if not a BMP
+export function getBmpFileSize(data: Uint8Array): number | null {
+  if (data.length < 6 || data[0] !== 0x42 || data[1] !== 0x4d) return null; // "BM"
+  return (data[2] | (data[3] << 8) | (data[4] << 16) | (data[5] << 24)) >>> 0;
+}
+
+// Parse bitmap upload confirmation
+// Format: BITMAP_SAVED:<bytes>
+export function parseBitmapSaved(line: string): number | null {
+  const match = line.match(/^BITMAP_SAVED:(\d+)/);
+  return match ? parseInt(match[1], 10) : null;
+}
@@ -0,0 +1,91 @@
+import type { ConnectionStatus, DeviceCommand } from "@/types";
+
+// Sharing the drums between browser tabs
+// A port can only be opened once, so one tab (the leader, elected with a Web
+// Lock) owns every port. Other tabs are followers: they get the received
+// lines in batches and send their commands to the leader, which puts them
+// through the device's single write queue. When the leader tab closes, the
+// next tab in line takes the lock and opens the ports itself.
+// Web Serial is not available in workers shared between tabs, hence a tab.
+
+export const SHARE_CHANNEL = "itaiko-serial";
+const LEADER_LOCK = "itaiko-serial-leader";
+
+export const LINE_BATCH_MS = 16;
+
+export type ShareRole = "leader" | "follower";
+
+export interface SharedDeviceState {
+  id: number;
+  status: ConnectionStatus;
+  error: string | null;
+  hasPort: boolean;
+}
+
+// Follower requests, answered with "done"
+export type ShareRequest =
+  | { type: "command"; command: DeviceCommand; data?: string }
+  | { type: "binary"; data: Uint8Array }
+  | { type: "connect" }
+  | { type: "disconnect" }
+  | { type: "lease" }     // Exclusive access (boot screen upload) until "release"
+  | { type: "release" };
+
+export type ShareMessage =
+  | { type: "leader"; from: string }                          // Followers answer with hello
+  | { type: "hello"; from: string }
+  | { type: "bye"; from: string }
+  | { type: "rescan"; from: string }                          // A follower authorized a port
+  | { type: "remove"; from: string; device: number }
+  | { type: "devices"; devices: SharedDeviceState[] }
+  | { type: "lines"; device: number; lines: string[] }
+  | ({ from: string; id: number; device: number } & ShareRequest)
+  | { type: "done"; to: string; id: number; ok: boolean; error?: string };
+
+export interface SerialShare {
+  channel: BroadcastChannel;
+  tabId: string;
+  role: ShareRole;
+}
+
+export const createTabId = (): string => Math.random().toString(36).slice(2, 10);
+
+// Calls onRole("follower") when another tab leads, and onRole("leader") once
+// this tab holds the lock (right away or after the leader closes). Without
+// Web Locks every tab leads, as before.
+export function electSerialLeader(onRole: (role: ShareRole) => void): () => void {
+  let release = () => {};
+  const held = new Promise<void>((resolve) => {
+    release = resolve;
+  });
+
+  if (typeof navigator === "undefined" || !("locks" in navigator)) {
+    queueMicrotask(() => onRole("leader"));
+    return release;
+  }
+
+  const abort = new AbortController();
+  const lead = () => {
+    if (abort.signal.aborted) return undefined;
+    onRole("leader");
+    return held;
+  };
+
+  navigator.locks
+    .request(LEADER_LOCK, { ifAvailable: true }, (lock) => {
+      if (lock) return lead();
+      if (abort.signal.aborted) return undefined;
+      onRole("follower");
+      navigator.locks.request(LEADER_LOCK, { signal: abort.signal }, lead).catch(() => {});
+      return undefined;
+    })
+    .catch((e) => {
+      console.warn("Tab election failed, opening the ports here:", e);
+      onRole("leader");
+    });
+
+  return () => {
+    abort.abort();
+    release();
+  };
+}
@@ -0,0 +1,188 @@
+// Serial trace recorder (?rx=true, ?tx=true, ?trace=true)
+// TX/RX traffic is recorded into preallocated ring buffers: a record ring
+// (timestamp, device, direction, length) and a byte ring for the payloads. Flags are
+// read once at load, so when tracing is off call sites cost a single branch.
+// The newest records win; a record whose payload has been overwritten is
+// reported as lost. Every record carries the session id of its drum, so
+// several drums can share the rings and still be read back one at a time.
+
+export type TraceDirection = "rx" | "tx";
+
+export interface TraceRecord {
+  time: number;        // performance.now() in ms
+  device: number;      // Session (device slot) id
+  direction: TraceDirection;
+  binary: boolean;
+  length: number;      // Original payload length in bytes
+  data: Uint8Array;    // Stored bytes (truncated to TRACE_MAX_PAYLOAD, empty if lost)
+  lost: boolean;       // Payload was overwritten by newer traffic
+}
+
+export const TRACE_RECORD_CAPACITY = 65536;
+export const TRACE_PAYLOAD_CAPACITY = 1 << 20;  // 1 MiB
+export const TRACE_MAX_PAYLOAD = 256;           // Bytes kept per record (bitmap chunks are truncated)
+
+const FLAG_TX = 1;
+const FLAG_BINARY = 2;
+
+const params = typeof window !== "undefined" ? new URLSearchParams(window.location.search) : null;
+const traceAll = params?.get("trace") === "true";
+
+export const traceRxEnabled = traceAll || params?.get("rx") === "true";
+export const traceTxEnabled = traceAll || params?.get("tx") === "true";
+export const traceEnabled = traceRxEnabled || traceTxEnabled;
+
+// Allocated on first use so a disabled trace costs no memory
+let times: Float64Array | null = null;
+let payloadStarts: Float64Array | null = null;  // Absolute position in the byte stream
+let lengths: Uint32Array | null = null;
+let devices: Uint16Array | null = null;
+let flags: Uint8Array | null = null;
+let payload: Uint8Array | null = null;
+let head = 0;
+let count = 0;
+let bytesWritten = 0;  // Monotonic, used to detect overwritten payloads
+let recordsWritten = 0;
+
+function allocate(): void {
+  times = new Float64Array(TRACE_RECORD_CAPACITY);
+  payloadStarts = new Float64Array(TRACE_RECORD_CAPACITY);
+  lengths = new Uint32Array(TRACE_RECORD_CAPACITY);
+  devices = new Uint16Array(TRACE_RECORD_CAPACITY);
+  flags = new Uint8Array(TRACE_RECORD_CAPACITY);
+  payload = new Uint8Array(TRACE_PAYLOAD_CAPACITY);
+}
+
+function pushRecord(device: number, flag: number, length: number): number {
+  if (!times) allocate();
+  const index = head;
+  times![index] = performance.now();
+  payloadStarts![index] = bytesWritten;
+  lengths![index] = length;
+  devices![index] = device;
+  flags![index] = flag;
+  head = (head + 1) % TRACE_RECORD_CAPACITY;
+  count = Math.min(count + 1, TRACE_RECORD_CAPACITY);
+  recordsWritten++;
+  return index;
+}
+
+function writeText(text: string): void {
+  const n = Math.min(text.length, TRACE_MAX_PAYLOAD);
+  let pos = bytesWritten % TRACE_PAYLOAD_CAPACITY;
+  for (let i = 0; i < n; i++) {
+    payload![pos] = text.charCodeAt(i) & 0xff;  // Protocol is ASCII
+    pos = pos + 1 === TRACE_PAYLOAD_CAPACITY ? 0 : pos + 1;
+  }
+  bytesWritten += n;
+}
+
+function writeBytes(data: Uint8Array): void {
+  const n = Math.min(data.length, TRACE_MAX_PAYLOAD);
+  const pos = bytesWritten % TRACE_PAYLOAD_CAPACITY;
+  const first = Math.min(n, TRACE_PAYLOAD_CAPACITY - pos);
+  payload!.set(data.subarray(0, first), pos);
+  if (first < n) payload!.set(data.subarray(first, n), 0);
+  bytesWritten += n;
+}
+
+// Received line (without the newline)
+export function traceRx(device: number, line: string): void {
+  pushRecord(device, 0, line.length);
+  writeText(line);
+}
+
+// Command text or binary data written to the port
+export function traceTx(device: number, data: string | Uint8Array): void {
+  if (typeof data === "string") {
+    pushRecord(device, FLAG_TX, data.length);
+    writeText(data);
+  } else {
+    pushRecord(device, FLAG_TX | FLAG_BINARY, data.length);
+    writeBytes(data);
+  }
+}
+
+export function clearTrace(): void {
+  head = 0;
+  count = 0;
+}
+
+export function getTraceStats(): { records: number; totalRecords: number; bytes: number } {
+  return { records: count, totalRecords: recordsWritten, bytes: bytesWritten };
+}
+
+function readRecord(index: number): TraceRecord {
+  const length = lengths![index];
+  const stored = Math.min(length, TRACE_MAX_PAYLOAD);
+  const start = payloadStarts![index];
+  const lost = bytesWritten - start > TRACE_PAYLOAD_CAPACITY;
+  const data = new Uint8Array(lost ? 0 : stored);
+
+  if (!lost) {
+    const pos = start % TRACE_PAYLOAD_CAPACITY;
+    const first = Math.min(stored, TRACE_PAYLOAD_CAPACITY - pos);
+    data.set(payload!.subarray(pos, pos + first));
+    if (first < stored) data.set(payload!.subarray(0, stored - first), first);
+  }
+
+  return {
+    time: times![index],
+    device: devices![index],
+    direction: flags![index] & FLAG_TX ? "tx" : "rx",
+    binary: (flags![index] & FLAG_BINARY) !== 0,
+    length,
+    data,
+    lost,
+  };
+}
+
+// Records from the last `seconds` (all when omitted), oldest first. With
+// `device`, only that session's records.
+export function getTraceRecords(seconds?: number, device?: number): TraceRecord[] {
+  const records: TraceRecord[] = [];
+  if (!times || count === 0) return records;
+
+  const cutoff = seconds === undefined ? -Infinity : performance.now() - seconds * 1000;
+  // Walk back from the newest record to find the window start
+  let n = 0;
+  while (n < count) {
+    const index = (head - 1 - n + TRACE_RECORD_CAPACITY) % TRACE_RECORD_CAPACITY;
+    if (times[index] < cutoff) break;
+    n++;
+  }
+
+  for (let i = n; i > 0; i--) {
+    const index = (head - i + TRACE_RECORD_CAPACITY) % TRACE_RECORD_CAPACITY;
+    if (device === undefined || devices![index] === device) records.push(readRecord(index));
+  }
+  return records;
+}
+
+// Human readable payload: ASCII for text records, hex for binary ones
+export function formatTracePayload(record: TraceRecord): string {
+  if (record.lost) return `<lost ${record.length} bytes>`;
+  let text = "";
+  if (record.binary) {
+    for (let i = 0; i < record.data.length; i++) text += record.data[i].toString(16).padStart(2, "0");
+    text = `BIN ${record.length} ${text}`;
+  } else {
+    for (let i = 0; i < record.data.length; i++) text += String.fromCharCode(record.data[i]);
+    text = text.replace(/\n/g, "\\n");
+  }
+  return record.data.length < record.length ? `${text}…` : text;
+}
+
+// Tab separated: time_ms, device, RX/TX, payload. Raw stream lines can be
+// replayed with the demo mode session player, which reads one device.
+export function exportTraceText(seconds?: number, device?: number): string {
+  const lines = [
+    `# ITAIKO serial trace ${new Date().toISOString()}`,
+    `# ${typeof navigator !== "undefined" ? navigator.userAgent : ""}`,
+    "# time_ms\tdevice\tdir\tdata",
+  ];
+  for (const record of getTraceRecords(seconds, device)) {
+    lines.push(`${record.time.toFixed(3)}\t${record.device}\t${record.direction.toUpperCase()}\t${formatTracePayload(record)}`);
+  }
+  return lines.join("\n") + "\n";
+}
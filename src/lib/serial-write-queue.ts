@@ -0,0 +1,153 @@
+// Single writer queue for the serial port
+// All writes go through one pump so they reach the device in a defined order:
+// - control commands are sent before queued bulk data
+// - an item identical to the last pending one in its lane is coalesced
+//   (e.g. repeated STOP_STREAMING while the port is busy)
+// - adjacent small items are merged into one transfer
+// - exclusive() hands the port to one caller (boot screen upload) so nothing
+//   else is interleaved with its bytes; other writes wait until it returns
+
+export type WritePriority = "control" | "bulk";
+
+export interface EnqueueOptions {
+  priority?: WritePriority;
+  coalesceKey?: string;  // Items with the same key are interchangeable
+}
+
+export interface SerialWriteQueueOptions {
+  maxBatchBytes?: number;  // Merge adjacent items up to this size (USB CDC packet = 64)
+}
+
+export type ExclusiveWrite = (data: Uint8Array) => Promise<void>;
+
+export interface SerialWriteQueue {
+  enqueue: (data: Uint8Array, options?: EnqueueOptions) => Promise<void>;
+  exclusive: <T>(fn: (write: ExclusiveWrite) => Promise<T>) => Promise<T>;
+  // Reject everything still queued (port closed or lost)
+  clear: (reason: Error) => void;
+  readonly pending: number;
+}
+
+interface QueueItem {
+  data: Uint8Array;
+  key?: string;
+  promise: Promise<void>;
+  resolve: () => void;
+  reject: (err: unknown) => void;
+}
+
+const DEFAULT_MAX_BATCH_BYTES = 64;
+
+function concat(items: QueueItem[], size: number): Uint8Array {
+  const out = new Uint8Array(size);
+  let offset = 0;
+  for (const item of items) {
+    out.set(item.data, offset);
+    offset += item.data.length;
+  }
+  return out;
+}
+
+export function createSerialWriteQueue(
+  write: (data: Uint8Array) => Promise<void>,
+  options: SerialWriteQueueOptions = {}
+): SerialWriteQueue {
+  const maxBatchBytes = options.maxBatchBytes ?? DEFAULT_MAX_BATCH_BYTES;
+  const lanes: Record<WritePriority, QueueItem[]> = { control: [], bulk: [] };
+
+  let pumping = false;
+  let exclusiveHeld = false;
+  let exclusiveTail: Promise<void> = Promise.resolve();
+  let idleWaiters: (() => void)[] = [];
+
+  const nextBatch = (): { items: QueueItem[]; size: number } | null => {
+    const lane = lanes.control.length > 0 ? lanes.control : lanes.bulk;
+    if (lane.length === 0) return null;
+
+    const items = [lane.shift()!];
+    let size = items[0].data.length;
+    while (lane.length > 0 && size + lane[0].data.length <= maxBatchBytes) {
+      size += lane[0].data.length;
+      items.push(lane.shift()!);
+    }
+    return { items, size };
+  };
+
+  const pump = async () => {
+    if (pumping) return;
+    pumping = true;
+    try {
+      while (!exclusiveHeld) {
+        const batch = nextBatch();
+        if (!batch) break;
+        const data = batch.items.length === 1 ? batch.items[0].data : concat(batch.items, batch.size);
+        try {
+          await write(data);
+          batch.items.forEach((item) => item.resolve());
+        } catch (err) {
+          batch.items.forEach((item) => item.reject(err));
+        }
+      }
+    } finally {
+      pumping = false;
+      const waiters = idleWaiters;
+      idleWaiters = [];
+      waiters.forEach((resolve) => resolve());
+    }
+  };
+
+  const waitIdle = (): Promise<void> =>
+    pumping ? new Promise((resolve) => idleWaiters.push(resolve)) : Promise.resolve();
+
+  const enqueue = (data: Uint8Array, { priority = "control", coalesceKey }: EnqueueOptions = {}): Promise<void> => {
+    const lane = lanes[priority];
+    const last = lane[lane.length - 1];
+    if (coalesceKey !== undefined && last?.key === coalesceKey) return last.promise;
+
+    let resolve!: () => void;
+    let reject!: (err: unknown) => void;
+    const promise = new Promise<void>((res, rej) => {
+      resolve = res;
+      reject = rej;
+    });
+    lane.push({ data, key: coalesceKey, promise, resolve, reject });
+    void pump();
+    return promise;
+  };
+
+  const exclusive = <T>(fn: (write: ExclusiveWrite) => Promise<T>): Promise<T> => {
+    // Writes queued before this call still go first
+    const queuedBefore = [...lanes.control, ...lanes.bulk].map((item) => item.promise);
+    const run = exclusiveTail.then(async () => {
+      await Promise.allSettled(queuedBefore);
+      exclusiveHeld = true;  // The pump stops after its current batch
+      await waitIdle();
+      try {
+        return await fn(write);
+      } finally {
+        exclusiveHeld = false;
+        void pump();
+      }
+    });
+    exclusiveTail = run.then(
+      () => undefined,
+      () => undefined
+    );
+    return run;
+  };
+
+  const clear = (reason: Error) => {
+    for (const lane of [lanes.control, lanes.bulk]) {
+      lane.splice(0).forEach((item) => item.reject(reason));
+    }
+  };
+
+  return {
+    enqueue,
+    exclusive,
+    clear,
+    get pending() {
+      return lanes.control.length + lanes.bulk.length;
+    },
+  };
+}
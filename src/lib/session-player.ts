@@ -0,0 +1,133 @@
+import type { PadName, PadBuffers } from "@/types";
+import { PAD_NAMES } from "@/types";
+import { parseRawStreamLine, parseInputStreamLine } from "@/lib/serial-protocol";
+import type { SignalSource } from "@/lib/device-emulator";
+
+// Recorded session player
+// Replays raw stream lines captured from a real drum as an emulator signal source.
+
+export interface SessionPlayer extends SignalSource {
+  readonly length: number;
+  readonly position: number;
+  seek: (frame: number) => void;
+}
+
+export interface ParsedSession {
+  frames: Uint16Array;              // kaLeft, donLeft, donRight, kaRight per sample
+  sampleIntervalMs: number | null;  // From trace timestamps; null for plain captures
+  inputMasks: Uint8Array | null;    // Input stream mask per sample, when both streams were on
+}
+
+// Extract raw frames from a recorded session. Accepts plain stream captures
+// (one 16-char hex line per sample) and serial trace exports (RX records);
+// other lines are skipped. A trace of several drums keeps the drum of its
+// first RX record. Input stream lines follow the raw line of their sample and
+// are kept as one mask per frame.
+export function parseSession(text: string): ParsedSession {
+  const lines = text.split("\n");
+  const frames = new Uint16Array(lines.length * 4);
+  const masks = new Uint8Array(lines.length);
+  let hasInput = false;
+  let count = 0;
+  let firstTime = NaN;
+  let lastTime = NaN;
+  let device: string | null = null;
+
+  for (const line of lines) {
+    // Trace export: time_ms<TAB>device<TAB>RX<TAB>data (older exports have no device)
+    const fields = line.split("\t");
+    const traced = fields.length === 3 || fields.length === 4;
+    if (traced && fields[fields.length - 2] !== "RX") continue;
+    if (fields.length === 4) {
+      device ??= fields[1];
+      if (fields[1] !== device) continue;
+    }
+    const data = fields[fields.length - 1];
+    if (data.trim().length <= 2) {
+      const inputs = parseInputStreamLine(data);
+      if (inputs && count > 0) {
+        masks[count - 1] |= PAD_NAMES.reduce((mask, pad, bit) => (inputs[pad] ? mask | (1 << bit) : mask), 0);
+        hasInput = true;
+      }
+      continue;
+    }
+    const raw = parseRawStreamLine(data);
+    if (!raw) continue;
+    frames[count * 4] = raw.kaLeft;
+    frames[count * 4 + 1] = raw.donLeft;
+    frames[count * 4 + 2] = raw.donRight;
+    frames[count * 4 + 3] = raw.kaRight;
+    count++;
+    if (traced) {
+      const time = parseFloat(fields[0]);
+      if (Number.isNaN(firstTime)) firstTime = time;
+      lastTime = time;
+    }
+  }
+
+  // Lines arrive in USB packets, so only the average over the whole trace is meaningful
+  const span = lastTime - firstTime;
+  return {
+    frames: frames.slice(0, count * 4),
+    sampleIntervalMs: count > 1 && span > 0 ? span / (count - 1) : null,
+    inputMasks: hasInput ? masks.slice(0, count) : null,
+  };
+}
+
+export function parseSessionText(text: string): Uint16Array {
+  return parseSession(text).frames;
+}
+
+// The graph buffers as session frames, oldest first. The zero fill before
+// the stream started is dropped; gaps (NaN) repeat the previous sample so
+// they don't read as hits.
+export function framesFromPadBuffers(buffers: PadBuffers): Uint16Array {
+  const length = Math.min(...PAD_NAMES.map((pad) => buffers[pad].capacity));
+  const at = (pad: PadName, i: number) => {
+    const { raw, head, capacity } = buffers[pad];
+    return raw[(head - length + i + capacity) % capacity];
+  };
+
+  let start = 0;
+  while (start < length && PAD_NAMES.some((pad) => !(at(pad, start) > 0))) start++;
+
+  const frames = new Uint16Array((length - start) * 4);
+  PAD_NAMES.forEach((pad, p) => {
+    let previous = at(pad, start);
+    for (let i = start; i < length; i++) {
+      const value = at(pad, i);
+      if (value === value) previous = value;
+      frames[(i - start) * 4 + p] = previous;
+    }
+  });
+  return frames;
+}
+
+export function createSessionPlayer(frames: Uint16Array, loop = true): SessionPlayer {
+  const length = Math.floor(frames.length / 4);
+  const frame: Record<PadName, number> = { kaLeft: 0, donLeft: 0, donRight: 0, kaRight: 0 };
+  let position = 0;
+
+  return {
+    length,
+    get position() {
+      return position;
+    },
+    seek: (next) => {
+      position = Math.max(0, Math.min(length, next));
+    },
+    nextFrame: () => {
+      if (position >= length) {
+        if (!loop || length === 0) return frame; // Hold the last frame
+        position = 0;
+      }
+      const o = position * 4;
+      frame.kaLeft = frames[o];
+      frame.donLeft = frames[o + 1];
+      frame.donRight = frames[o + 2];
+      frame.kaRight = frames[o + 3];
+      position++;
+      return frame;
+    },
+  };
+}
@@ -0,0 +1,239 @@
+import type { PadName } from "@/types";
+import { PAD_NAMES } from "@/types";
+import { encodeRawStreamLine } from "@/lib/serial-protocol";
+
+// Synthetic drum signal generator
+// Produces raw ADC frames for the four pads, in the same order and format as
+// the firmware raw stream (command 2000). Fully deterministic for a given seed,
+// so the same options always yield the same lines.
+
+export const ADC_MAX = 4095;
+
+export const SAMPLE_RATE_MIN = 100;
+export const SAMPLE_RATE_MAX = 10000;
+
+export interface SignalGeneratorOptions {
+  seed?: number;
+  sampleRate?: number;        // Hz (100 - 10000)
+  baseline?: number;          // Resting ADC value
+  noiseFloor?: number;        // Gaussian noise standard deviation (ADC counts)
+  driftAmplitude?: number;    // Slow baseline wander (ADC counts)
+  driftPeriodMs?: number;
+  crosstalk?: number;         // Fraction of a hit that bleeds into the same-side pad
+  hitRate?: number;           // Automatic hits per second (0 = manual hits only)
+  velocityMin?: number;       // Peak height above baseline for automatic hits
+  velocityMax?: number;       // Values above ADC_MAX - baseline saturate
+}
+
+export interface SignalGenerator {
+  readonly sampleRate: number;
+  readonly sampleIndex: number;
+  // Start a hit on a pad at the current sample (velocity = peak above baseline)
+  hit: (pad: PadName, velocity?: number) => void;
+  // Advance one sample and return the raw ADC values
+  nextFrame: () => Record<PadName, number>;
+  // Advance one sample and return it as a 16-char hex stream line
+  nextLine: () => string;
+  // Advance `count` samples and return them as newline-terminated lines
+  generate: (count: number) => string;
+  // Advance `frames` samples, writing kaLeft, donLeft, donRight, kaRight per frame
+  fill: (out: Uint16Array, frames: number) => void;
+  reset: (seed?: number) => void;
+}
+
+// Per-pad response shape. Rims (ka) are stiffer and ring faster than the head (don).
+const PAD_SHAPE: Record<PadName, { attackMs: number; decayMs: number; ringHz: number }> = {
+  kaLeft: { attackMs: 0.6, decayMs: 6, ringHz: 320 },
+  donLeft: { attackMs: 1.2, decayMs: 14, ringHz: 160 },
+  donRight: { attackMs: 1.2, decayMs: 14, ringHz: 160 },
+  kaRight: { attackMs: 0.6, decayMs: 6, ringHz: 320 },
+};
+
+// Bleed from a source pad (row) into the other pads (column), relative to `crosstalk`.
+// Same-side don/ka couple strongest, the opposite side only weakly.
+const BLEED: Record<PadName, Record<PadName, number>> = {
+  kaLeft: { kaLeft: 0, donLeft: 0.6, donRight: 0.15, kaRight: 0.1 },
+  donLeft: { kaLeft: 1, donLeft: 0, donRight: 0.35, kaRight: 0.25 },
+  donRight: { kaLeft: 0.25, donLeft: 0.35, donRight: 0, kaRight: 1 },
+  kaRight: { kaLeft: 0.1, donLeft: 0.15, donRight: 0.6, kaRight: 0 },
+};
+
+const BLEED_LAG_MS = 0.8;
+const AUTO_HIT_WEIGHTS: Record<PadName, number> = { kaLeft: 0.2, donLeft: 0.3, donRight: 0.3, kaRight: 0.2 };
+
+// Fixed number of overlapping envelopes per pad (oldest is replaced)
+const MAX_VOICES = 8;
+
+// Small, fast seedable PRNG (mulberry32)
+export function mulberry32(seed: number): () => number {
+  let a = seed >>> 0;
+  return () => {
+    a = (a + 0x6d2b79f5) >>> 0;
+    let t = a;
+    t = Math.imul(t ^ (t >>> 15), t | 1);
+    t ^= t + Math.imul(t ^ (t >>> 7), t | 61);
+    return ((t ^ (t >>> 14)) >>> 0) / 4294967296;
+  };
+}
+
+interface Voices {
+  start: Float64Array;   // Sample index where the envelope starts
+  amp: Float32Array;     // Peak height
+  next: number;          // Slot to overwrite next
+}
+
+function createVoices(): Voices {
+  return {
+    start: new Float64Array(MAX_VOICES).fill(-Infinity),
+    amp: new Float32Array(MAX_VOICES),
+    next: 0,
+  };
+}
+
+export function createSignalGenerator(options: SignalGeneratorOptions = {}): SignalGenerator {
+  const sampleRate = Math.max(SAMPLE_RATE_MIN, Math.min(SAMPLE_RATE_MAX, options.sampleRate ?? 1000));
+  const baseline = options.baseline ?? 200;
+  const noiseFloor = options.noiseFloor ?? 6;
+  const driftAmplitude = options.driftAmplitude ?? 25;
+  const driftPeriodMs = options.driftPeriodMs ?? 20000;
+  const crosstalk = options.crosstalk ?? 0.12;
+  const hitRate = options.hitRate ?? 0;
+  const velocityMin = options.velocityMin ?? 600;
+  const velocityMax = options.velocityMax ?? 4500;
+
+  const msPerSample = 1000 / sampleRate;
+  const bleedLagSamples = Math.round(BLEED_LAG_MS / msPerSample);
+  const driftStep = (2 * Math.PI * msPerSample) / driftPeriodMs;
+  const autoHitProbability = hitRate / sampleRate;
+
+  let random = mulberry32(options.seed ?? 1);
+  let sampleIndex = 0;
+  let spareGaussian: number | null = null;
+  const driftPhase: Record<PadName, number> = { kaLeft: 0, donLeft: 0, donRight: 0, kaRight: 0 };
+  const voices: Record<PadName, Voices> = {
+    kaLeft: createVoices(),
+    donLeft: createVoices(),
+    donRight: createVoices(),
+    kaRight: createVoices(),
+  };
+  const frame: Record<PadName, number> = { kaLeft: 0, donLeft: 0, donRight: 0, kaRight: 0 };
+
+  const reset = (seed?: number) => {
+    random = mulberry32(seed ?? options.seed ?? 1);
+    sampleIndex = 0;
+    spareGaussian = null;
+    PAD_NAMES.forEach((pad) => {
+      driftPhase[pad] = random() * 2 * Math.PI;
+      voices[pad].start.fill(-Infinity);
+      voices[pad].amp.fill(0);
+      voices[pad].next = 0;
+    });
+  };
+
+  // Box-Muller, caching the second value
+  const gaussian = (): number => {
+    if (spareGaussian !== null) {
+      const v = spareGaussian;
+      spareGaussian = null;
+      return v;
+    }
+    const u = Math.max(random(), 1e-12);
+    const v = random();
+    const r = Math.sqrt(-2 * Math.log(u));
+    spareGaussian = r * Math.sin(2 * Math.PI * v);
+    return r * Math.cos(2 * Math.PI * v);
+  };
+
+  const addVoice = (pad: PadName, start: number, amp: number) => {
+    const v = voices[pad];
+    v.start[v.next] = start;
+    v.amp[v.next] = amp;
+    v.next = (v.next + 1) % MAX_VOICES;
+  };
+
+  const hit = (pad: PadName, velocity?: number) => {
+    const amp = velocity ?? velocityMin + random() * (velocityMax - velocityMin);
+    addVoice(pad, sampleIndex, amp);
+    if (crosstalk <= 0) return;
+    PAD_NAMES.forEach((target) => {
+      const ratio = BLEED[pad][target] * crosstalk;
+      if (ratio > 0) addVoice(target, sampleIndex + bleedLagSamples, amp * ratio);
+    });
+  };
+
+  const pickAutoPad = (): PadName => {
+    let r = random();
+    for (const pad of PAD_NAMES) {
+      r -= AUTO_HIT_WEIGHTS[pad];
+      if (r <= 0) return pad;
+    }
+    return "donRight";
+  };
+
+  const envelope = (pad: PadName, elapsedMs: number): number => {
+    const shape = PAD_SHAPE[pad];
+    if (elapsedMs < shape.attackMs) return elapsedMs / shape.attackMs;
+    const t = elapsedMs - shape.attackMs;
+    const ring = 0.75 + 0.25 * Math.cos((2 * Math.PI * shape.ringHz * t) / 1000);
+    return Math.exp(-t / shape.decayMs) * ring;
+  };
+
+  const nextFrame = (): Record<PadName, number> => {
+    if (autoHitProbability > 0 && random() < autoHitProbability) {
+      hit(pickAutoPad());
+    }
+
+    for (const pad of PAD_NAMES) {
+      driftPhase[pad] += driftStep;
+      let value = baseline + driftAmplitude * Math.sin(driftPhase[pad]) + noiseFloor * gaussian();
+
+      const v = voices[pad];
+      const decayLimitMs = PAD_SHAPE[pad].decayMs * 8;
+      for (let i = 0; i < MAX_VOICES; i++) {
+        const elapsedMs = (sampleIndex - v.start[i]) * msPerSample;
+        if (elapsedMs < 0 || elapsedMs > decayLimitMs) continue;
+        value += v.amp[i] * envelope(pad, elapsedMs);
+      }
+
+      // ADC saturates at 12 bits
+      frame[pad] = value <= 0 ? 0 : value >= ADC_MAX ? ADC_MAX : Math.round(value);
+    }
+
+    sampleIndex++;
+    return frame;
+  };
+
+  const nextLine = (): string => encodeRawStreamLine(nextFrame());
+
+  const generate = (count: number): string => {
+    const lines: string[] = new Array(count);
+    for (let i = 0; i < count; i++) lines[i] = nextLine();
+    return count > 0 ? lines.join("\n") + "\n" : "";
+  };
+
+  const fill = (out: Uint16Array, frames: number) => {
+    for (let i = 0; i < frames; i++) {
+      const f = nextFrame();
+      const o = i * 4;
+      out[o] = f.kaLeft;
+      out[o + 1] = f.donLeft;
+      out[o + 2] = f.donRight;
+      out[o + 3] = f.kaRight;
+    }
+  };
+
+  reset();
+
+  return {
+    sampleRate,
+    get sampleIndex() {
+      return sampleIndex;
+    },
+    hit,
+    nextFrame,
+    nextLine,
+    generate,
+    fill,
+    reset,
+  };
+}
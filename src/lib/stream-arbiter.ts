@@ -0,0 +1,63 @@
+import type { DeviceCommand } from "@/types";
+import { DeviceCommand as DeviceCommandValues } from "@/types";
+
+// Streaming arbitration for a port shared by several tabs
+// Streaming starts when the first client asks for a mode and stops only when
+// no client wants any. The firmware has a single STOP for both modes, so a
+// mode other clients still use is restarted right after it. Every other
+// command passes straight through.
+
+type StreamMode = "raw" | "input";
+
+const START_COMMANDS: Record<StreamMode, DeviceCommand> = {
+  raw: DeviceCommandValues.START_STREAMING,
+  input: DeviceCommandValues.START_INPUT_STREAMING,
+};
+
+export interface StreamArbiter {
+  command: (client: string, command: DeviceCommand, data?: string) => Promise<void>;
+  release: (client: string) => Promise<void>;  // Client went away
+  reset: () => void;                            // Device disconnected
+}
+
+export function createStreamArbiter(send: (command: DeviceCommand, data?: string) => Promise<void>): StreamArbiter {
+  const wants: Record<StreamMode, Set<string>> = { raw: new Set(), input: new Set() };
+
+  const start = async (client: string, mode: StreamMode) => {
+    const first = wants[mode].size === 0;
+    wants[mode].add(client);
+    if (first) await send(START_COMMANDS[mode]);
+  };
+
+  const stop = async (client: string) => {
+    const ended = (["raw", "input"] as StreamMode[]).filter((mode) => wants[mode].delete(client) && wants[mode].size === 0);
+    const active = (["raw", "input"] as StreamMode[]).filter((mode) => wants[mode].size > 0);
+
+    // Nobody streams: always send it, it doubles as the reset on connect
+    if (active.length === 0) return send(DeviceCommandValues.STOP_STREAMING);
+    if (ended.length === 0) return;
+    await send(DeviceCommandValues.STOP_STREAMING);
+    for (const mode of active) await send(START_COMMANDS[mode]);
+  };
+
+  return {
+    command(client, command, data) {
+      if (data === undefined) {
+        if (command === DeviceCommandValues.START_STREAMING) return start(client, "raw");
+        if (command === DeviceCommandValues.START_INPUT_STREAMING) return start(client, "input");
+        if (command === DeviceCommandValues.STOP_STREAMING) return stop(client);
+      }
+      return send(command, data);
+    },
+
+    release(client) {
+      if (!wants.raw.has(client) && !wants.input.has(client)) return Promise.resolve();
+      return stop(client);
+    },
+
+    reset() {
+      wants.raw.clear();
+      wants.input.clear();
+    },
+  };
+}
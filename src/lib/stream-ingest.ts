@@ -0,0 +1,85 @@
+import type { PadName, PadBuffers, TriggerState } from "@/types";
+import { PAD_NAMES } from "@/types";
+import { parseRawStreamLine, parseInputStreamLine } from "@/lib/serial-protocol";
+import { holdOffNoise, recordNoiseSample, type NoiseStats } from "@/lib/noise-stats";
+
+// Streaming hot path: one call per received line, writes straight into the
+// pad ring buffers and accumulates triggers until the next UI frame.
+
+export interface StreamIngestState {
+  buffers: PadBuffers;
+  previousRaw: Record<PadName, number>;
+  triggers: TriggerState;  // Accumulated between UI frames
+  noise: NoiseStats | null;
+}
+
+export function createStreamIngestState(buffers: PadBuffers, noise: NoiseStats | null = null): StreamIngestState {
+  return {
+    buffers,
+    noise,
+    previousRaw: { kaLeft: 0, donLeft: 0, donRight: 0, kaRight: 0 },
+    triggers: { kaLeft: false, donLeft: false, donRight: false, kaRight: false },
+  };
+}
+
+export function resetStreamIngestState(state: StreamIngestState): void {
+  PAD_NAMES.forEach((pad) => {
+    state.previousRaw[pad] = 0;
+    state.triggers[pad] = false;
+  });
+}
+
+// Samples were lost (the connection dropped): one NaN sample per pad marks
+// the gap for the graphs, and the first delta after it is zero
+export function markStreamGap(state: StreamIngestState): void {
+  const { buffers, previousRaw } = state;
+  PAD_NAMES.forEach((pad) => {
+    const buffer = buffers[pad];
+    buffer.raw[buffer.head] = NaN;
+    buffer.delta[buffer.head] = NaN;
+    buffer.head = (buffer.head + 1) % buffer.capacity;
+    previousRaw[pad] = NaN;
+  });
+}
+
+export function ingestStreamLine(state: StreamIngestState, line: string): void {
+  let inputs: Record<PadName, boolean> | null = null;
+  let raws: Record<PadName, number> | null = null;
+
+  // 1. Try Input Hex (1-2 chars)
+  if (line.length <= 2) {
+    inputs = parseInputStreamLine(line);
+  }
+  // 2. Try Raw Hex (16 chars)
+  else if (line.length === 16) {
+    raws = parseRawStreamLine(line);
+  }
+
+  // Process Inputs
+  if (inputs) {
+    const accumulated = state.triggers;
+    let triggered = false;
+    PAD_NAMES.forEach((pad) => {
+      if (inputs![pad]) accumulated[pad] = triggered = true;
+    });
+    if (triggered && state.noise) holdOffNoise(state.noise);
+  }
+
+  // Process Raws
+  if (raws) {
+    const { buffers, previousRaw } = state;
+    PAD_NAMES.forEach((pad) => {
+      const buffer = buffers[pad];
+      const rawVal = raws![pad];
+      const previous = previousRaw[pad];
+      const delta = rawVal > previous ? rawVal - previous : 0;  // Also 0 after a gap (NaN)
+
+      buffer.raw[buffer.head] = rawVal;
+      buffer.delta[buffer.head] = delta;
+      buffer.head = (buffer.head + 1) % buffer.capacity;
+
+      previousRaw[pad] = rawVal;
+    });
+    if (state.noise) recordNoiseSample(state.noise, buffers);
+  }
+}
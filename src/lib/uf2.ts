@@ -0,0 +1,138 @@
+import { createSha256 } from "@/lib/sha256";
+
+// UF2 firmware validation
+// The image is checked block by block while it streams to the RPI-RP2 drive.
+// The bootloader flashes blocks as they arrive but only finishes (and
+// reboots) once it has all of them, so the last block is held back until
+// the size and hash have been verified. Any problem errors the stream and
+// the device stays in BOOTSEL.
+
+export const UF2_BLOCK_SIZE = 512;
+const UF2_MAGIC_START0 = 0x0a324655;  // "UF2\n"
+const UF2_MAGIC_START1 = 0x9e5d5157;
+const UF2_MAGIC_END = 0x0ab16f30;
+const UF2_FLAG_NOT_MAIN_FLASH = 0x00000001;
+const UF2_FLAG_FAMILY_ID_PRESENT = 0x00002000;
+
+export const RP2040_FAMILY_ID = 0xe48bff56;
+const RP2040_FLASH_START = 0x10000000;
+const RP2040_FLASH_END = 0x11000000;  // 16 MiB XIP window
+const RP2040_PAYLOAD_SIZE = 256;      // The bootloader only accepts 256 byte pages
+
+export interface Uf2ValidationOptions {
+  expectedSize?: number;
+  expectedSha256?: string;
+  onProgress?: (bytes: number) => void;
+}
+
+// Checks one block; returns an error message or null
+export function validateUf2Block(block: Uint8Array, index: number, expectedBlocks: number | null): string | null {
+  const view = new DataView(block.buffer, block.byteOffset, UF2_BLOCK_SIZE);
+  const at = `block ${index}`;
+
+  if (
+    view.getUint32(0, true) !== UF2_MAGIC_START0 ||
+    view.getUint32(4, true) !== UF2_MAGIC_START1 ||
+    view.getUint32(508, true) !== UF2_MAGIC_END
+  ) {
+    return `Not a UF2 file (bad magic in ${at})`;
+  }
+
+  const flags = view.getUint32(8, true);
+  if (flags & UF2_FLAG_NOT_MAIN_FLASH) return `Unexpected non-flash ${at}`;
+  if (!(flags & UF2_FLAG_FAMILY_ID_PRESENT) || view.getUint32(28, true) !== RP2040_FAMILY_ID) {
+    return `Firmware is not built for the RP2040 (${at})`;
+  }
+
+  const address = view.getUint32(12, true);
+  const payloadSize = view.getUint32(16, true);
+  if (payloadSize !== RP2040_PAYLOAD_SIZE) return `Unexpected payload size ${payloadSize} in ${at}`;
+  if (address < RP2040_FLASH_START || address + payloadSize > RP2040_FLASH_END || address % payloadSize !== 0) {
+    return `Address 0x${address.toString(16)} in ${at} is outside the flash`;
+  }
+
+  const blockNo = view.getUint32(20, true);
+  const numBlocks = view.getUint32(24, true);
+  if (blockNo !== index) return `Blocks out of order (expected ${index}, got ${blockNo})`;
+  if (numBlocks === 0 || (expectedBlocks !== null && numBlocks !== expectedBlocks)) {
+    return `Inconsistent block count in ${at}`;
+  }
+  return null;
+}
+
+// Passes the image through unchanged once each block has been checked
+export function createUf2ValidationStream(options: Uf2ValidationOptions = {}): TransformStream<Uint8Array, Uint8Array> {
+  const { expectedSize, expectedSha256, onProgress } = options;
+  const sha = expectedSha256 ? createSha256() : null;
+  const partial = new Uint8Array(UF2_BLOCK_SIZE);
+  let partialLength = 0;
+  let blockIndex = 0;
+  let totalBlocks: number | null = null;
+  let bytes = 0;
+  let held: Uint8Array | null = null;  // Last validated block, sent in flush()
+
+  // `blocks` is an owned copy of one or more validated blocks
+  const forward = (controller: TransformStreamDefaultController<Uint8Array>, blocks: Uint8Array) => {
+    if (held) controller.enqueue(held);
+    const last = blocks.length - UF2_BLOCK_SIZE;
+    if (last > 0) controller.enqueue(blocks.subarray(0, last));
+    held = blocks.subarray(last);
+  };
+
+  const checkBlock = (block: Uint8Array) => {
+    const error = validateUf2Block(block, blockIndex, totalBlocks);
+    if (error) throw new Error(error);
+    totalBlocks ??= new DataView(block.buffer, block.byteOffset).getUint32(24, true);
+    blockIndex++;
+  };
+
+  return new TransformStream<Uint8Array, Uint8Array>({
+    transform(chunk, controller) {
+      bytes += chunk.length;
+      if (expectedSize !== undefined && bytes > expectedSize) {
+        throw new Error(`Firmware is larger than the expected ${expectedSize} bytes`);
+      }
+      sha?.update(chunk);
+
+      let offset = 0;
+      if (partialLength > 0) {
+        const n = Math.min(UF2_BLOCK_SIZE - partialLength, chunk.length);
+        partial.set(chunk.subarray(0, n), partialLength);
+        partialLength += n;
+        offset = n;
+        if (partialLength < UF2_BLOCK_SIZE) return;
+        checkBlock(partial);
+        forward(controller, partial.slice());
+        partialLength = 0;
+      }
+
+      // Whole blocks are forwarded in one piece
+      const start = offset;
+      for (; offset + UF2_BLOCK_SIZE <= chunk.length; offset += UF2_BLOCK_SIZE) {
+        checkBlock(chunk.subarray(offset, offset + UF2_BLOCK_SIZE));
+      }
+      if (offset > start) forward(controller, chunk.slice(start, offset));
+
+      partial.set(chunk.subarray(offset), 0);
+      partialLength = chunk.length - offset;
+      onProgress?.(bytes);
+    },
+
+    flush(controller) {
+      if (partialLength > 0) throw new Error("Firmware ends with an incomplete UF2 block");
+      if (blockIndex === 0 || blockIndex !== totalBlocks) {
+        throw new Error(`Firmware is truncated (${blockIndex} of ${totalBlocks ?? "?"} blocks)`);
+      }
+      if (expectedSize !== undefined && bytes !== expectedSize) {
+        throw new Error(`Firmware is ${bytes} bytes, expected ${expectedSize}`);
+      }
+      if (sha && expectedSha256) {
+        const digest = sha.digestHex();
+        if (digest !== expectedSha256.toLowerCase()) {
+          throw new Error("Firmware checksum does not match the manifest");
+        }
+      }
+      controller.enqueue(held!);
+    },
+  });
+}
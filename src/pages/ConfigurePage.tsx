@@ -1,33 +1,65 @@
+import { Suspense, useEffect, useState, type ReactNode } from "react";
 import { Link, useSearchParams } from "react-router-dom";
 import { Tabs, TabsContent, TabsList, TabsTrigger } from "@/components/ui/tabs";
-import { DeviceProvider } from "@/context/DeviceContext";
+import { DeviceManagerProvider } from "@/context/DeviceManagerContext";
+import { useDevice } from "@/context/DeviceContext";
+import { MonitorPopoutProvider, useMonitorPopout } from "@/context/MonitorPopoutContext";
 import { HeaderConnectionStatus } from "@/components/connection/HeaderConnectionStatus";
 import { FirmwareUpdatePanel } from "@/components/connection/FirmwareUpdatePanel";
-import { FirmwareUpdateModal } from "@/components/connection/FirmwareUpdateModal";
+import { SerialTraceDialog } from "@/components/connection/SerialTraceDialog";
+import { DeviceSwitcher } from "@/components/connection/DeviceSwitcher";
 import { ConfigurationTab } from "@/components/configuration/ConfigurationTab";
-import { LiveMonitorTab } from "@/components/monitor/LiveMonitorTab";
-import { initializeHelpContent } from "@/lib/help-content";
+import { MonitorPopoutFeed } from "@/components/monitor/MonitorPopoutFeed";
+import { Badge } from "@/components/ui/badge";
+import { startDemoDevice } from "@/lib/demo-device";
+import { traceEnabled } from "@/lib/serial-trace";
+import { chunkLoaders, lazyNamed, prefetchChunks } from "@/lib/lazy-chunks";
+import { useOpenedOnce } from "@/hooks/useOpenedOnce";
 
-// Initialize help content
-initializeHelpContent();
+const LiveMonitorTab = lazyNamed(chunkLoaders.liveMonitor, "LiveMonitorTab");
+const FirmwareUpdateModal = lazyNamed(chunkLoaders.firmwareUpdateModal, "FirmwareUpdateModal");
 
 function ConfigurePageContent() {
   const [searchParams, setSearchParams] = useSearchParams();
   const currentTab = searchParams.get("tab") || "config";
+  const isDemo = searchParams.get("demo") === "true";
+  const popout = useMonitorPopout();
+  const { isReady, firmwareUpdate } = useDevice();
+  const firmwareModalMounted = useOpenedOnce(firmwareUpdate.modalOpen);
+
+  // Warm up the lazy chunks once the drum is usable and the page has settled
+  useEffect(() => {
+    if (isReady) prefetchChunks();
+  }, [isReady]);
 
   const onTabChange = (value: string) => {
-    setSearchParams({ tab: value });
+    searchParams.set("tab", value);
+    setSearchParams(searchParams);
   };
 
   return (
     <div className="h-screen flex flex-col w-full">
-      <FirmwareUpdateModal />
+      {firmwareModalMounted && (
+        <Suspense fallback={null}>
+          <FirmwareUpdateModal />
+        </Suspense>
+      )}
+      {popout.isOpen && <MonitorPopoutFeed />}
       {/* Header with connection status - fixed height */}
       <header className="border-b w-full flex-shrink-0">
         <div className="flex h-14 items-center justify-between px-4 max-w-5xl mx-auto w-full">
-          <Link to="/" className="font-bold text-xl">
-            <img src="itaiko.png" className="pixelated drag-none" alt="Logo" />
-          </Link>
+          <div className="flex items-center gap-3">
+            <Link to="/" className="font-bold text-xl">
+              <img src="itaiko.png" className="pixelated drag-none" alt="Logo" />
+            </Link>
+            {isDemo && (
+              <Badge variant="secondary" title="Running against an emulated drum">
+                Demo
+              </Badge>
+            )}
+            {traceEnabled && <SerialTraceDialog />}
+            <DeviceSwitcher />
+          </div>
           <HeaderConnectionStatus />
         </div>
       </header>
@@ -50,7 +82,9 @@ function ConfigurePageContent() {
             </TabsContent>
 
             <TabsContent value="monitor" className="mt-0">
-              <LiveMonitorTab />
+              <Suspense fallback={<p className="py-12 text-center text-sm text-muted-foreground">Loading monitor…</p>}>
+                <LiveMonitorTab />
+              </Suspense>
             </TabsContent>
 
             {/* Firmware Update Panel */}
@@ -67,10 +101,54 @@ function ConfigurePageContent() {
   );
 }
 
+// Installs the emulated drum before DeviceManagerProvider mounts, so the serial hooks
+// find it through navigator.serial like a real, already authorized device
+function DemoDevice({ sessionUrl, children }: { sessionUrl?: string; children: ReactNode }) {
+  const [ready, setReady] = useState(false);
+
+  useEffect(() => {
+    let cancelled = false;
+    let stop: (() => void) | null = null;
+
+    startDemoDevice({ sessionUrl }).then((demo) => {
+      if (cancelled) {
+        demo.stop();
+        return;
+      }
+      stop = demo.stop;
+      setReady(true);
+    });
+
+    return () => {
+      cancelled = true;
+      setReady(false);
+      stop?.();
+    };
+  }, [sessionUrl]);
+
+  return ready ? children : null;
+}
+
 export function ConfigurePage() {
+  const [searchParams] = useSearchParams();
+
+  if (searchParams.get("demo") === "true") {
+    return (
+      <DemoDevice sessionUrl={searchParams.get("session") ?? undefined}>
+        <MonitorPopoutProvider>
+          <DeviceManagerProvider>
+            <ConfigurePageContent />
+          </DeviceManagerProvider>
+        </MonitorPopoutProvider>
+      </DemoDevice>
+    );
+  }
+
   return (
-    <DeviceProvider>
-      <ConfigurePageContent />
-    </DeviceProvider>
+    <MonitorPopoutProvider>
+      <DeviceManagerProvider>
+        <ConfigurePageContent />
+      </DeviceManagerProvider>
+    </MonitorPopoutProvider>
   );
 }
\ No newline at end of file
@@ -0,0 +1,100 @@
+import { useEffect, useState } from "react";
+import { PadGraph } from "@/components/monitor/PadGraph";
+import { createPadBuffers } from "@/lib/pad-buffer";
+import {
+  MONITOR_PORT,
+  MONITOR_RELAY,
+  writeSamples,
+  type MonitorMessage,
+  type MonitorRelayMessage,
+  type MonitorWindowMessage,
+} from "@/lib/monitor-channel";
+import { DEFAULT_DEVICE_CONFIG } from "@/lib/default-config";
+import { PAD_NAMES, type PadBuffers } from "@/types";
+
+// Pop-out monitor window, opened from the Live Monitor tab. Runs no device
+// code: samples and threshold lines arrive over the port the relay hands
+// over for the configurator session in the URL (see monitor-channel).
+export function MonitorWindowPage() {
+  const session = new URLSearchParams(window.location.search).get("session");
+  const [port, setPort] = useState<MessagePort | null>(null);
+  const [view, setView] = useState(() => ({ buffers: createPadBuffers(5000), capacity: 5000, title: "ITAIKO" }));
+  const [thresholds, setThresholds] = useState({ pads: DEFAULT_DEVICE_CONFIG.pads, showHeavy: false });
+
+  useEffect(() => {
+    document.title = `${view.title} – Live Monitor`;
+  }, [view.title]);
+
+  // Join the configurator's session, again after every reload
+  useEffect(() => {
+    if (!session) return;
+    const relay = new SharedWorker(new URL("../workers/monitor-relay.worker.ts", import.meta.url), {
+      type: "module",
+      name: MONITOR_RELAY,
+    });
+    relay.port.onmessage = (event: MessageEvent) => {
+      if (event.data?.type !== MONITOR_PORT || !event.ports[0]) return;
+      setPort(event.ports[0]);
+    };
+    relay.port.postMessage({ type: "join", session, role: "window" } satisfies MonitorRelayMessage);
+    return () => relay.port.close();
+  }, [session]);
+
+  useEffect(() => {
+    if (!port) return;
+    // The feed starts every stream with "reset"
+    let buffers: PadBuffers | null = null;
+
+    port.onmessage = (event: MessageEvent<MonitorMessage>) => {
+      const message = event.data;
+      if (message.type === "samples") {
+        if (buffers) writeSamples(buffers, message.count, message.data);
+      } else if (message.type === "reset") {
+        buffers = createPadBuffers(message.capacity);
+        setView({ buffers, capacity: message.capacity, title: message.title });
+      } else if (message.type === "thresholds") {
+        setThresholds({ pads: message.thresholds, showHeavy: message.showHeavy });
+      } else if (message.type === "focus") {
+        window.focus();
+      } else if (message.type === "close") {
+        window.close();
+      }
+    };
+
+    // Closed or reloading; the configurator waits a moment for a new port
+    const onPageHide = () => port.postMessage({ type: "hidden" } satisfies MonitorWindowMessage);
+    window.addEventListener("pagehide", onPageHide);
+    return () => {
+      port.onmessage = null;
+      window.removeEventListener("pagehide", onPageHide);
+      port.close();
+    };
+  }, [port]);
+
+  if (!session) {
+    return (
+      <div className="h-screen flex items-center justify-center text-muted-foreground text-sm">
+        Open this window from the Live Monitor tab of the configurator.
+      </div>
+    );
+  }
+
+  return (
+    <div className="min-h-screen p-4 flex flex-col gap-4">
+      {!port && <div className="text-sm text-muted-foreground">Waiting for the configurator…</div>}
+      {PAD_NAMES.map((pad) => (
+        <PadGraph
+          key={pad}
+          pad={pad}
+          buffer={view.buffers[pad]}
+          lightThreshold={thresholds.pads[pad].light}
+          heavyThreshold={thresholds.pads[pad].heavy}
+          cutoffThreshold={thresholds.pads[pad].cutoff}
+          showHeavy={thresholds.showHeavy}
+          numPoints={view.capacity}
+          displayPoints={2000}
+        />
+      ))}
+    </div>
+  );
+}
@@ -2,7 +2,8 @@
 export const PICO_VENDOR_ID = 0x1209;
 export const BAUD_RATE = 115200;
 
-export type ConnectionStatus = "disconnected" | "connecting" | "connected" | "error";
+// "reconnecting": the device was lost and its port is being reopened
+export type ConnectionStatus = "disconnected" | "connecting" | "connected" | "reconnecting" | "error";
 
 export interface SerialState {
   port: SerialPort | null;
@@ -28,6 +29,15 @@ export const DeviceCommand = {
 
 export type DeviceCommand = (typeof DeviceCommand)[keyof typeof DeviceCommand];
 
+// Direct port access inside an exclusive serial section
+export interface SerialIO {
+  sendCommand: (command: DeviceCommand, data?: string) => Promise<void>;
+  sendBinary: (data: Uint8Array) => Promise<void>;
+  // Writer backpressure: bytes the port accepts before ready() blocks
+  desiredSize: () => number | null;
+  ready: () => Promise<void>;
+}
+
 // Pad Types
 export type PadName = "kaLeft" | "donLeft" | "donRight" | "kaRight";
 
@@ -66,6 +76,9 @@ export interface PadBuffer {
 
 export type PadBuffers = Record<PadName, PadBuffer>;
 
+// Which pads triggered since the last UI frame
+export type TriggerState = Record<PadName, boolean>;
+
 // Configuration Types
 export interface PadThresholds {
   light: number; // 0-4095
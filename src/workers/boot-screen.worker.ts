@@ -0,0 +1,76 @@
+import {
+  BOOT_SCREEN_WIDTH,
+  BOOT_SCREEN_HEIGHT,
+  toLuminance,
+  ditherLuminance,
+  encodeMonochromeBmp,
+  renderBits,
+  type DitherOptions,
+} from "@/lib/dither";
+
+// Boot screen conversion worker
+// The source image is decoded and scaled to 128x64 once per file; every
+// option change after that only re-dithers 8192 pixels.
+
+export type BootScreenWorkerRequest =
+  | { type: "load"; id: number; image: Blob }
+  | { type: "convert"; id: number; options: DitherOptions };
+
+export type BootScreenWorkerResponse =
+  | { type: "loaded"; id: number; width: number; height: number }
+  | { type: "converted"; id: number; preview: Uint8ClampedArray; bmp: Uint8Array }
+  | { type: "error"; id: number; message: string };
+
+let source: Uint8ClampedArray | null = null;
+const lum = new Float32Array(BOOT_SCREEN_WIDTH * BOOT_SCREEN_HEIGHT);
+const bits = new Uint8Array(BOOT_SCREEN_WIDTH * BOOT_SCREEN_HEIGHT);
+
+const reply = (message: BootScreenWorkerResponse, transfer: Transferable[] = []) =>
+  self.postMessage(message, { transfer });
+
+async function load(image: Blob): Promise<{ width: number; height: number }> {
+  const bitmap = await createImageBitmap(image);
+  try {
+    const canvas = new OffscreenCanvas(BOOT_SCREEN_WIDTH, BOOT_SCREEN_HEIGHT);
+    const ctx = canvas.getContext("2d", { willReadFrequently: true })!;
+
+    // White background for transparency, image scaled to fit and centred
+    ctx.fillStyle = "white";
+    ctx.fillRect(0, 0, BOOT_SCREEN_WIDTH, BOOT_SCREEN_HEIGHT);
+    const scale = Math.min(BOOT_SCREEN_WIDTH / bitmap.width, BOOT_SCREEN_HEIGHT / bitmap.height);
+    const w = bitmap.width * scale;
+    const h = bitmap.height * scale;
+    ctx.imageSmoothingQuality = "high";
+    ctx.drawImage(bitmap, (BOOT_SCREEN_WIDTH - w) / 2, (BOOT_SCREEN_HEIGHT - h) / 2, w, h);
+
+    source = ctx.getImageData(0, 0, BOOT_SCREEN_WIDTH, BOOT_SCREEN_HEIGHT).data;
+    return { width: bitmap.width, height: bitmap.height };
+  } finally {
+    bitmap.close();
+  }
+}
+
+function convert(options: DitherOptions): { preview: Uint8ClampedArray; bmp: Uint8Array } {
+  if (!source) throw new Error("No image loaded");
+  toLuminance(source, options, lum);
+  ditherLuminance(lum, BOOT_SCREEN_WIDTH, BOOT_SCREEN_HEIGHT, options, bits);
+  return {
+    preview: renderBits(bits),
+    bmp: encodeMonochromeBmp(bits, BOOT_SCREEN_WIDTH, BOOT_SCREEN_HEIGHT),
+  };
+}
+
+self.onmessage = async (event: MessageEvent<BootScreenWorkerRequest>) => {
+  const request = event.data;
+  try {
+    if (request.type === "load") {
+      const size = await load(request.image);
+      reply({ type: "loaded", id: request.id, ...size });
+    } else {
+      const { preview, bmp } = convert(request.options);
+      reply({ type: "converted", id: request.id, preview, bmp }, [preview.buffer as ArrayBuffer, bmp.buffer as ArrayBuffer]);
+    }
+  } catch (err) {
+    reply({ type: "error", id: request.id, message: err instanceof Error ? err.message : String(err) });
+  }
+};
@@ -0,0 +1,40 @@
+import { MONITOR_PORT, type MonitorRelayMessage } from "@/lib/monitor-channel";
+
+// Pop-out monitor relay (SharedWorker)
+// The pop-out window is opened with noopener and can't reach the configurator
+// directly. Both join a session here; each time the window joins, the two get
+// the ends of a fresh MessageChannel and talk directly from then on.
+
+interface MonitorSession {
+  feed: MessagePort | null;
+  window: MessagePort | null;  // Waiting for the feed
+}
+
+const sessions = new Map<string, MonitorSession>();
+
+function pair(session: MonitorSession): void {
+  if (!session.feed || !session.window) return;
+  const channel = new MessageChannel();
+  session.feed.postMessage({ type: MONITOR_PORT }, [channel.port1]);
+  session.window.postMessage({ type: MONITOR_PORT }, [channel.port2]);
+  // A reloaded window joins again
+  session.window = null;
+}
+
+self.addEventListener("connect", (event) => {
+  const client = (event as MessageEvent).ports[0];
+  client.onmessage = (e: MessageEvent<MonitorRelayMessage>) => {
+    const message = e.data;
+    if (message.type === "leave") {
+      if (sessions.get(message.session)?.feed === client) sessions.delete(message.session);
+      return;
+    }
+    let session = sessions.get(message.session);
+    if (!session) {
+      session = { feed: null, window: null };
+      sessions.set(message.session, session);
+    }
+    session[message.role] = client;
+    pair(session);
+  };
+});
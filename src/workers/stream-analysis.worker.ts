@@ -0,0 +1,39 @@
+import { analyzeCrosstalk, type CrosstalkInput, type CrosstalkResult } from "@/lib/crosstalk";
+import { analyzeRetriggers, type RetriggerInput, type RetriggerResult } from "@/lib/retrigger";
+
+// Stream analysis worker
+// Whole-session analyses over recorded or buffered raw frames, kept off the
+// main thread so the graphs keep running while a long session is scanned.
+
+export interface StreamAnalysisJobs {
+  crosstalk: { input: CrosstalkInput; result: CrosstalkResult };
+  retrigger: { input: RetriggerInput; result: RetriggerResult };
+}
+
+export type StreamAnalysisKind = keyof StreamAnalysisJobs;
+
+export type StreamAnalysisRequest = {
+  [K in StreamAnalysisKind]: { id: number; kind: K; input: StreamAnalysisJobs[K]["input"] };
+}[StreamAnalysisKind];
+
+export type StreamAnalysisResponse =
+  | { id: number; type: "result"; result: StreamAnalysisJobs[StreamAnalysisKind]["result"] }
+  | { id: number; type: "error"; message: string };
+
+const analyzers: { [K in StreamAnalysisKind]: (input: StreamAnalysisJobs[K]["input"]) => StreamAnalysisJobs[K]["result"] } = {
+  crosstalk: analyzeCrosstalk,
+  retrigger: analyzeRetriggers,
+};
+
+const reply = (message: StreamAnalysisResponse) => self.postMessage(message);
+
+self.onmessage = (event: MessageEvent<StreamAnalysisRequest>) => {
+  const request = event.data;
+  try {
+    // Kind and input always match, see StreamAnalysisRequest
+    const analyze = analyzers[request.kind] as (input: StreamAnalysisRequest["input"]) => StreamAnalysisJobs[StreamAnalysisKind]["result"];
+    reply({ id: request.id, type: "result", result: analyze(request.input) });
+  } catch (err) {
+    reply({ id: request.id, type: "error", message: err instanceof Error ? err.message : String(err) });
+  }
+};
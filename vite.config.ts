@@ -3,6 +3,7 @@ import react from '@vitejs/plugin-react'
 import path from "path"
 import tailwindcss from "@tailwindcss/vite"
 import { VitePWA } from 'vite-plugin-pwa'
+import { buildReport } from './scripts/build-report'
 
 // https://vite.dev/config/
 export default defineConfig({
@@ -48,6 +49,12 @@ export default defineConfig({
         ]
       },
       workbox: {
+        // Precache everything the configurator needs so it (and ?demo=true) runs offline
+        globPatterns: ['**/*.{js,css,html,ico,png,svg,woff,woff2,lottie}'],
+        // Firmware images are kept in OPFS instead (src/lib/firmware-store.ts)
+        importScripts: ['firmware-sw.js'],
+        maximumFileSizeToCacheInBytes: 5 * 1024 * 1024,
+        navigateFallback: 'index.html',
         cleanupOutdatedCaches: true,
         clientsClaim: true,
         skipWaiting: true,
@@ -55,7 +62,8 @@ export default defineConfig({
       pwaAssets: {
         config: true,
       }
-    })
+    }),
+    buildReport(),
   ],
   resolve: {
     alias: {